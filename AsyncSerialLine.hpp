@@ -0,0 +1,110 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+
+#include "SerialLine.hpp"
+
+#include "event/Loop.hpp"
+
+
+namespace lr {
+
+
+/// The interface for serial lines with asynchronous transfers, e.g. using DMA.
+///
+/// An asynchronous transfer is started with `sendAsync()` or `receiveAsync()` and returns immediately.
+/// The implementation transfers the data in the background and signals the completion to an event
+/// loop, using `event::Loop::signalInterrupt()` from the completion interrupt. React to the completion
+/// with an event added by `event::Loop::addInterruptEvent()`, using the same interrupt flags.
+///
+/// Rules for all implementations:
+/// - Only one send and one receive transfer can be active at the same time.
+/// - The memory passed to a transfer is used until the transfer is complete, it must stay valid.
+/// - The synchronous methods of `SerialLine` must still work, if no transfer is active.
+///
+class AsyncSerialLine : public SerialLine
+{
+public:
+    /// The signal for the completion of a transfer.
+    ///
+    struct Completion {
+        /// Signal the completion to the event loop.
+        ///
+        /// Call this method from the completion interrupt.
+        ///
+        inline void signal() const noexcept {
+            if (loop != nullptr) {
+                loop->signalInterrupt(interruptFlags);
+            }
+        }
+
+        event::Loop *loop; ///< The event loop to signal, or `nullptr` to not signal the completion.
+        event::InterruptFlags interruptFlags; ///< The interrupt flags to signal.
+    };
+
+public: // Output
+    /// Start sending a block of data in the background.
+    ///
+    /// @param[in] data A pointer to the data to be sent. It must stay valid until the transfer is complete.
+    /// @param[in] dataSize The size of the data block to send.
+    /// @param[in] completion The signal for the completion of the transfer.
+    /// @return `Success` if the transfer was started, `Error` if a send transfer is still active or there
+    ///     was a problem with the device.
+    ///
+    virtual Status sendAsync(const uint8_t *data, DataSize dataSize, const Completion &completion) noexcept = 0;
+
+    /// Check if a send transfer is active.
+    ///
+    /// @return `true` if the data of the last `sendAsync()` call was not sent completely yet.
+    ///
+    virtual bool isSendAsyncActive() noexcept = 0;
+
+public: // Input
+    /// Start receiving data into a buffer in the background.
+    ///
+    /// The transfer completes if the buffer is full, or the implementation detects the end of a block of data,
+    /// e.g. if the line is idle for a certain time.
+    ///
+    /// @param[out] data A pointer to the buffer for the received data. It must stay valid until the transfer
+    ///     is complete.
+    /// @param[in] dataSize The size of the buffer.
+    /// @param[in] completion The signal for the completion of the transfer.
+    /// @return `Success` if the transfer was started, `Error` if a receive transfer is still active or there
+    ///     was a problem with the device.
+    ///
+    virtual Status receiveAsync(uint8_t *data, DataSize dataSize, const Completion &completion) noexcept = 0;
+
+    /// Check if a receive transfer is active.
+    ///
+    /// @return `true` if the transfer of the last `receiveAsync()` call is not complete yet.
+    ///
+    virtual bool isReceiveAsyncActive() noexcept = 0;
+
+    /// Get the number of bytes received by the last completed receive transfer.
+    ///
+    /// @return The number of bytes written into the buffer passed to `receiveAsync()`.
+    ///
+    virtual DataSize getReceivedAsyncSize() noexcept = 0;
+};
+
+
+}
+
+
@@ -0,0 +1,259 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+
+#include "InterruptLock.hpp"
+#include "WireMaster.hpp"
+
+#include "event/Loop.hpp"
+
+#include <cstdint>
+
+
+namespace lr {
+
+
+/// The interface for wire masters with asynchronous, queued transactions.
+///
+/// A transaction is submitted with `submitAsync()` and the call returns immediately. The implementation
+/// executes the queued transactions one after the other in the background, driven by the interrupt of
+/// the peripheral or by DMA. The completion of each transaction is signalled to an event loop, using
+/// `event::Loop::signalInterrupt()`, and/or reported to a callback from the completion interrupt.
+///
+/// Each transaction addresses one chip. It optionally writes a register address and a block of data,
+/// followed by a repeated start and a read into a buffer:
+///
+/// ```
+/// [S][address+W][registerAddress][write data...][Sr][address+R][read data...][P]
+/// ```
+///
+/// Rules for all implementations:
+/// - The transaction object and all buffers it points to must stay valid until the transaction is complete.
+/// - A transaction can not be submitted again until it is complete.
+/// - The synchronous methods of `WireMaster` must still work, if no transaction is queued.
+///
+/// Implementations can use `AsyncWireMasterQueue` to manage the queued transactions.
+///
+class AsyncWireMaster : public WireMaster
+{
+public:
+    struct Transaction;
+
+    /// The function called from the interrupt if a transaction is complete.
+    ///
+    typedef void (*CompletionFn)(Transaction &transaction);
+
+    /// The signal for the completion of a transaction.
+    ///
+    struct Completion {
+        /// Signal the completion of a transaction.
+        ///
+        /// Call this method from the completion interrupt.
+        ///
+        /// @param transaction The completed transaction.
+        ///
+        inline void signal(Transaction &transaction) const noexcept {
+            if (loop != nullptr) {
+                loop->signalInterrupt(interruptFlags);
+            }
+            if (callback != nullptr) {
+                callback(transaction);
+            }
+        }
+
+        event::Loop *loop; ///< The event loop to signal, or `nullptr` to not signal the loop.
+        event::InterruptFlags interruptFlags; ///< The interrupt flags to signal.
+        CompletionFn callback; ///< The function to call from the interrupt, or `nullptr`.
+    };
+
+    /// The state of a transaction.
+    ///
+    enum class State : uint8_t {
+        Idle, ///< The transaction was never submitted.
+        Queued, ///< The transaction is waiting in the queue.
+        Active, ///< The transaction is executed on the bus.
+        Complete, ///< The transaction is complete and its status is set.
+    };
+
+    /// A single transaction on the bus.
+    ///
+    struct Transaction {
+        /// Check if the transaction is complete.
+        ///
+        inline bool isComplete() const noexcept {
+            return state == State::Complete;
+        }
+
+        /// Check if the transaction is queued or active.
+        ///
+        inline bool isPending() const noexcept {
+            return state == State::Queued || state == State::Active;
+        }
+
+        /// Get the little endian value read into the inline buffer.
+        ///
+        /// @tparam Value The type of the value, `uint8_t`, `uint16_t` or `uint32_t`.
+        /// @return The value.
+        ///
+        template<typename Value>
+        inline Value getValue() const noexcept {
+            Value value = 0;
+            for (uint8_t i = 0; i < sizeof(Value); ++i) {
+                value |= static_cast<Value>(static_cast<Value>(buffer[i]) << (i * 8));
+            }
+            return value;
+        }
+
+        uint8_t address; ///< The address of the chip.
+        bool hasRegisterAddress; ///< If the register address is written first.
+        uint8_t registerAddress; ///< The register address to write first.
+        const uint8_t *writeData; ///< The data to write, or `nullptr` to write nothing.
+        uint8_t writeCount; ///< The number of bytes to write.
+        uint8_t *readData; ///< The buffer for the read data, or `nullptr` to read nothing.
+        uint8_t readCount; ///< The number of bytes to read.
+        uint8_t buffer[4]; ///< An inline buffer for register values.
+        Completion completion; ///< The signal for the completion.
+        volatile State state; ///< The state of the transaction, changed by the interrupt.
+        volatile Status status; ///< The status of the transaction, valid if the transaction is complete.
+    };
+
+public:
+    /// Submit a transaction to the queue.
+    ///
+    /// @param[in] transaction The transaction to execute. It must stay valid until the transaction is complete.
+    /// @return `Success` if the transaction was queued, `Error` if the queue is full or the transaction
+    ///     is still pending.
+    ///
+    virtual Status submitAsync(Transaction &transaction) noexcept = 0;
+
+    /// Check if transactions are queued or active.
+    ///
+    /// @return `true` if not all submitted transactions are complete.
+    ///
+    virtual bool isAsyncActive() noexcept = 0;
+};
+
+
+/// A statically allocated queue of transactions, for implementations of `AsyncWireMaster`.
+///
+/// The queue only stores pointers to the submitted transactions. The front transaction is the one
+/// which is active on the bus. The implementation calls `submit()` from `submitAsync()` and starts the
+/// transaction if the call returns `true`. From the completion interrupt, it calls `complete()` and
+/// starts the returned next transaction.
+///
+/// @tparam queueSize The maximum number of pending transactions, in the range 1-128.
+///
+template<uint8_t queueSize = 8>
+class AsyncWireMasterQueue
+{
+    static_assert(queueSize >= 1 && queueSize <= 128, "The queue size has to be in the range 1-128.");
+
+public:
+    using Status = WireMaster::Status;
+    using State = AsyncWireMaster::State;
+    using Transaction = AsyncWireMaster::Transaction;
+
+public:
+    /// Create a new empty queue.
+    ///
+    constexpr AsyncWireMasterQueue() : _transactions(), _readIndex(0), _count(0) {}
+
+public:
+    /// Add a transaction to the queue.
+    ///
+    /// @param[in] transaction The transaction to add.
+    /// @param[out] isFirst Set to `true` if the queue was empty, and the transaction has to be started.
+    /// @return `Success` if the transaction was queued, `Error` if the queue is full or the transaction
+    ///     is still pending.
+    ///
+    Status submit(Transaction &transaction, bool &isFirst) noexcept {
+        InterruptLock lock;
+        isFirst = false;
+        if (_count == queueSize || transaction.isPending()) {
+            return Status::Error;
+        }
+        isFirst = (_count == 0);
+        transaction.state = (isFirst ? State::Active : State::Queued);
+        _transactions[wrap(_readIndex + _count)] = &transaction;
+        _count += 1;
+        return Status::Success;
+    }
+
+    /// Get the active transaction.
+    ///
+    /// @return The transaction at the front of the queue, or `nullptr` if the queue is empty.
+    ///
+    Transaction* getActive() const noexcept {
+        return (_count > 0) ? _transactions[_readIndex] : nullptr;
+    }
+
+    /// Complete the active transaction.
+    ///
+    /// Call this method from the completion interrupt. The active transaction is removed from the
+    /// queue and its completion is signalled.
+    ///
+    /// @param[in] status The status of the completed transaction.
+    /// @return The next transaction to start, or `nullptr` if the queue is empty.
+    ///
+    Transaction* complete(Status status) noexcept {
+        Transaction *next;
+        Transaction *completed;
+        {
+            InterruptLock lock;
+            if (_count == 0) {
+                return nullptr;
+            }
+            completed = _transactions[_readIndex];
+            _readIndex = wrap(_readIndex + 1);
+            _count -= 1;
+            next = getActive();
+            if (next != nullptr) {
+                next->state = State::Active;
+            }
+            completed->status = status;
+            completed->state = State::Complete;
+        }
+        completed->completion.signal(*completed);
+        return next;
+    }
+
+    /// Check if the queue is empty.
+    ///
+    bool isEmpty() const noexcept {
+        return _count == 0;
+    }
+
+private:
+    /// Wrap an index into the queue.
+    ///
+    constexpr static uint8_t wrap(uint16_t index) noexcept {
+        return static_cast<uint8_t>(index % queueSize);
+    }
+
+private:
+    Transaction *_transactions[queueSize]; ///< The pending transactions, the front one is active.
+    volatile uint8_t _readIndex; ///< The index of the active transaction.
+    volatile uint8_t _count; ///< The number of pending transactions.
+};
+
+
+}
+
+
@@ -0,0 +1,191 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+
+#include "AsyncWireMaster.hpp"
+#include "WireMasterChip.hpp"
+
+
+namespace lr {
+
+
+/// A class to simplify the access to a single chip on an asynchronous bus.
+///
+/// Besides all blocking methods of `WireMasterChip`, this class provides asynchronous counterparts
+/// of the register helpers. Each method prepares the given transaction and submits it to the bus,
+/// the result is available in the transaction as soon it is complete.
+///
+/// ```
+/// AsyncWireMaster::Transaction gTransaction;
+/// // ...
+/// chip.readRegisterAsync(Register::Temperature, 2, gTransaction, {&loop, event::InterruptA, nullptr});
+/// // ... in the event for `event::InterruptA`:
+/// if (gTransaction.status == WireMaster::Status::Success) {
+///     const auto value = gTransaction.getValue<uint16_t>();
+/// }
+/// ```
+///
+class AsyncWireMasterChip : public WireMasterChip
+{
+public:
+    using Transaction = AsyncWireMaster::Transaction;
+    using Completion = AsyncWireMaster::Completion;
+
+public:
+    /// Create a new instance of the chip acess.
+    ///
+    /// @param[in] bus The pointer to the bus to use.
+    /// @param[in] address The address of the chip.
+    ///
+    AsyncWireMasterChip(AsyncWireMaster *bus, uint8_t address)
+        : WireMasterChip(bus, address), _asyncBus(bus)
+    {
+    }
+
+public:
+    /// Write data to a register in the background.
+    ///
+    /// @param[in] reg The register to write into.
+    /// @param[in] data A pointer to the data. It must stay valid until the transaction is complete.
+    /// @param[in] count The number of bytes to write.
+    /// @param[in] transaction The transaction to use.
+    /// @param[in] completion The signal for the completion of the transaction.
+    /// @return The status of the submission. See `AsyncWireMaster::submitAsync()` for details.
+    ///
+    inline Status writeRegisterDataAsync(const uint8_t reg, const uint8_t *data, const uint8_t count,
+        Transaction &transaction, const Completion &completion) const
+    {
+        if (transaction.isPending()) {
+            return Status::Error;
+        }
+        prepare(transaction, reg, completion);
+        transaction.writeData = data;
+        transaction.writeCount = count;
+        return _asyncBus->submitAsync(transaction);
+    }
+
+    /// Read data from a register in the background.
+    ///
+    /// @param[in] reg The register to read.
+    /// @param[out] data A pointer to the buffer. It must stay valid until the transaction is complete.
+    /// @param[in] count The number of bytes to read.
+    /// @param[in] transaction The transaction to use.
+    /// @param[in] completion The signal for the completion of the transaction.
+    /// @return The status of the submission. See `AsyncWireMaster::submitAsync()` for details.
+    ///
+    inline Status readRegisterDataAsync(const uint8_t reg, uint8_t *data, const uint8_t count,
+        Transaction &transaction, const Completion &completion) const
+    {
+        if (transaction.isPending()) {
+            return Status::Error;
+        }
+        prepare(transaction, reg, completion);
+        transaction.readData = data;
+        transaction.readCount = count;
+        return _asyncBus->submitAsync(transaction);
+    }
+
+    /// Read a single 8, 16 or 32bit register in the background.
+    ///
+    /// The value is read into the inline buffer of the transaction, as little endian value. Use
+    /// `Transaction::getValue()` to get the value after the transaction is complete.
+    ///
+    /// @param[in] reg The register to read.
+    /// @param[in] size The size of the register in bytes, 1, 2 or 4.
+    /// @param[in] transaction The transaction to use.
+    /// @param[in] completion The signal for the completion of the transaction.
+    /// @return The status of the submission. See `AsyncWireMaster::submitAsync()` for details.
+    ///
+    inline Status readRegisterAsync(const uint8_t reg, const uint8_t size, Transaction &transaction,
+        const Completion &completion) const
+    {
+        if (size == 0 || size > sizeof(transaction.buffer)) {
+            return Status::Error;
+        }
+        return readRegisterDataAsync(reg, transaction.buffer, size, transaction, completion);
+    }
+
+    /// Write a single 8bit register in the background.
+    ///
+    /// The value is copied into the inline buffer of the transaction.
+    ///
+    /// @param[in] reg The register to write into.
+    /// @param[in] value The value to write.
+    /// @param[in] transaction The transaction to use.
+    /// @param[in] completion The signal for the completion of the transaction.
+    /// @return The status of the submission. See `AsyncWireMaster::submitAsync()` for details.
+    ///
+    inline Status writeRegisterAsync(const uint8_t reg, const uint8_t value, Transaction &transaction,
+        const Completion &completion) const
+    {
+        return writeValueAsync<uint8_t>(reg, value, transaction, completion);
+    }
+
+    /// @copydoc AsyncWireMasterChip::writeRegisterAsync(const uint8_t, const uint8_t, Transaction&, const Completion&)
+    inline Status writeRegisterAsync(const uint8_t reg, const uint16_t value, Transaction &transaction,
+        const Completion &completion) const
+    {
+        return writeValueAsync<uint16_t>(reg, value, transaction, completion);
+    }
+
+    /// @copydoc AsyncWireMasterChip::writeRegisterAsync(const uint8_t, const uint8_t, Transaction&, const Completion&)
+    inline Status writeRegisterAsync(const uint8_t reg, const uint32_t value, Transaction &transaction,
+        const Completion &completion) const
+    {
+        return writeValueAsync<uint32_t>(reg, value, transaction, completion);
+    }
+
+private:
+    /// Prepare a transaction for a register access.
+    ///
+    inline void prepare(Transaction &transaction, const uint8_t reg, const Completion &completion) const {
+        transaction.address = getAddress();
+        transaction.hasRegisterAddress = true;
+        transaction.registerAddress = reg;
+        transaction.writeData = nullptr;
+        transaction.writeCount = 0;
+        transaction.readData = nullptr;
+        transaction.readCount = 0;
+        transaction.completion = completion;
+    }
+
+    /// Write a little endian value from the inline buffer.
+    ///
+    template<typename Value>
+    inline Status writeValueAsync(const uint8_t reg, const Value value, Transaction &transaction,
+        const Completion &completion) const
+    {
+        if (transaction.isPending()) {
+            return Status::Error;
+        }
+        for (uint8_t i = 0; i < sizeof(Value); ++i) {
+            transaction.buffer[i] = static_cast<uint8_t>(value >> (i * 8));
+        }
+        return writeRegisterDataAsync(reg, transaction.buffer, sizeof(Value), transaction, completion);
+    }
+
+private:
+    AsyncWireMaster* const _asyncBus; ///< The asynchronous bus to use.
+};
+
+
+}
+
+
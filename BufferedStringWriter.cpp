@@ -0,0 +1,138 @@
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#include "BufferedStringWriter.hpp"
+
+
+#include "IntegerMath.hpp"
+
+#include <cstring>
+
+
+namespace lr {
+
+
+BufferedStringWriter::BufferedStringWriter(
+    StringWriter *writer,
+    char *buffer,
+    uint16_t bufferSize,
+    bool flushOnLineEnd)
+:
+    _writer(writer),
+    _buffer(buffer),
+    _bufferSize(bufferSize),
+    _length(0),
+    _flushOnLineEnd(flushOnLineEnd)
+{
+}
+
+
+BufferedStringWriter::~BufferedStringWriter()
+{
+    flush();
+}
+
+
+StringWriter::Status BufferedStringWriter::flush()
+{
+    if (_length == 0) {
+        return Status::Success;
+    }
+    const auto result = _writer->write(_buffer, _length);
+    _length = 0;
+    return result;
+}
+
+
+StringWriter::Status BufferedStringWriter::write(const String &text)
+{
+    return write(text.getData(), text.getLength());
+}
+
+
+StringWriter::Status BufferedStringWriter::write(char c, uint8_t count)
+{
+    if (_bufferSize == 0) {
+        return _writer->write(c, count);
+    }
+    while (count > 0) {
+        if (_length == _bufferSize && hasError(flush())) {
+            return Status::Error;
+        }
+        const auto size = static_cast<uint8_t>(IntegerMath::min<uint16_t>(count, _bufferSize - _length));
+        std::memset(_buffer + _length, c, size);
+        _length += size;
+        count -= size;
+    }
+    return Status::Success;
+}
+
+
+StringWriter::Status BufferedStringWriter::write(const char *text)
+{
+    return write(text, static_cast<uint16_t>(std::strlen(text)));
+}
+
+
+StringWriter::Status BufferedStringWriter::write(const char *text, uint16_t length)
+{
+    if (length > _bufferSize - _length) {
+        if (hasError(flush())) {
+            return Status::Error;
+        }
+        if (length > _bufferSize) {
+            return _writer->write(text, length);
+        }
+    }
+    std::memcpy(_buffer + _length, text, length);
+    _length += length;
+    return Status::Success;
+}
+
+
+StringWriter::Status BufferedStringWriter::writeLine(const String &text)
+{
+    if (hasError(write(text))) {
+        return Status::Error;
+    }
+    return writeLine();
+}
+
+
+StringWriter::Status BufferedStringWriter::writeLine(const char *text)
+{
+    if (hasError(write(text))) {
+        return Status::Error;
+    }
+    return writeLine();
+}
+
+
+StringWriter::Status BufferedStringWriter::writeLine()
+{
+    if (hasError(write("\r\n", 2))) {
+        return Status::Error;
+    }
+    if (_flushOnLineEnd) {
+        return flush();
+    }
+    return Status::Success;
+}
+
+
+}
+
@@ -0,0 +1,105 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+
+#include "StringWriter.hpp"
+
+
+namespace lr {
+
+
+/// A string writer which collects the written text in a buffer.
+///
+/// This writer is a decorator for any other string writer, e.g. `SerialLineStringWriter` or
+/// `SerialLineShell`. All written text is collected in a buffer, which is supplied by the caller.
+/// The collected text is written to the underlying writer with one call, if the buffer is full,
+/// at the end of a line if `flushOnLineEnd` is enabled, or if `flush()` is called.
+///
+/// Text which does not fit into an empty buffer is written directly to the underlying writer.
+/// The line end is collected as CR/LF, like the one written by `SerialLineStringWriter`.
+///
+/// Example:
+/// ```
+/// char buffer[128];
+/// BufferedStringWriter writer(&gSerialWriter, buffer, sizeof(buffer));
+/// for (auto &row : rows) {
+///     writeRow(writer, row);
+/// }
+/// writer.flush();
+/// ```
+///
+class BufferedStringWriter : public StringWriter
+{
+public:
+    /// Create a new buffered string writer.
+    ///
+    /// @param writer The underlying writer. Must not be `nullptr`.
+    /// @param buffer The buffer to collect the text. It has to stay valid for the lifetime of this writer.
+    /// @param bufferSize The size of the buffer in bytes.
+    /// @param flushOnLineEnd If the buffer is written at the end of each line.
+    ///
+    BufferedStringWriter(StringWriter *writer, char *buffer, uint16_t bufferSize, bool flushOnLineEnd = false);
+
+    /// dtor
+    ///
+    /// Writes any remaining text in the buffer.
+    ///
+    ~BufferedStringWriter();
+
+public:
+    /// Write all collected text to the underlying writer.
+    ///
+    /// @return `Success` or `Error` if the underlying writer failed.
+    ///
+    Status flush();
+
+    /// Change if the buffer is written at the end of each line.
+    ///
+    inline void setFlushOnLineEnd(bool flushOnLineEnd) {
+        _flushOnLineEnd = flushOnLineEnd;
+    }
+
+    /// Get the number of collected characters in the buffer.
+    ///
+    inline uint16_t getBufferedLength() const {
+        return _length;
+    }
+
+public: // Implement StringWriter
+    Status write(const String &text) override;
+    Status write(char c, uint8_t count) override;
+    Status write(const char *text) override;
+    Status write(const char *text, uint16_t length) override;
+    Status writeLine(const String &text) override;
+    Status writeLine(const char *text) override;
+    Status writeLine() override;
+
+private:
+    StringWriter *_writer; ///< The underlying writer.
+    char *_buffer; ///< The buffer for the collected text.
+    const uint16_t _bufferSize; ///< The size of the buffer.
+    uint16_t _length; ///< The number of collected characters.
+    bool _flushOnLineEnd; ///< If the buffer is written at the end of each line.
+};
+
+
+}
+
+
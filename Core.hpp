@@ -0,0 +1,114 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+#include "InterruptLock.hpp"
+
+#include <cstdint>
+
+
+/// @namespace lr::Core
+/// An abstract interface to the cores of the platform.
+///
+/// The number of cores is set at build time with the `LR_CORE_COUNT` definition. For
+/// single core platforms, which is the default, all functions are inline and nothing has
+/// to be implemented by the platform. If `LR_CORE_COUNT` is larger than one, the platform
+/// has to implement `currentIndex()`, `signalOtherCores()` and the `CoreLock` class.
+
+
+#ifndef LR_CORE_COUNT
+#define LR_CORE_COUNT 1
+#endif
+
+
+namespace lr {
+namespace Core {
+
+
+/// The number of cores used by the application.
+///
+constexpr uint8_t cCount = LR_CORE_COUNT;
+
+static_assert(cCount >= 1 && cCount <= 8, "The number of cores has to be in the range 1-8.");
+
+
+#if LR_CORE_COUNT > 1
+
+/// Get the index of the core which executes the call.
+///
+/// @return The index of the current core, from 0 to `cCount - 1`.
+///
+uint8_t currentIndex();
+
+/// Wake up all other cores, if they are sleeping.
+///
+/// This is used after work was added for another core. On ARM platforms, this
+/// is usually the `SEV` instruction, which wakes cores waiting with `WFE`.
+///
+void signalOtherCores();
+
+#else
+
+/// Get the index of the core which executes the call.
+///
+/// @return Always zero for single core platforms.
+///
+inline uint8_t currentIndex() { return 0; }
+
+/// Wake up all other cores. Nothing to do for single core platforms.
+///
+inline void signalOtherCores() {}
+
+#endif
+
+
+}
+
+
+#if LR_CORE_COUNT > 1
+
+/// A lock for a single scope, which protects data shared between all cores.
+///
+/// The lock disables the interrupts on the current core, and acquires a spin lock
+/// shared by all cores, e.g. a hardware spin lock. Keep the locked scope very short.
+///
+class CoreLock
+{
+public:
+    /// ctor
+    ///
+    CoreLock();
+
+    /// dtor
+    ///
+    ~CoreLock();
+};
+
+#else
+
+/// On single core platforms, the core lock is the interrupt lock.
+///
+using CoreLock = InterruptLock;
+
+#endif
+
+
+}
+
+
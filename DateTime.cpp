@@ -40,9 +40,6 @@ const uint16_t cSecondsPerHour = 3600;
 // The number of seconds per minute.
 const uint16_t cSecondsPerMinute = 60;
     
-// The number of days for a regular year.
-const uint32_t cDaysPerNormalYear = 365;
-    
 
 // Calculate the day of the week.
 // Using the formula from: http://www.tondering.dk/claus/cal/chrweek.php
@@ -71,13 +68,51 @@ inline uint8_t getMaxDayPerMonth(uint16_t year, uint8_t month)
 }
 
     
-inline uint32_t getDaysForYear(uint16_t year)
+// The number of days in a 400 year cycle.
+const uint32_t cDaysPerEra = 146097;
+
+// The number of days from 0000-03-01 to 2000-01-01.
+const uint32_t cDaysTo2000 = 730425;
+
+// The number of days from 2000-01-01 to 9999-12-31, the last supported day.
+const uint32_t cLastDayNumber = 2921939;
+
+
+// Get the number of days since 2000-01-01 for a date.
+// Using the days-from-civil algorithm from: http://howardhinnant.github.io/date_algorithms.html
+// The year starts in March, so the leap day is the last day of the year.
+inline uint32_t getDayNumber(uint16_t year, uint8_t month, uint8_t day)
 {
-    if (isLeapYear(year)) {
-        return cDaysPerNormalYear + 1;
-    } else {
-        return cDaysPerNormalYear;
-    }
+    const uint32_t shiftedYear = year - ((month <= 2) ? 1u : 0u);
+    const uint32_t era = shiftedYear / 400;
+    const uint32_t yearOfEra = shiftedYear - era * 400;
+    const uint32_t shiftedMonth = (month > 2) ? (month - 3u) : (month + 9u);
+    const uint32_t dayOfYear = (153 * shiftedMonth + 2) / 5 + day - 1;
+    const uint32_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * cDaysPerEra + dayOfEra - cDaysTo2000;
+}
+
+
+// Create a date/time from the number of days since 2000-01-01 and the seconds since midnight.
+// Using the civil-from-days algorithm from: http://howardhinnant.github.io/date_algorithms.html
+template<typename DayType>
+DateTime getDateFromDayNumber(DayType dayNumber, uint32_t secondsSinceMidnight)
+{
+    const auto hours = static_cast<uint8_t>(secondsSinceMidnight / cSecondsPerHour);
+    secondsSinceMidnight %= cSecondsPerHour;
+    const auto minutes = static_cast<uint8_t>(secondsSinceMidnight / cSecondsPerMinute);
+    const auto seconds = static_cast<uint8_t>(secondsSinceMidnight % cSecondsPerMinute);
+    const auto dayOfWeek = static_cast<uint8_t>((dayNumber + 6) % 7); // 2000-01-01 was Saturday (6)
+    const DayType days = dayNumber + cDaysTo2000;
+    const DayType era = days / cDaysPerEra;
+    const auto dayOfEra = static_cast<uint32_t>(days - era * cDaysPerEra);
+    const uint32_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const uint32_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const uint32_t shiftedMonth = (5 * dayOfYear + 2) / 153;
+    const auto day = static_cast<uint8_t>(dayOfYear - (153 * shiftedMonth + 2) / 5 + 1);
+    const auto month = static_cast<uint8_t>((shiftedMonth < 10) ? (shiftedMonth + 3) : (shiftedMonth - 9));
+    const auto year = static_cast<uint16_t>(era * 400 + yearOfEra + ((month <= 2) ? 1 : 0));
+    return DateTime::fromUncheckedValues(year, month, day, hours, minutes, seconds, dayOfWeek);
 }
 
     
@@ -252,6 +287,36 @@ void DateTime::addOneSecond()
 }
 
 
+void DateTime::addSeconds(int32_t seconds)
+{
+    const auto dayNumber = static_cast<int64_t>(getDayNumber(_year, _month, _day));
+    const auto secondsSinceMidnight = static_cast<int64_t>(_hour) * cSecondsPerHour
+        + static_cast<int64_t>(_minute) * cSecondsPerMinute + static_cast<int64_t>(_second);
+    auto totalSeconds = dayNumber * cSecondsPerDay + secondsSinceMidnight + seconds;
+    if (totalSeconds < 0) {
+        totalSeconds = 0;
+    } else if (totalSeconds >= (static_cast<int64_t>(cLastDayNumber) + 1) * cSecondsPerDay) {
+        totalSeconds = (static_cast<int64_t>(cLastDayNumber) + 1) * cSecondsPerDay - 1;
+    }
+    *this = getDateFromDayNumber(static_cast<uint32_t>(totalSeconds / cSecondsPerDay),
+        static_cast<uint32_t>(totalSeconds % cSecondsPerDay));
+}
+
+
+void DateTime::addDays(int32_t days)
+{
+    auto dayNumber = static_cast<int64_t>(getDayNumber(_year, _month, _day)) + days;
+    if (dayNumber < 0) {
+        dayNumber = 0;
+    } else if (dayNumber > cLastDayNumber) {
+        dayNumber = cLastDayNumber;
+    }
+    const auto secondsSinceMidnight = static_cast<uint32_t>(_hour) * cSecondsPerHour
+        + static_cast<uint32_t>(_minute) * cSecondsPerMinute + static_cast<uint32_t>(_second);
+    *this = getDateFromDayNumber(static_cast<uint32_t>(dayNumber), secondsSinceMidnight);
+}
+
+
 uint16_t DateTime::getYear() const
 {
     return _year;
@@ -300,69 +365,82 @@ bool DateTime::isFirst() const
 }
     
     
-String DateTime::toString(Format format) const
+template<typename Target>
+void DateTime::appendTo(Target &target, Format format) const
 {
-    String result;
-    result.reserve(20); // longest format.
     switch (format) {
         case Format::ISO:
         case Format::Long:
-            result.appendNumber(_year, 4, '0');
-            result.append('-');
-            result.appendNumber(_month, 2, '0');
-            result.append('-');
-            result.appendNumber(_day, 2, '0');
+            target.appendNumber(_year, 4, '0');
+            target.append('-');
+            target.appendNumber(_month, 2, '0');
+            target.append('-');
+            target.appendNumber(_day, 2, '0');
             if (format == Format::ISO) {
-                result.append('T');
+                target.append('T');
             } else {
-                result.append(' ');
+                target.append(' ');
             }
-            result.appendNumber(_hour, 2, '0');
-            result.append(':');
-            result.appendNumber(_minute, 2, '0');
-            result.append(':');
-            result.appendNumber(_second, 2, '0');
+            target.appendNumber(_hour, 2, '0');
+            target.append(':');
+            target.appendNumber(_minute, 2, '0');
+            target.append(':');
+            target.appendNumber(_second, 2, '0');
             break;
         case Format::ISODate:
-            result.appendNumber(_year, 4, '0');
-            result.append('-');
-            result.appendNumber(_month, 2, '0');
-            result.append('-');
-            result.appendNumber(_day, 2, '0');
+            target.appendNumber(_year, 4, '0');
+            target.append('-');
+            target.appendNumber(_month, 2, '0');
+            target.append('-');
+            target.appendNumber(_day, 2, '0');
             break;
         case Format::ISOBasicDate:
-            result.appendNumber(_year, 4, '0');
-            result.appendNumber(_month, 2, '0');
-            result.appendNumber(_day, 2, '0');
+            target.appendNumber(_year, 4, '0');
+            target.appendNumber(_month, 2, '0');
+            target.appendNumber(_day, 2, '0');
             break;
         case Format::ISOTime:
-            result.appendNumber(_hour, 2, '0');
-            result.append(':');
-            result.appendNumber(_minute, 2, '0');
-            result.append(':');
-            result.appendNumber(_second, 2, '0');
+            target.appendNumber(_hour, 2, '0');
+            target.append(':');
+            target.appendNumber(_minute, 2, '0');
+            target.append(':');
+            target.appendNumber(_second, 2, '0');
             break;
         case Format::ISOBasicTime:
-            result.appendNumber(_hour, 2, '0');
-            result.appendNumber(_minute, 2, '0');
-            result.appendNumber(_second, 2, '0');
+            target.appendNumber(_hour, 2, '0');
+            target.appendNumber(_minute, 2, '0');
+            target.appendNumber(_second, 2, '0');
             break;
         case Format::ShortDate:
-            result.appendNumber(_day, 2, '0');
-            result.append('.');
-            result.appendNumber(_month, 2, '0');
-            result.append('.');
+            target.appendNumber(_day, 2, '0');
+            target.append('.');
+            target.appendNumber(_month, 2, '0');
+            target.append('.');
             break;
         case Format::ShortTime:
-            result.appendNumber(_hour, 2, '0');
-            result.append(':');
-            result.appendNumber(_minute, 2, '0');
+            target.appendNumber(_hour, 2, '0');
+            target.append(':');
+            target.appendNumber(_minute, 2, '0');
             break;
     }
+}
+
+
+String DateTime::toString(Format format) const
+{
+    String result;
+    result.reserve(20); // longest format.
+    appendTo(result, format);
     return result;
 }
 
 
+void DateTime::toString(Format format, StringBuilder &builder) const
+{
+    appendTo(builder, format);
+}
+
+
 DateTime DateTime::fromUncheckedValues(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second, uint8_t dayOfWeek)
 {
     return DateTime(year, month, day, hour, minute, second, dayOfWeek);
@@ -372,18 +450,8 @@ DateTime DateTime::fromUncheckedValues(uint16_t year, uint8_t month, uint8_t day
 template<typename SecondType>
 SecondType getSecondsSince2000(const DateTime &dateTime)
 {
-    // This calculation will require some CPU cycles. It is an programmatic solution, no mathematical one.
-    // It is optimized to use minimum amount of memory.
-    SecondType seconds = 0;
-    const auto dateTimeYear = dateTime.getYear();
-    for (uint16_t year = 2000; year < dateTimeYear; ++year) {
-        seconds += (getDaysForYear(year) * static_cast<SecondType>(cSecondsPerDay));
-    }
-    const auto dateTimeMonth = dateTime.getMonth();
-    for (uint8_t month = 1; month < dateTimeMonth; ++month) {
-        seconds += (static_cast<SecondType>(getMaxDayPerMonth(dateTimeYear, month)) * static_cast<SecondType>(cSecondsPerDay));
-    }
-    seconds += static_cast<SecondType>(dateTime.getDay()-1) * static_cast<SecondType>(cSecondsPerDay);
+    auto seconds = static_cast<SecondType>(getDayNumber(dateTime.getYear(), dateTime.getMonth(), dateTime.getDay()));
+    seconds *= static_cast<SecondType>(cSecondsPerDay);
     seconds += static_cast<SecondType>(dateTime.getHour()) * static_cast<SecondType>(cSecondsPerHour);
     seconds += static_cast<SecondType>(dateTime.getMinute()) * static_cast<SecondType>(cSecondsPerMinute);
     seconds += static_cast<SecondType>(dateTime.getSecond());
@@ -394,33 +462,9 @@ SecondType getSecondsSince2000(const DateTime &dateTime)
 template<typename SecondType>
 DateTime getDateFromSecondsSince2000(SecondType secondsSince2000)
 {
-    // This calculation will require some CPU cycles. It is a programmatic solution, no mathematical one.
-    // This function is approximate 6 times slower than mathematical implementations.
-
-    // Calculate the time
-    SecondType secondsSinceMidnight = secondsSince2000 % static_cast<SecondType>(cSecondsPerDay);
-    const auto hours = static_cast<uint8_t>(secondsSinceMidnight / static_cast<SecondType>(cSecondsPerHour));
-    secondsSinceMidnight %= static_cast<SecondType>(cSecondsPerHour);
-    const auto minutes = static_cast<uint8_t>(secondsSinceMidnight/static_cast<SecondType>(cSecondsPerMinute));
-    const auto seconds = static_cast<uint8_t>(secondsSinceMidnight % static_cast<SecondType>(cSecondsPerMinute));
-    // Calculate the date
-    SecondType days = secondsSince2000 / static_cast<SecondType>(cSecondsPerDay);
-    const uint8_t dayOfWeek = (days+6)%7; // 2000-01-01 was Saturday (6)
-    uint16_t year = 2000;
-    SecondType daysForThisSection = getDaysForYear(year);
-    while (days >= daysForThisSection) {
-        ++year;
-        days -= daysForThisSection;
-        daysForThisSection = getDaysForYear(year);
-    }
-    uint16_t month = 1;
-    daysForThisSection = getMaxDayPerMonth(year, month);
-    while (days >= daysForThisSection) {
-        ++month;
-        days -= daysForThisSection;
-        daysForThisSection = getMaxDayPerMonth(year, month);
-    }
-    return DateTime::fromUncheckedValues(year, month, days+1, hours, minutes, seconds, dayOfWeek);
+    const auto days = secondsSince2000 / static_cast<SecondType>(cSecondsPerDay);
+    const auto secondsSinceMidnight = static_cast<uint32_t>(secondsSince2000 % static_cast<SecondType>(cSecondsPerDay));
+    return getDateFromDayNumber(days, secondsSinceMidnight);
 }
 
 
@@ -19,6 +19,7 @@
 
 
 #include "String.hpp"
+#include "StringBuilder.hpp"
 
 #include <cstdint>
 
@@ -136,11 +137,31 @@ public:
     /// Add one second to this date/time.
     ///
     /// This function can be used to implement a running RTC in the
-    /// background. The function only requires minimal time, except
-    /// if the day changes, because of the leap year calculation.
+    /// background. The function only requires minimal time.
     ///
     void addOneSecond();
 
+    /// Add a number of seconds to this date/time.
+    ///
+    /// The new date is calculated in constant time, independent of
+    /// the number of seconds. A negative value moves the date/time
+    /// back, but never before 2000-01-01 00:00:00, and the date/time
+    /// never moves past 9999-12-31 23:59:59.
+    ///
+    /// @param seconds The number of seconds to add.
+    ///
+    void addSeconds(int32_t seconds);
+
+    /// Add a number of days to this date/time.
+    ///
+    /// The time of the day is kept. A negative value moves the date
+    /// back, but never before 2000-01-01, and the date never moves
+    /// past 9999-12-31.
+    ///
+    /// @param days The number of days to add.
+    ///
+    void addDays(int32_t days);
+
     /// Get the year.
     /// Value from 2000-9999.
     ///
@@ -184,6 +205,15 @@ public:
     ///
     String toString(Format format) const;
 
+    /// Append this date/time to a string builder using the given format.
+    ///
+    /// This variant formats the date/time without any memory allocation.
+    ///
+    /// @param format The format for the date/time.
+    /// @param builder The builder to append the text.
+    ///
+    void toString(Format format, StringBuilder &builder) const;
+
 public:
     /// Create a new completely unchecked date time object from the given values.
     ///
@@ -201,6 +231,11 @@ public:
     static DateTime fromUncheckedValues(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second, uint8_t dayOfWeek);
 
 private:
+    /// Append this date/time to a target, using the given format.
+    ///
+    template<typename Target>
+    void appendTo(Target &target, Format format) const;
+
     /// Create a new unchecked date/time object.
     ///
     /// @param year The year from 2000-9999.
@@ -18,7 +18,13 @@
 //
 
 
+#include "SortTools.hpp"
+#include "StringView.hpp"
+
+#include <array>
+#include <cstddef>
 #include <cstring>
+#include <type_traits>
 
 
 namespace lr {
@@ -30,6 +36,8 @@ namespace lr {
 /// is slow and only suitable for a small number of strings (~ <100). The benefit is the flexibility of the map,
 /// where reordering and the actual values of the Enums does not matter.
 ///
+/// See `SortedEnumStringMap` for a map which is sorted at compile time, with fast lookups in both directions.
+///
 /// **Usage:**
 /// ```
 /// const EnumStringMap<MyEnum>({
@@ -125,5 +133,170 @@ private:
 };
 
 
+/// An enum to string map, which is sorted at compile time.
+///
+/// The map is created from a `std::array` with the entries, in any order. The constructor sorts the entries
+/// by value and by string, so if the map is declared `constexpr`, all this work is done by the compiler and
+/// the tables are placed in flash memory.
+///
+/// The lookup of a string is an array index if the enum values are consecutive, otherwise it is a binary
+/// search. The lookup of an enum value is a binary search over the strings.
+///
+/// **Usage:**
+/// ```
+/// constexpr SortedEnumStringMap<MyEnum, 3> cMyEnumMap({{
+///     {MyEnum::A, "A"},
+///     {MyEnum::B, "B"},
+///     {MyEnum::C, "C"},
+/// }}, {MyEnum::Unknown, "Unknown"});
+/// ```
+///
+/// The second parameter is the default entry. Its string is returned by `string()` if a value is not found,
+/// and its value is returned by `value()` if a string is not found.
+///
+/// @tparam Enum The enum type.
+/// @tparam entryCount The number of entries in the map.
+///
+template<typename Enum, std::size_t entryCount>
+class SortedEnumStringMap
+{
+    static_assert(entryCount > 0, "The map needs at least one entry.");
+    static_assert(entryCount < StringView::notFound, "The map has too many entries.");
+
+public:
+    /// A single entry in the map.
+    ///
+    struct Entry {
+        Enum value {}; ///< The enum value to map to a string.
+        const char *str = nullptr; ///< The string for the enum value.
+    };
+
+    /// The array with all entries of the map.
+    ///
+    using Entries = std::array<Entry, entryCount>;
+
+public:
+    /// Create a new sorted map.
+    ///
+    /// @param entries The entries for the map, in any order.
+    /// @param defaultEntry The entry which is used if a lookup fails.
+    ///
+    constexpr SortedEnumStringMap(const Entries &entries, const Entry &defaultEntry) noexcept
+        : _byValue(entries), _byString(entries), _defaultEntry(defaultEntry), _isConsecutive(true)
+    {
+        SortTools::insertionSort(_byValue, &isValueLess);
+        SortTools::insertionSort(_byString, &isStringLess);
+        for (std::size_t i = 1; i < entryCount; ++i) {
+            if (toInteger(_byValue[i].value) != toInteger(_byValue[0].value) + static_cast<Integer>(i)) {
+                _isConsecutive = false;
+            }
+        }
+    }
+
+public:
+    /// Get the string for a given enum value.
+    ///
+    /// @param value The enum value to map.
+    /// @return A pointer to the string for the entry.
+    ///    If the value is not found, the string of the default entry is used.
+    ///
+    constexpr const char* string(const Enum value) const noexcept {
+        const auto key = toInteger(value);
+        if (_isConsecutive) {
+            const auto first = toInteger(_byValue[0].value);
+            if (key < first || key - first >= static_cast<Integer>(entryCount)) {
+                return _defaultEntry.str;
+            }
+            return _byValue[static_cast<std::size_t>(key - first)].str;
+        }
+        const auto low = SortTools::lowerBound(_byValue.data(), entryCount, [key](const Entry &entry) {
+            return toInteger(entry.value) < key;
+        });
+        if (low < entryCount && toInteger(_byValue[low].value) == key) {
+            return _byValue[low].str;
+        }
+        return _defaultEntry.str;
+    }
+
+    /// Get the enum value for a given string.
+    ///
+    /// @param str The string to map. It does not need to end with a zero byte.
+    /// @return The enum value for the string. If the string is not found, the value of the default entry is used.
+    ///
+    constexpr Enum value(const StringView &str) const noexcept {
+        const auto index = indexOf(str);
+        if (index == StringView::notFound) {
+            return _defaultEntry.value;
+        }
+        return _byString[index].value;
+    }
+
+    /// Check if the map contains a given string.
+    ///
+    constexpr bool contains(const StringView &str) const noexcept {
+        return indexOf(str) != StringView::notFound;
+    }
+
+    /// Get the index of a string in the entries sorted by string.
+    ///
+    /// @param str The string to search.
+    /// @return The index in `getEntriesByString()` or `StringView::notFound` if there is no such string.
+    ///
+    constexpr StringView::Size indexOf(const StringView &str) const noexcept {
+        const auto low = SortTools::lowerBound(_byString.data(), entryCount, [&str](const Entry &entry) {
+            return SortTools::compareStrings(entry.str, str) < 0;
+        });
+        if (low < entryCount && SortTools::compareStrings(_byString[low].str, str) == 0) {
+            return static_cast<StringView::Size>(low);
+        }
+        return StringView::notFound;
+    }
+
+    /// Access all entries, sorted by string.
+    ///
+    /// Use this to iterate over the strings in alphabetic order, e.g. for completion.
+    ///
+    constexpr const Entries& getEntriesByString() const noexcept {
+        return _byString;
+    }
+
+    /// Get the number of entries in this map.
+    ///
+    constexpr static std::size_t getCount() noexcept {
+        return entryCount;
+    }
+
+private:
+    /// The integer type to compare the enum values.
+    ///
+    using Integer = typename std::conditional<
+        std::is_enum<Enum>::value, std::underlying_type<Enum>, std::common_type<Enum>>::type::type;
+
+    /// Convert an enum value into an integer.
+    ///
+    constexpr static Integer toInteger(Enum value) noexcept {
+        return static_cast<Integer>(value);
+    }
+
+    /// Compare two entries by value.
+    ///
+    constexpr static bool isValueLess(const Entry &a, const Entry &b) noexcept {
+        return toInteger(a.value) < toInteger(b.value);
+    }
+
+    /// Compare two entries by string.
+    ///
+    constexpr static bool isStringLess(const Entry &a, const Entry &b) noexcept {
+        return SortTools::compareStrings(a.str, b.str) < 0;
+    }
+
+private:
+    Entries _byValue; ///< The entries sorted by value.
+    Entries _byString; ///< The entries sorted by string.
+    Entry _defaultEntry; ///< The default entry, if a lookup fails.
+    bool _isConsecutive; ///< If the sorted values are consecutive, so a string lookup is just an index.
+};
+
+
 }
 
@@ -18,17 +18,13 @@
 #include "Fixed16.hpp"
 
 
-// Note: Parts of this code were converted from the libfixmath library into C++.
-// https://github.com/PetteriAimonen/libfixmath
+#include "StringFormat.hpp"
 
 
 namespace lr {
 namespace {
 
 
-const Fixed16::Type cMaximumValue = 0x7FFFFFFF; ///< The maximum value.
-const Fixed16::Type cMinimumValue = 0x80000000; ///< The minimum value.
-const Fixed16::Type cOverflowValue = 0x80000000; ///< The value used to indicate overflows.
 const Fixed16::Type cOneValue = 0x00010000; ///< The value for one.
 
 /// The number of defined decimal bases.
@@ -46,306 +42,334 @@ const uint32_t cDecimalBases[cDecimalBasesCount] = {
     100000
 };
 
-	
-Fixed16::Type fixedAdd(Fixed16::Type a, Fixed16::Type b)
-{
-	const auto sum = a + b;
-	if (!((a^b) & 0x80000000) && ((a^sum) & 0x80000000)) {
-		return cOverflowValue;	
-	}
-	return sum;
-}
-
-
-Fixed16::Type fixedSubtract(Fixed16::Type a, Fixed16::Type b)
-{
-	const auto diff = a - b;
-	if (((a^b) & 0x80000000) && ((a^diff) & 0x80000000)) {
-		return cOverflowValue;
-	}
-	return diff;
-}
-
-
-Fixed16::Type fixedMultiply(Fixed16::Type a, Fixed16::Type b)
-{
-	const int32_t partA = (a >> 16);
-	const int32_t partC = (b >> 16);
-	const uint32_t partB = (a & 0xFFFF);
-	const uint32_t partD = (b & 0xFFFF);
-	const int32_t resultAC = partA*partC;
-	const int32_t resultADplusCB = partA*partD + partC*partB;
-	const uint32_t resultBD = partB*partD;
-	
-	int32_t productHigh = resultAC + (resultADplusCB >> 16);
-	uint32_t productLow = resultBD + (resultADplusCB << 16);
-	if (productLow < resultBD) {
-		productHigh++;		
-	}
-	if ((productHigh >> 31) != (productHigh >> 15)) {
-		return cOverflowValue;
-	}
-	const uint32_t productLowCopy = productLow;
-	productLow -= 0x8000;
-	productLow -= (static_cast<uint32_t>(productHigh) >> 31);
-	if (productLow > productLowCopy) {
-		productHigh--;
-	}
-	Fixed16::Type result = (productHigh << 16) | (productLow >> 16);
-	result += 1;
-	return result;
-}
-
-
-Fixed16::Type fixedDivide(Fixed16::Type a, Fixed16::Type b)
-{
-	// Basic binary restoring division algorithm.
-	if (b == 0) {
-		return cMinimumValue;
-	}
-	
-	uint32_t remainder = (a >= 0) ? a : (-a);
-	uint32_t divider = (b >= 0) ? b : (-b);
-
-	uint32_t quotient = 0;
-	uint32_t bit = 0x10000;
-	
-	// The algorithm requires D >= R
-	while (divider < remainder) {
-		divider <<= 1;
-		bit <<= 1;
-	}
-	
-	if (!bit) {
-		return cOverflowValue;
-	}
-	
-	if (divider & 0x80000000) {
-		// Perform one step manually to avoid overflows later.
-		// We know that divider's bottom bit is 0 here.
-		if (remainder >= divider) {
-			quotient |= bit;
-			remainder -= divider;
-		}
-		divider >>= 1;
-		bit >>= 1;
-	}
-	
-	// Main division loop
-	while (bit && remainder) {
-		if (remainder >= divider) {
-			quotient |= bit;
-			remainder -= divider;
-		}
-		remainder <<= 1;
-		bit >>= 1;
-	}
-	
-	if (remainder >= divider) {
-		quotient++;
-	}
-	
-	Fixed16::Type result = quotient;
-	
-	// Figure out the sign of result
-	if ((a ^ b) & 0x80000000) {
-		if (result == cMinimumValue) {
-			return cOverflowValue;
-		}
-		result = -result;
-	}
-	
-	return result;
-}
-
-
-Fixed16::Type fixedSaturatingAdd(Fixed16::Type a, Fixed16::Type b)
-{
-	const auto result = fixedAdd(a, b);
-	if (result == cOverflowValue) {
-		if (a >= 0) {
-			return cMaximumValue;
-		} else {
-			return cMinimumValue;
-		}
-	}
-	return result;
-}
-
-
-Fixed16::Type fixedSaturatingSubtract(Fixed16::Type a, Fixed16::Type b)
-{
-	const auto result = fixedSubtract(a, b);
-	if (result == cOverflowValue) {
-		if (a >= 0) {
-			return cMaximumValue;
-		} else {
-			return cMinimumValue;
-		}
-	}
-	return result;
-}
-
-
-Fixed16::Type fixedSaturatingMultiply(Fixed16::Type a, Fixed16::Type b)
-{
-	const auto result = fixedMultiply(a, b);
-	if (result == cOverflowValue) {
-		if ((a >= 0) == (b >= 0)) {
-			return cMaximumValue;
-		} else {
-			return cMinimumValue;
-		}
-	}
-	return result;
-}
-
-
-Fixed16::Type fixedSaturatingDivide(Fixed16::Type a, Fixed16::Type b)
-{
-	const auto result = fixedDivide(a, b);
-	if (result == cOverflowValue) {
-		if ((a >= 0) == (b >= 0)) {
-			return cMaximumValue;
-		} else {
-			return cMinimumValue;
-		}
-	}
-	return result;
-}
-
-
-}
-
+/// The number of steps in the function tables.
+///
+const uint32_t cTableSteps = 256;
 
-Fixed16::Fixed16(const Fixed16 &value) noexcept
-	: _value(value._value)
-{
-}
+/// The value one for the function tables.
+///
+const uint32_t cTableOne = 0x10000;
 
+/// The values of sin(x) for x in [0, pi/2), in 256 steps.
+///
+const uint16_t cSineTable[256] = {
+    0, 402, 804, 1206, 1608, 2010, 2412, 2814, 3216, 3617, 4019, 4420,
+    4821, 5222, 5623, 6023, 6424, 6824, 7224, 7623, 8022, 8421, 8820, 9218,
+    9616, 10014, 10411, 10808, 11204, 11600, 11996, 12391, 12785, 13180, 13573, 13966,
+    14359, 14751, 15143, 15534, 15924, 16314, 16703, 17091, 17479, 17867, 18253, 18639,
+    19024, 19409, 19792, 20175, 20557, 20939, 21320, 21699, 22078, 22457, 22834, 23210,
+    23586, 23961, 24335, 24708, 25080, 25451, 25821, 26190, 26558, 26925, 27291, 27656,
+    28020, 28383, 28745, 29106, 29466, 29824, 30182, 30538, 30893, 31248, 31600, 31952,
+    32303, 32652, 33000, 33347, 33692, 34037, 34380, 34721, 35062, 35401, 35738, 36075,
+    36410, 36744, 37076, 37407, 37736, 38064, 38391, 38716, 39040, 39362, 39683, 40002,
+    40320, 40636, 40951, 41264, 41576, 41886, 42194, 42501, 42806, 43110, 43412, 43713,
+    44011, 44308, 44604, 44898, 45190, 45480, 45769, 46056, 46341, 46624, 46906, 47186,
+    47464, 47741, 48015, 48288, 48559, 48828, 49095, 49361, 49624, 49886, 50146, 50404,
+    50660, 50914, 51166, 51417, 51665, 51911, 52156, 52398, 52639, 52878, 53114, 53349,
+    53581, 53812, 54040, 54267, 54491, 54714, 54934, 55152, 55368, 55582, 55794, 56004,
+    56212, 56418, 56621, 56823, 57022, 57219, 57414, 57607, 57798, 57986, 58172, 58356,
+    58538, 58718, 58896, 59071, 59244, 59415, 59583, 59750, 59914, 60075, 60235, 60392,
+    60547, 60700, 60851, 60999, 61145, 61288, 61429, 61568, 61705, 61839, 61971, 62101,
+    62228, 62353, 62476, 62596, 62714, 62830, 62943, 63054, 63162, 63268, 63372, 63473,
+    63572, 63668, 63763, 63854, 63944, 64031, 64115, 64197, 64277, 64354, 64429, 64501,
+    64571, 64639, 64704, 64766, 64827, 64884, 64940, 64993, 65043, 65091, 65137, 65180,
+    65220, 65259, 65294, 65328, 65358, 65387, 65413, 65436, 65457, 65476, 65492, 65505,
+    65516, 65525, 65531, 65535
+};
 
-Fixed16 Fixed16::saturatingAdd(const Fixed16 &other) const noexcept
-{
-	return Fixed16(fixedSaturatingAdd(_value, other._value));
-}
+/// The values of atan(x) for x in [0, 1], in 256 steps.
+///
+const uint16_t cArcTangentTable[257] = {
+    0, 256, 512, 768, 1024, 1280, 1536, 1792, 2047, 2303, 2559, 2814,
+    3070, 3325, 3580, 3836, 4091, 4346, 4600, 4855, 5110, 5364, 5618, 5872,
+    6126, 6380, 6633, 6887, 7140, 7392, 7645, 7898, 8150, 8402, 8653, 8905,
+    9156, 9407, 9657, 9908, 10158, 10408, 10657, 10906, 11155, 11403, 11652, 11899,
+    12147, 12394, 12641, 12887, 13133, 13379, 13624, 13869, 14114, 14358, 14601, 14845,
+    15088, 15330, 15572, 15814, 16055, 16296, 16536, 16776, 17015, 17254, 17492, 17730,
+    17968, 18205, 18441, 18677, 18913, 19148, 19382, 19616, 19850, 20083, 20315, 20547,
+    20779, 21009, 21240, 21469, 21699, 21927, 22156, 22383, 22610, 22836, 23062, 23288,
+    23512, 23737, 23960, 24183, 24406, 24627, 24849, 25069, 25289, 25509, 25727, 25946,
+    26163, 26380, 26597, 26813, 27028, 27242, 27456, 27670, 27882, 28094, 28306, 28517,
+    28727, 28936, 29145, 29354, 29561, 29768, 29975, 30180, 30386, 30590, 30794, 30997,
+    31200, 31402, 31603, 31803, 32003, 32203, 32401, 32600, 32797, 32994, 33190, 33385,
+    33580, 33774, 33968, 34160, 34353, 34544, 34735, 34925, 35115, 35304, 35492, 35680,
+    35867, 36053, 36239, 36424, 36608, 36792, 36975, 37158, 37340, 37521, 37701, 37881,
+    38060, 38239, 38417, 38594, 38771, 38947, 39123, 39297, 39472, 39645, 39818, 39990,
+    40162, 40333, 40503, 40673, 40842, 41010, 41178, 41346, 41512, 41678, 41844, 42008,
+    42172, 42336, 42499, 42661, 42823, 42984, 43145, 43304, 43464, 43622, 43780, 43938,
+    44095, 44251, 44407, 44562, 44716, 44870, 45024, 45176, 45328, 45480, 45631, 45781,
+    45931, 46080, 46229, 46377, 46525, 46672, 46818, 46964, 47109, 47254, 47398, 47542,
+    47685, 47827, 47969, 48111, 48251, 48392, 48531, 48671, 48809, 48947, 49085, 49222,
+    49359, 49495, 49630, 49765, 49899, 50033, 50167, 50299, 50432, 50563, 50695, 50826,
+    50956, 51086, 51215, 51344, 51472
+};
 
+/// The values of 2^x - 1 for x in [0, 1), in 256 steps.
+///
+const uint16_t cExponentTable[256] = {
+    0, 178, 356, 535, 714, 893, 1073, 1254, 1435, 1617, 1799, 1981,
+    2164, 2348, 2532, 2716, 2902, 3087, 3273, 3460, 3647, 3834, 4022, 4211,
+    4400, 4590, 4780, 4971, 5162, 5353, 5546, 5738, 5932, 6125, 6320, 6514,
+    6710, 6906, 7102, 7299, 7496, 7694, 7893, 8092, 8292, 8492, 8693, 8894,
+    9096, 9298, 9501, 9704, 9908, 10113, 10318, 10524, 10730, 10937, 11144, 11352,
+    11560, 11769, 11979, 12189, 12400, 12611, 12823, 13036, 13249, 13462, 13676, 13891,
+    14106, 14322, 14539, 14756, 14974, 15192, 15411, 15630, 15850, 16071, 16292, 16514,
+    16737, 16960, 17183, 17408, 17633, 17858, 18084, 18311, 18538, 18766, 18995, 19224,
+    19454, 19684, 19915, 20147, 20379, 20612, 20846, 21080, 21315, 21550, 21786, 22023,
+    22260, 22498, 22737, 22977, 23216, 23457, 23698, 23940, 24183, 24426, 24670, 24915,
+    25160, 25406, 25652, 25900, 26148, 26396, 26645, 26895, 27146, 27397, 27649, 27902,
+    28155, 28409, 28664, 28919, 29175, 29432, 29690, 29948, 30207, 30466, 30727, 30988,
+    31249, 31512, 31775, 32039, 32303, 32568, 32834, 33101, 33369, 33637, 33906, 34175,
+    34446, 34717, 34988, 35261, 35534, 35808, 36083, 36359, 36635, 36912, 37190, 37468,
+    37747, 38028, 38308, 38590, 38872, 39155, 39439, 39724, 40009, 40295, 40582, 40870,
+    41158, 41448, 41738, 42029, 42320, 42613, 42906, 43200, 43495, 43790, 44087, 44384,
+    44682, 44981, 45280, 45581, 45882, 46184, 46487, 46791, 47095, 47401, 47707, 48014,
+    48322, 48631, 48940, 49251, 49562, 49874, 50187, 50500, 50815, 51131, 51447, 51764,
+    52082, 52401, 52721, 53041, 53363, 53685, 54008, 54333, 54658, 54983, 55310, 55638,
+    55966, 56296, 56626, 56957, 57289, 57622, 57956, 58291, 58627, 58964, 59301, 59640,
+    59979, 60319, 60661, 61003, 61346, 61690, 62035, 62381, 62727, 63075, 63424, 63774,
+    64124, 64476, 64828, 65182
+};
 
-Fixed16& Fixed16::operator-=(const Fixed16 &other) noexcept
-{
-	_value -= other._value;
-	return *this;
-}
+/// The values of log2(1 + x) for x in [0, 1), in 256 steps.
+///
+const uint16_t cLogarithmTable[256] = {
+    0, 369, 736, 1102, 1466, 1829, 2190, 2551, 2909, 3267, 3623, 3978,
+    4331, 4683, 5034, 5384, 5732, 6079, 6425, 6769, 7112, 7454, 7795, 8134,
+    8473, 8810, 9146, 9480, 9814, 10146, 10477, 10807, 11136, 11464, 11791, 12116,
+    12440, 12764, 13086, 13407, 13727, 14046, 14363, 14680, 14996, 15310, 15624, 15937,
+    16248, 16559, 16868, 17177, 17484, 17791, 18096, 18401, 18704, 19007, 19308, 19609,
+    19909, 20207, 20505, 20802, 21098, 21393, 21687, 21980, 22272, 22564, 22854, 23144,
+    23433, 23720, 24007, 24293, 24579, 24863, 25146, 25429, 25711, 25992, 26272, 26551,
+    26830, 27108, 27384, 27660, 27936, 28210, 28484, 28757, 29029, 29300, 29571, 29840,
+    30109, 30378, 30645, 30912, 31178, 31443, 31707, 31971, 32234, 32496, 32758, 33019,
+    33279, 33538, 33797, 34055, 34312, 34569, 34825, 35080, 35334, 35588, 35841, 36094,
+    36346, 36597, 36847, 37097, 37346, 37595, 37842, 38090, 38336, 38582, 38827, 39072,
+    39316, 39559, 39802, 40044, 40286, 40527, 40767, 41006, 41246, 41484, 41722, 41959,
+    42196, 42432, 42667, 42902, 43137, 43370, 43603, 43836, 44068, 44300, 44530, 44761,
+    44990, 45220, 45448, 45676, 45904, 46131, 46357, 46583, 46809, 47034, 47258, 47482,
+    47705, 47928, 48150, 48372, 48593, 48813, 49034, 49253, 49472, 49691, 49909, 50127,
+    50344, 50560, 50776, 50992, 51207, 51422, 51636, 51850, 52063, 52276, 52488, 52700,
+    52911, 53122, 53332, 53542, 53751, 53960, 54169, 54377, 54584, 54791, 54998, 55204,
+    55410, 55615, 55820, 56025, 56229, 56432, 56635, 56838, 57040, 57242, 57443, 57644,
+    57845, 58045, 58245, 58444, 58643, 58841, 59039, 59237, 59434, 59631, 59827, 60023,
+    60219, 60414, 60609, 60803, 60997, 61190, 61384, 61576, 61769, 61961, 62152, 62343,
+    62534, 62725, 62915, 63104, 63294, 63483, 63671, 63859, 64047, 64234, 64421, 64608,
+    64794, 64980, 65166, 65351
+};
 
+/// The raw value for pi/2.
+///
+const Fixed16::Type cHalfPiValue = 102944;
 
-Fixed16 Fixed16::operator-(const Fixed16 &other) const noexcept
-{
-	return Fixed16(_value - other._value);
-}
+/// The factor to convert radians into a 32-bit turn, with 16 fraction bits.
+///
+const int64_t cRadiansToTurn = 683565276;
 
+/// The value log2(e), with 30 fraction bits.
+///
+const int64_t cLog2E = 1549082005;
 
-Fixed16 Fixed16::saturatingSubtract(const Fixed16 &other) const noexcept
-{
-	return Fixed16(fixedSaturatingSubtract(_value, other._value));
-}
+/// The value ln(2), with 32 fraction bits.
+///
+const int64_t cLn2 = 2977044472;
 
 
-Fixed16& Fixed16::operator*=(const Fixed16 &other) noexcept
+/// Interpolate between two table entries.
+///
+/// @param first The first entry.
+/// @param second The second entry.
+/// @param fraction The position between the entries, with 16 fraction bits.
+/// @return The interpolated value.
+///
+inline uint32_t Fixed16_interpolate(uint32_t first, uint32_t second, uint32_t fraction)
 {
-	_value = fixedMultiply(_value, other._value);
-	return *this;
+    const auto delta = static_cast<int32_t>(second - first);
+    return static_cast<uint32_t>(static_cast<int32_t>(first) + ((delta * static_cast<int32_t>(fraction) + 0x8000) >> 16));
 }
 
 
-Fixed16 Fixed16::operator*(const Fixed16 &other) const noexcept
+/// Look up a table with 256 entries for [0, 1) and the value one at the end.
+///
+/// @param table The table.
+/// @param position The position in the table, with 24 fraction bits, in the range [0, 1].
+/// @return The interpolated value, with 16 fraction bits.
+///
+inline uint32_t Fixed16_lookUp(const uint16_t *table, uint32_t position)
 {
-	return Fixed16(fixedMultiply(_value, other._value));
+    const auto index = position >> 16;
+    if (index >= cTableSteps) {
+        return cTableOne;
+    }
+    const uint32_t next = (index + 1 < cTableSteps) ? table[index + 1] : cTableOne;
+    return Fixed16_interpolate(table[index], next, position & 0xffffu);
 }
 
 
-Fixed16 Fixed16::saturatingMultiply(const Fixed16 &other) const noexcept
+/// Get the sine for a 32-bit turn.
+///
+inline Fixed16::Type Fixed16_sine(uint32_t turn)
 {
-	return Fixed16(fixedSaturatingMultiply(_value, other._value));
+    const auto quadrant = turn >> 30;
+    auto position = (turn >> 6) & 0xffffffu;
+    if ((quadrant & 1u) != 0) {
+        position = 0x1000000u - position;
+    }
+    const auto value = static_cast<Fixed16::Type>(Fixed16_lookUp(cSineTable, position));
+    return (quadrant >= 2) ? -value : value;
 }
 
 
-Fixed16& Fixed16::operator/=(const Fixed16 &other) noexcept
+/// Convert an angle in radians into a 32-bit turn.
+///
+inline uint32_t Fixed16_getTurn(Fixed16::Type value)
 {
-	_value = fixedDivide(_value, other._value);
-	return *this;
+    return static_cast<uint32_t>((static_cast<int64_t>(value) * cRadiansToTurn) >> 16);
 }
 
 
-Fixed16 Fixed16::operator/(const Fixed16 &other) const noexcept
+/// Calculate the square root of a 64-bit value, rounded to the nearest integer.
+///
+inline uint32_t Fixed16_squareRoot(uint64_t value)
 {
-	return Fixed16(fixedDivide(_value, other._value));
+    uint64_t result = 0;
+    uint64_t bit = static_cast<uint64_t>(1) << 62;
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    // The remainder is value - result^2, round up if it is larger than result.
+    if (value > result) {
+        result += 1;
+    }
+    return static_cast<uint32_t>(result);
 }
 
 
-Fixed16 Fixed16::saturatingDivide(const Fixed16 &other) const noexcept
-{
-	return Fixed16(fixedSaturatingDivide(_value, other._value));
 }
 
 
-bool Fixed16::operator>=(const Fixed16 &other) const noexcept
+float Fixed16::toFloat() const
 {
-	return (_value >= other._value);
+	return static_cast<float>(_value)/static_cast<float>(cOneValue);
 }
 
 
-bool Fixed16::operator>(const Fixed16 &other) const noexcept
+Fixed16 Fixed16::getSquareRoot() const noexcept
 {
-	return (_value > other._value);
+    if (_value < 0) {
+        return overflow();
+    }
+    return Fixed16(static_cast<Type>(Fixed16_squareRoot(static_cast<uint64_t>(_value) << 16)));
 }
 
 
-float Fixed16::toFloat() const
+Fixed16 Fixed16::getSine() const noexcept
 {
-	return static_cast<float>(_value)/static_cast<float>(cOneValue);
+    return Fixed16(Fixed16_sine(Fixed16_getTurn(_value)));
 }
 
 
-bool Fixed16::operator<=(const Fixed16 &other) const noexcept
+Fixed16 Fixed16::getCosine() const noexcept
 {
-	return (_value <= other._value);
+    return Fixed16(Fixed16_sine(Fixed16_getTurn(_value) + 0x40000000u));
 }
 
 
-bool Fixed16::operator<(const Fixed16 &other) const noexcept
+Fixed16 Fixed16::getArcTangent2(const Fixed16 &y, const Fixed16 &x) noexcept
 {
-	return (_value < other._value);
+    const auto absoluteX = getMagnitude(x._value);
+    const auto absoluteY = getMagnitude(y._value);
+    if (absoluteX == 0 && absoluteY == 0) {
+        return Fixed16();
+    }
+    // Reduce the angle to the first octant, with a ratio in the range [0, 1] and 24 fraction bits.
+    const bool isSwapped = absoluteY > absoluteX;
+    const auto numerator = isSwapped ? absoluteX : absoluteY;
+    const auto denominator = isSwapped ? absoluteY : absoluteX;
+    const auto ratio = static_cast<uint32_t>((static_cast<uint64_t>(numerator) << 24) / denominator);
+    const auto index = ratio >> 16;
+    Type angle;
+    if (index >= cTableSteps) {
+        angle = cArcTangentTable[cTableSteps];
+    } else {
+        angle = static_cast<Type>(Fixed16_interpolate(
+            cArcTangentTable[index], cArcTangentTable[index + 1], ratio & 0xffffu));
+    }
+    if (isSwapped) {
+        angle = cHalfPiValue - angle;
+    }
+    if (x._value < 0) {
+        angle = pi()._value - angle;
+    }
+    return Fixed16((y._value < 0) ? -angle : angle);
 }
 
 
-bool Fixed16::operator!=(const Fixed16 &other) const noexcept
+Fixed16 Fixed16::getExponential() const noexcept
 {
-	return (_value != other._value);
+    // e^x = 2^(x * log2(e)), split into an integer exponent and a fraction.
+    const auto exponent = static_cast<int64_t>(_value) * cLog2E;
+    const auto integer = static_cast<int32_t>(exponent >> 46);
+    if (integer >= 15) {
+        return overflow();
+    }
+    if (integer < -32) {
+        return Fixed16();
+    }
+    const auto fraction = static_cast<uint32_t>(static_cast<uint64_t>(exponent) >> 22) & 0xffffffu;
+    const auto mantissa = cTableOne + Fixed16_lookUp(cExponentTable, fraction);
+    if (integer >= 0) {
+        return Fixed16(static_cast<Type>(mantissa << integer));
+    }
+    const auto shift = static_cast<uint32_t>(-integer);
+    return Fixed16(static_cast<Type>((mantissa + (1u << (shift - 1))) >> shift));
 }
 
 
-bool Fixed16::operator==(const Fixed16 &other) const noexcept
+Fixed16 Fixed16::getLogarithm() const noexcept
 {
-	return (_value == other._value);
+    if (_value <= 0) {
+        return overflow();
+    }
+    // ln(x) = log2(x) * ln(2), with log2(x) = exponent + log2(mantissa).
+    const auto highestBit = 31 - __builtin_clz(static_cast<uint32_t>(_value));
+    const auto mantissa = static_cast<uint32_t>(_value) << (31 - highestBit);
+    const auto logarithm = static_cast<int32_t>((highestBit - 16) * static_cast<int32_t>(cTableOne)
+        + static_cast<int32_t>(Fixed16_lookUp(cLogarithmTable, (mantissa >> 7) & 0xffffffu)));
+    return Fixed16(static_cast<Type>((static_cast<int64_t>(logarithm) * cLn2 + 0x80000000ll) >> 32));
 }
 
 
-Fixed16& Fixed16::operator+=(const Fixed16 &other) noexcept
+Fixed16 Fixed16::getSaturatingSquareRoot() const noexcept
 {
-	_value += other._value;
-	return *this;
+    if (_value < 0) {
+        return Fixed16();
+    }
+    return getSquareRoot();
 }
 
 
-Fixed16 Fixed16::operator+(const Fixed16 &other) const noexcept
+Fixed16 Fixed16::getSaturatingExponential() const noexcept
 {
-	return Fixed16(_value + other._value);
+    return Fixed16(saturate(getExponential()._value, true));
 }
 
 
-Fixed16& Fixed16::operator=(const Fixed16 &other) noexcept
+Fixed16 Fixed16::getSaturatingLogarithm() const noexcept
 {
-	_value = other._value;
-	return *this;
+    if (_value <= 0) {
+        return minimum();
+    }
+    return getLogarithm();
 }
 
 
@@ -363,45 +387,29 @@ uint8_t Fixed16::getIntegerDigitCount() const
 
 void Fixed16::toString(char *buffer, uint8_t fractionDigits) const
 {
-    // Lamdba function to write a character.
-    auto writeChar = [&buffer](char c){
-        *buffer = c;
+    // Split the absolute value into the integer and fraction part.
+    uint32_t value = static_cast<uint32_t>(_value);
+    if (_value < 0) {
+        *buffer = '-';
         ++buffer;
-    };
-    // Write the negative sign (or not).
-    int16_t value = toRawInteger();
-    if (value < 0) {
-        writeChar('-');
-        value += -1;
+        value = static_cast<uint32_t>(0) - value;
     }
     // First write the integer part.
-    int16_t base = 10000;
-    bool skipZero = true;
-    while (base != 0) {
-        const int16_t digit = value/base;
-        const int16_t newValue = value%base;
-        if (!skipZero || digit > 0) {
-            writeChar('0'+digit);
-            skipZero = false;
-        }
-        value = newValue;
-        base /= 10;
-    }
+    buffer += StringFormat::writeDecimal(buffer, value >> 16);
     // Write the fraction digits.
     if (fractionDigits > 0) {
-        writeChar('.');
-        base = cDecimalBases[fractionDigits];
-        value = (getFraction()*Fixed16(base)).toRawInteger();
-        base /= 10;
-        while (base != 0) {
-            const int16_t digit = value/base;
-            const int16_t newValue = value%base;
-            writeChar('0'+digit);
-            value = newValue;
-            base /= 10;
+        *buffer = '.';
+        ++buffer;
+        const auto base = cDecimalBases[fractionDigits];
+        const auto fraction = static_cast<uint32_t>((static_cast<uint64_t>(value & 0xffffu) * base) >> 16);
+        // Pad the fraction with leading zeros.
+        for (uint8_t i = StringFormat::getDecimalDigitCount(fraction); i < fractionDigits; ++i) {
+            *buffer = '0';
+            ++buffer;
         }
+        buffer += StringFormat::writeDecimal(buffer, fraction);
     }
-    writeChar('\0');
+    *buffer = '\0';
 }
 
 
@@ -23,6 +23,10 @@
 #include <cstdint>
 
 
+// Note: Parts of this code were converted from the libfixmath library into C++.
+// https://github.com/PetteriAimonen/libfixmath
+
+
 namespace lr {
 
 
@@ -54,44 +58,210 @@ public: // Constructors
 
 	/// Copy constructor.
 	///
-	Fixed16(const Fixed16 &value) noexcept;
+	constexpr Fixed16(const Fixed16 &value) noexcept = default;
 
 public: // Assignment
-	Fixed16& operator=(const Fixed16 &other) noexcept;
+	constexpr Fixed16& operator=(const Fixed16 &other) noexcept = default;
 
 public: // Operators
-	Fixed16 operator+(const Fixed16 &other) const noexcept;
-	Fixed16 operator-(const Fixed16 &other) const noexcept;
-	Fixed16 operator*(const Fixed16 &other) const noexcept;
-	Fixed16 operator/(const Fixed16 &other) const noexcept;
+	constexpr Fixed16 operator+(const Fixed16 &other) const noexcept { return Fixed16(wrappingAdd(_value, other._value)); }
+	constexpr Fixed16 operator-(const Fixed16 &other) const noexcept { return Fixed16(wrappingSubtract(_value, other._value)); }
+	constexpr Fixed16 operator*(const Fixed16 &other) const noexcept { return Fixed16(multiplyValues(_value, other._value)); }
+	constexpr Fixed16 operator/(const Fixed16 &other) const noexcept { return Fixed16(divideValues(_value, other._value)); }
 
 public: // Manipulators
-	Fixed16& operator+=(const Fixed16 &other) noexcept;
-	Fixed16& operator-=(const Fixed16 &other) noexcept;
-	Fixed16& operator*=(const Fixed16 &other) noexcept;
-	Fixed16& operator/=(const Fixed16 &other) noexcept;
+	constexpr Fixed16& operator+=(const Fixed16 &other) noexcept { _value = wrappingAdd(_value, other._value); return *this; }
+	constexpr Fixed16& operator-=(const Fixed16 &other) noexcept { _value = wrappingSubtract(_value, other._value); return *this; }
+	constexpr Fixed16& operator*=(const Fixed16 &other) noexcept { _value = multiplyValues(_value, other._value); return *this; }
+	constexpr Fixed16& operator/=(const Fixed16 &other) noexcept { _value = divideValues(_value, other._value); return *this; }
 
 public: // Saturating operators
-	Fixed16 saturatingAdd(const Fixed16 &other) const noexcept;
-	Fixed16 saturatingSubtract(const Fixed16 &other) const noexcept;
-	Fixed16 saturatingMultiply(const Fixed16 &other) const noexcept;
-	Fixed16 saturatingDivide(const Fixed16 &other) const noexcept;
+	constexpr Fixed16 saturatingAdd(const Fixed16 &other) const noexcept {
+		return Fixed16(saturate(addValues(_value, other._value), _value >= 0));
+	}
+	constexpr Fixed16 saturatingSubtract(const Fixed16 &other) const noexcept {
+		return Fixed16(saturate(subtractValues(_value, other._value), _value >= 0));
+	}
+	constexpr Fixed16 saturatingMultiply(const Fixed16 &other) const noexcept {
+		return Fixed16(saturate(multiplyValues(_value, other._value), (_value >= 0) == (other._value >= 0)));
+	}
+	constexpr Fixed16 saturatingDivide(const Fixed16 &other) const noexcept {
+		return Fixed16(saturate(divideValues(_value, other._value), (_value >= 0) == (other._value >= 0)));
+	}
+
+public: // Fast division
+	/// Divide using a reciprocal, calculated with Newton-Raphson iterations.
+	///
+	/// This is faster than the bit-serial division of `operator/()`, but the result can differ from the
+	/// correctly rounded quotient by one or two in the last bit of the fraction. Like `operator/()`,
+	/// a division by zero returns `minimum()` and an overflow returns `overflow()`.
+	///
+	/// @param other The divisor.
+	/// @return The quotient.
+	///
+	constexpr Fixed16 fastDivide(const Fixed16 &other) const noexcept {
+		return Fixed16(fastDivideValues(_value, other._value));
+	}
+
+	/// Get the reciprocal value, using `fastDivide()`.
+	///
+	constexpr Fixed16 getReciprocal() const noexcept {
+		return one().fastDivide(*this);
+	}
 
 public: // Comparators
-	bool operator==(const Fixed16 &other) const noexcept;
-	bool operator!=(const Fixed16 &other) const noexcept;
-	bool operator<=(const Fixed16 &other) const noexcept;
-	bool operator>=(const Fixed16 &other) const noexcept;
-	bool operator<(const Fixed16 &other) const noexcept;
-	bool operator>(const Fixed16 &other) const noexcept;
+	constexpr bool operator==(const Fixed16 &other) const noexcept { return _value == other._value; }
+	constexpr bool operator!=(const Fixed16 &other) const noexcept { return _value != other._value; }
+	constexpr bool operator<=(const Fixed16 &other) const noexcept { return _value <= other._value; }
+	constexpr bool operator>=(const Fixed16 &other) const noexcept { return _value >= other._value; }
+	constexpr bool operator<(const Fixed16 &other) const noexcept { return _value < other._value; }
+	constexpr bool operator>(const Fixed16 &other) const noexcept { return _value > other._value; }
 
 public: // Constants
-	static inline Fixed16 one() noexcept { return Fixed16(static_cast<Type>(0x00010000UL)); }
-	static inline Fixed16 pi() noexcept { return Fixed16(static_cast<Type>(205887UL)); }
-	static inline Fixed16 e() noexcept { return Fixed16(static_cast<Type>(178145UL)); }
-	static inline Fixed16 minimum() noexcept { return Fixed16(static_cast<Type>(0x80000000UL)); }
-	static inline Fixed16 maximum() noexcept { return Fixed16(static_cast<Type>(0x7FFFFFFFUL)); }
-	static inline Fixed16 overflow() noexcept { return Fixed16(static_cast<Type>(0x80000000UL)); }
+	constexpr static Fixed16 one() noexcept { return Fixed16(static_cast<Type>(0x00010000UL)); }
+	constexpr static Fixed16 pi() noexcept { return Fixed16(static_cast<Type>(205887UL)); }
+	constexpr static Fixed16 e() noexcept { return Fixed16(static_cast<Type>(178145UL)); }
+	constexpr static Fixed16 minimum() noexcept { return Fixed16(static_cast<Type>(0x80000000UL)); }
+	constexpr static Fixed16 maximum() noexcept { return Fixed16(static_cast<Type>(0x7FFFFFFFUL)); }
+	constexpr static Fixed16 overflow() noexcept { return Fixed16(static_cast<Type>(0x80000000UL)); }
+
+public: // Raw arithmetic
+	/// Add two raw values, wrapping on overflow.
+	///
+	constexpr static Type wrappingAdd(Type a, Type b) noexcept {
+		return static_cast<Type>(static_cast<uint32_t>(a) + static_cast<uint32_t>(b));
+	}
+
+	/// Subtract two raw values, wrapping on overflow.
+	///
+	constexpr static Type wrappingSubtract(Type a, Type b) noexcept {
+		return static_cast<Type>(static_cast<uint32_t>(a) - static_cast<uint32_t>(b));
+	}
+
+	/// Add two raw values.
+	///
+	/// @return The sum, or the overflow value if the sum does not fit.
+	///
+	constexpr static Type addValues(Type a, Type b) noexcept {
+		const auto sum = wrappingAdd(a, b);
+		if (!((a^b) & cSignBit) && ((a^sum) & cSignBit)) {
+			return cOverflowValue;
+		}
+		return sum;
+	}
+
+	/// Subtract two raw values.
+	///
+	/// @return The difference, or the overflow value if the difference does not fit.
+	///
+	constexpr static Type subtractValues(Type a, Type b) noexcept {
+		const auto difference = wrappingSubtract(a, b);
+		if (((a^b) & cSignBit) && ((a^difference) & cSignBit)) {
+			return cOverflowValue;
+		}
+		return difference;
+	}
+
+	/// Multiply two raw values, rounded to the nearest value.
+	///
+	/// The compiler translates the 64-bit product into a single long multiply instruction (e.g. `SMULL`).
+	///
+	/// @return The product, or the overflow value if the product does not fit.
+	///
+	constexpr static Type multiplyValues(Type a, Type b) noexcept {
+		return roundProduct(static_cast<int64_t>(a) * b);
+	}
+
+	/// Convert a 64-bit product of two raw values, or a sum of products, into a raw value.
+	///
+	/// @param product The product with 32 fraction bits.
+	/// @return The value rounded to the nearest value, or the overflow value if it does not fit.
+	///
+	constexpr static Type roundProduct(int64_t product) noexcept {
+		const auto high = static_cast<int32_t>(product >> 32);
+		if ((high >> 31) != (high >> 15)) {
+			return cOverflowValue;
+		}
+		// Subtracting 0.5 and adding one after the shift rounds to the nearest value, the additional
+		// subtraction for negative values handles the case of an exact half.
+		const auto rounded = static_cast<uint64_t>(product) - 0x8000u - ((product < 0) ? 1u : 0u);
+		return static_cast<Type>(static_cast<uint32_t>(rounded >> 16) + 1u);
+	}
+
+	/// Divide two raw values, using a binary restoring division.
+	///
+	/// @return The quotient rounded to the nearest value, the minimum value for a division by zero
+	///	or the overflow value if the quotient does not fit.
+	///
+	constexpr static Type divideValues(Type a, Type b) noexcept {
+		if (b == 0) {
+			return cMinimumValue;
+		}
+		uint32_t remainder = getMagnitude(a);
+		uint32_t divider = getMagnitude(b);
+		uint32_t quotient = 0;
+		uint32_t bit = 0x10000;
+		// The algorithm requires D >= R
+		while (divider < remainder) {
+			divider <<= 1;
+			bit <<= 1;
+		}
+		if (!bit) {
+			return cOverflowValue;
+		}
+		if (divider & 0x80000000u) {
+			// Perform one step manually to avoid overflows later.
+			// We know that divider's bottom bit is 0 here.
+			if (remainder >= divider) {
+				quotient |= bit;
+				remainder -= divider;
+			}
+			divider >>= 1;
+			bit >>= 1;
+		}
+		while (bit && remainder) {
+			if (remainder >= divider) {
+				quotient |= bit;
+				remainder -= divider;
+			}
+			remainder <<= 1;
+			bit >>= 1;
+		}
+		if (remainder >= divider) {
+			quotient++;
+		}
+		return applySign(quotient, (a ^ b) < 0);
+	}
+
+	/// Divide two raw values, using a reciprocal calculated with Newton-Raphson iterations.
+	///
+	/// @return The quotient, the minimum value for a division by zero or the overflow value
+	///	if the quotient does not fit.
+	///
+	constexpr static Type fastDivideValues(Type a, Type b) noexcept {
+		if (b == 0) {
+			return cMinimumValue;
+		}
+		const uint32_t dividend = getMagnitude(a);
+		const uint32_t divisor = getMagnitude(b);
+		// Normalize the divisor into the range [0.5, 1) with 32 fraction bits.
+		const auto shift = static_cast<uint8_t>(__builtin_clz(divisor));
+		const uint32_t normalized = divisor << shift;
+		// Initial estimate 48/17 - 32/17 * d with an error below 1/17, with 30 fraction bits.
+		uint32_t reciprocal = 3031741621u - static_cast<uint32_t>((2021161081ull * normalized) >> 32);
+		// Each iteration x = x * (2 - d * x) doubles the number of correct bits.
+		for (uint8_t i = 0; i < 3; ++i) {
+			const auto error = 0x80000000u - static_cast<uint32_t>((static_cast<uint64_t>(normalized) * reciprocal) >> 32);
+			reciprocal = static_cast<uint32_t>((static_cast<uint64_t>(reciprocal) * error) >> 30);
+		}
+		const uint8_t resultShift = 46 - shift;
+		const auto product = static_cast<uint64_t>(dividend) * reciprocal;
+		const auto quotient = (product + (1ull << (resultShift - 1))) >> resultShift;
+		if (quotient > 0x80000000ull) {
+			return cOverflowValue;
+		}
+		return applySign(static_cast<uint32_t>(quotient), (a ^ b) < 0);
+	}
 
 public: // Checks
 	/// Check if this value is zero
@@ -103,19 +273,19 @@ public: // Checks
 public: // Math
 	/// Get the absolute value.
 	///
-	inline Fixed16 getAbsolute() const {
+	constexpr Fixed16 getAbsolute() const noexcept {
 		return Fixed16(_value < 0 ? -_value : _value);
 	}
 	
 	/// Get the floor value.
 	///
-	inline Fixed16 getFloor() const {
+	constexpr Fixed16 getFloor() const noexcept {
 		return Fixed16(static_cast<Type>(_value & 0xffff0000UL));
 	}
 	 
     /// Get the rounded value.
     ///
-    inline Fixed16 getRounded() const {
+    constexpr Fixed16 getRounded() const noexcept {
         auto result = static_cast<Type>(_value & 0xffff0000UL);
         const auto signs = _value & 0x80008000UL;
         if (signs == 0x00008000UL) {
@@ -128,46 +298,113 @@ public: // Math
   
 	/// Get the ceil value.
 	///
-	inline Fixed16 getCeiling() const {
+	constexpr Fixed16 getCeiling() const noexcept {
 		return Fixed16(static_cast<Type>((_value & 0xFFFF0000UL) + (((_value & 0x0000FFFFUL) != 0)?0x00010000:0x00000000)));
 	}
 
 	/// Get just the fraction.
 	///
-	inline Fixed16 getFraction() const {
+	constexpr Fixed16 getFraction() const noexcept {
 		return Fixed16(static_cast<Type>(_value & 0x0000ffffu));
 	}
 	
 	/// Get the minimum from this and the other value.
 	///
-	inline Fixed16 getMinimum(const Fixed16 &other) const {
+	constexpr Fixed16 getMinimum(const Fixed16 &other) const noexcept {
 		return Fixed16((_value < other._value) ? _value : other._value);
 	}
 	
 	/// Get the maximum from this and the other value.
 	///
-	inline Fixed16 getMaximum(const Fixed16 &other) const {
+	constexpr Fixed16 getMaximum(const Fixed16 &other) const noexcept {
 		return Fixed16((_value > other._value) ? _value : other._value);
 	}
 	
 	/// Clamp this value to the selected range.
 	///
-	inline Fixed16 getClamped(const Fixed16 &minimum, const Fixed16 &maximum) const {
+	constexpr Fixed16 getClamped(const Fixed16 &minimum, const Fixed16 &maximum) const noexcept {
 		return (*this).getMinimum(maximum).getMaximum(minimum);
 	}
 
+public: // Transcendental functions
+	/// Get the square root.
+	///
+	/// The result is correctly rounded, with an error of at most 0.5 in the last bit.
+	///
+	/// @return The square root, or `overflow()` for negative values.
+	///
+	Fixed16 getSquareRoot() const noexcept;
+
+	/// Get the sine of this angle in radians.
+	///
+	/// Uses a quarter wave table with linear interpolation. The error is at most 2 in the last bit
+	/// for angles in the range [-2pi, 2pi], and slowly grows for larger angles.
+	///
+	Fixed16 getSine() const noexcept;
+
+	/// Get the cosine of this angle in radians.
+	///
+	/// @see getSine()
+	///
+	Fixed16 getCosine() const noexcept;
+
+	/// Get the angle of a vector, in radians.
+	///
+	/// Uses a table with linear interpolation for the first octant. The error is at most 2 in the last bit.
+	///
+	/// @param y The y coordinate of the vector.
+	/// @param x The x coordinate of the vector.
+	/// @return The angle in the range [-pi, pi], zero if both coordinates are zero.
+	///
+	static Fixed16 getArcTangent2(const Fixed16 &y, const Fixed16 &x) noexcept;
+
+	/// Get e raised to the power of this value.
+	///
+	/// Uses a table for 2^x with linear interpolation. The relative error is below 2e-5, plus 1 in
+	/// the last bit for small results.
+	///
+	/// @return The result, or `overflow()` if the result does not fit (for values above ~10.397).
+	///
+	Fixed16 getExponential() const noexcept;
+
+	/// Get the natural logarithm.
+	///
+	/// Uses a table for log2(x) with linear interpolation. The error is at most 2 in the last bit.
+	///
+	/// @return The result, or `overflow()` for zero and negative values.
+	///
+	Fixed16 getLogarithm() const noexcept;
+
+	/// Get the square root, saturating at the extremes.
+	///
+	/// @return The square root, or zero for negative values.
+	///
+	Fixed16 getSaturatingSquareRoot() const noexcept;
+
+	/// Get e raised to the power of this value, saturating at the extremes.
+	///
+	/// @return The result, or `maximum()` if the result does not fit.
+	///
+	Fixed16 getSaturatingExponential() const noexcept;
+
+	/// Get the natural logarithm, saturating at the extremes.
+	///
+	/// @return The result, or `minimum()` for zero and negative values.
+	///
+	Fixed16 getSaturatingLogarithm() const noexcept;
+
 public: // Conversions
 	/// Access the raw value.
 	///
-	inline Type toRawValue() const { return _value; }
+	constexpr Type toRawValue() const noexcept { return _value; }
 
 	/// Get the integer part of this value.
 	///
-	inline int16_t toRawInteger() const { return (_value >> 16); }
+	constexpr int16_t toRawInteger() const noexcept { return (_value >> 16); }
 		
 	/// Get the fraction part of this value.
 	///
-	inline uint16_t toRawFraction() const {
+	constexpr uint16_t toRawFraction() const noexcept {
 		return static_cast<uint16_t>(_value & 0x0000ffffu);
 	}
 
@@ -209,6 +446,40 @@ public: // String conversion and display.
     ///
     String toString(uint8_t fractionDigits) const;
 
+private:
+	constexpr static Type cOverflowValue = static_cast<Type>(0x80000000UL); ///< The value used to indicate overflows.
+	constexpr static Type cMinimumValue = static_cast<Type>(0x80000000UL); ///< The minimum value.
+	constexpr static uint32_t cSignBit = 0x80000000UL; ///< The sign bit of the raw value.
+
+	/// Get the magnitude of a raw value.
+	///
+	constexpr static uint32_t getMagnitude(Type value) noexcept {
+		return (value >= 0) ? static_cast<uint32_t>(value) : (0u - static_cast<uint32_t>(value));
+	}
+
+	/// Apply a sign to a magnitude.
+	///
+	/// @return The signed value, or the overflow value if the magnitude does not fit.
+	///
+	constexpr static Type applySign(uint32_t magnitude, bool isNegative) noexcept {
+		if (isNegative) {
+			if (magnitude == cSignBit) {
+				return cOverflowValue;
+			}
+			return static_cast<Type>(0u - magnitude);
+		}
+		return static_cast<Type>(magnitude);
+	}
+
+	/// Replace the overflow value with the maximum or minimum value.
+	///
+	constexpr static Type saturate(Type value, bool isPositive) noexcept {
+		if (value == cOverflowValue) {
+			return isPositive ? static_cast<Type>(0x7FFFFFFFUL) : cMinimumValue;
+		}
+		return value;
+	}
+
 protected:
 	Type _value;
 };
@@ -0,0 +1,73 @@
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#include "Fixed16Kernels.hpp"
+
+
+namespace lr {
+namespace Fixed16Kernels {
+
+
+Fixed16 dotProduct(const Fixed16 *a, const Fixed16 *b, uint16_t count) noexcept
+{
+    Accumulator accumulator;
+    for (uint16_t i = 0; i < count; ++i) {
+        accumulator.addProduct(a[i], b[i]);
+    }
+    return accumulator.getResult();
+}
+
+
+void scaleOffset(const Fixed16 *input, Fixed16 *output, uint16_t count, Fixed16 scale, Fixed16 offset) noexcept
+{
+    const Accumulator start(offset);
+    for (uint16_t i = 0; i < count; ++i) {
+        auto accumulator = start;
+        accumulator.addProduct(input[i], scale);
+        output[i] = accumulator.getResult();
+    }
+}
+
+
+void multiplyAccumulate(const Fixed16 *a, const Fixed16 *b, Fixed16 *output, uint16_t count) noexcept
+{
+    for (uint16_t i = 0; i < count; ++i) {
+        Accumulator accumulator(output[i]);
+        accumulator.addProduct(a[i], b[i]);
+        output[i] = accumulator.getResult();
+    }
+}
+
+
+void fir(const Fixed16 *input, Fixed16 *output, uint16_t count, const Fixed16 *coefficients, uint16_t tapCount) noexcept
+{
+    for (uint16_t i = 0; i < count; ++i) {
+        // The newest sample for this output is at the end of the window.
+        const Fixed16 *sample = input + i + tapCount - 1;
+        Accumulator accumulator;
+        for (uint16_t k = 0; k < tapCount; ++k) {
+            accumulator.addProduct(coefficients[k], *(sample - k));
+        }
+        output[i] = accumulator.getResult();
+    }
+}
+
+
+}
+}
+
+
@@ -0,0 +1,154 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+
+#include "Fixed16.hpp"
+
+#include <cstdint>
+
+
+/// @namespace lr::Fixed16Kernels
+///
+/// Batch kernels for `Fixed16` values, for filters and other DSP style workloads.
+///
+/// All kernels accumulate the full 64-bit products and round only once at the end. This is more precise
+/// than a sequence of `Fixed16` operations, and intermediate sums can exceed the `Fixed16` range without
+/// problems. On targets with long multiply-accumulate instructions, like the Cortex-M3/M4, the compiler
+/// translates each step into a single `SMLAL` instruction.
+///
+/// Results which do not fit into a `Fixed16` value are returned as `Fixed16::overflow()`.
+///
+
+namespace lr {
+namespace Fixed16Kernels {
+
+
+/// A multiply-accumulate unit with a 64-bit accumulator.
+///
+/// The accumulator keeps the products with 32 fraction bits, which is enough for 65536 products
+/// of the maximum `Fixed16` values.
+///
+class Accumulator
+{
+public:
+    /// Create a new accumulator with the value zero.
+    ///
+    constexpr Accumulator() noexcept : _value(0) {}
+
+    /// Create a new accumulator with an initial value.
+    ///
+    constexpr explicit Accumulator(Fixed16 value) noexcept
+        : _value(static_cast<int64_t>(value.toRawValue()) * Fixed16::one().toRawValue()) {}
+
+public:
+    /// Add the product of two values.
+    ///
+    constexpr void addProduct(Fixed16 a, Fixed16 b) noexcept {
+        _value += static_cast<int64_t>(a.toRawValue()) * b.toRawValue();
+    }
+
+    /// Subtract the product of two values.
+    ///
+    constexpr void subtractProduct(Fixed16 a, Fixed16 b) noexcept {
+        _value -= static_cast<int64_t>(a.toRawValue()) * b.toRawValue();
+    }
+
+    /// Add a value.
+    ///
+    constexpr void add(Fixed16 value) noexcept {
+        _value += static_cast<int64_t>(value.toRawValue()) * Fixed16::one().toRawValue();
+    }
+
+    /// Reset the accumulator to zero.
+    ///
+    constexpr void reset() noexcept {
+        _value = 0;
+    }
+
+    /// Get the accumulated value, rounded to the nearest `Fixed16` value.
+    ///
+    /// @return The value, or `Fixed16::overflow()` if it does not fit.
+    ///
+    constexpr Fixed16 getResult() const noexcept {
+        return Fixed16(Fixed16::roundProduct(_value));
+    }
+
+    /// Get the raw accumulator value, with 32 fraction bits.
+    ///
+    constexpr int64_t getRawValue() const noexcept {
+        return _value;
+    }
+
+private:
+    int64_t _value; ///< The accumulated products, with 32 fraction bits.
+};
+
+
+/// Calculate the dot product of two arrays.
+///
+/// @param a The first array.
+/// @param b The second array.
+/// @param count The number of elements in each array.
+/// @return The sum of all products.
+///
+Fixed16 dotProduct(const Fixed16 *a, const Fixed16 *b, uint16_t count) noexcept;
+
+/// Multiply all values of an array with a factor and add an offset.
+///
+/// Each result is calculated as `input[i] * scale + offset` with a single rounding.
+///
+/// @param input The input values.
+/// @param output The array for the results. This can be the same as `input`.
+/// @param count The number of values.
+/// @param scale The factor for all values.
+/// @param offset The offset added to all values.
+///
+void scaleOffset(const Fixed16 *input, Fixed16 *output, uint16_t count, Fixed16 scale, Fixed16 offset) noexcept;
+
+/// Add the products of two arrays to the values of a third one.
+///
+/// Each result is calculated as `output[i] + a[i] * b[i]` with a single rounding.
+///
+/// @param a The first array.
+/// @param b The second array.
+/// @param output The values to add the products to.
+/// @param count The number of elements in each array.
+///
+void multiplyAccumulate(const Fixed16 *a, const Fixed16 *b, Fixed16 *output, uint16_t count) noexcept;
+
+/// Apply a FIR filter to a block of samples.
+///
+/// The filter calculates `output[i] = sum(coefficients[k] * x[i - k])` for `k` in `[0, tapCount)`.
+/// The input contains `tapCount - 1` samples of history, followed by the `count` new samples. So
+/// `input[tapCount - 1 + i]` is the sample `x[i]`.
+///
+/// @param input The `count + tapCount - 1` input samples, the oldest first.
+/// @param output The array for the `count` filtered samples. It must not overlap the input.
+/// @param count The number of samples to filter.
+/// @param coefficients The filter coefficients.
+/// @param tapCount The number of filter coefficients, at least one.
+///
+void fir(const Fixed16 *input, Fixed16 *output, uint16_t count, const Fixed16 *coefficients, uint16_t tapCount) noexcept;
+
+
+}
+}
+
+
@@ -22,6 +22,7 @@
 
 #undef min
 #undef max
+#include <array>
 #include <cstdint>
 #include <limits>
 
@@ -78,6 +79,103 @@ typedef uint8_t PinNumber;
 const PinNumber cNoPin = std::numeric_limits<PinNumber>::max();
 
 
+/// The type for the values of a pin set.
+///
+/// Bit 0 is the value of the first pin in the set, bit 1 the value of the second pin, and so on.
+///
+typedef uint16_t PinValues;
+
+
+/// A set of pins for batched operations.
+///
+/// The set is defined at compile time, and keeps the order of the pins. Create it with the pins
+/// in the order of the bits in the values:
+///
+/// ```
+/// constexpr GPIO::PinSet cDataBus(10, 11, 12, 13, 14, 15, 16, 17);
+/// GPIO::writePins(cDataBus, 0xa5);
+/// ```
+///
+/// The platform implementation groups all pins which share a port, and accesses each port with
+/// a single set, clear or read register operation. Pins set to `cNoPin` are ignored.
+///
+class PinSet
+{
+public:
+    /// The maximum number of pins in a set.
+    ///
+    constexpr static uint8_t cMaximumSize = std::numeric_limits<PinValues>::digits;
+
+public:
+    /// Create an empty pin set.
+    ///
+    constexpr PinSet() noexcept : _pins(), _size(0) {}
+
+    /// Create a pin set with the given pins.
+    ///
+    /// @param pins The pins of the set, the first one is assigned to bit 0 of the values.
+    ///
+    template<typename... Pins>
+    constexpr explicit PinSet(Pins... pins) noexcept
+        : _pins{static_cast<PinNumber>(pins)...}, _size(sizeof...(Pins))
+    {
+        static_assert(sizeof...(Pins) <= cMaximumSize, "Too many pins for a pin set.");
+    }
+
+public:
+    /// Get the number of pins in the set.
+    ///
+    constexpr uint8_t getSize() const noexcept {
+        return _size;
+    }
+
+    /// Get a pin from the set.
+    ///
+    /// @param index The index of the pin, which is also the bit index in the values.
+    /// @return The pin number.
+    ///
+    constexpr PinNumber getPin(uint8_t index) const noexcept {
+        return _pins[index];
+    }
+
+    /// Get the mask with one bit set for each pin in the set.
+    ///
+    constexpr PinValues getMask() const noexcept {
+        return static_cast<PinValues>((static_cast<uint32_t>(1) << _size) - 1);
+    }
+
+    /// Check if the set contains a pin.
+    ///
+    /// @param pin The pin number to check.
+    /// @return `true` if the pin is part of this set.
+    ///
+    constexpr bool contains(PinNumber pin) const noexcept {
+        for (uint8_t i = 0; i < _size; ++i) {
+            if (_pins[i] == pin) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Get an iterator to the first pin.
+    ///
+    constexpr const PinNumber* begin() const noexcept {
+        return _pins.data();
+    }
+
+    /// Get an iterator after the last pin.
+    ///
+    constexpr const PinNumber* end() const noexcept {
+        return _pins.data() + _size;
+    }
+
+private:
+    std::array<PinNumber, cMaximumSize> _pins; ///< The pins of the set.
+    uint8_t _size; ///< The number of pins in the set.
+};
+
+
 /// Initialize the GPIO layer.
 ///
 /// @return 'Success' if the initialization was successful.
@@ -101,6 +199,35 @@ Status setMode(PinNumber pin, Mode mode, Pull pull = Pull::None);
 ///
 bool getState(PinNumber pin);
 
+/// Configure the pin mode of all pins in a set.
+///
+/// @param pins The set of pins to configure.
+/// @param mode The mode for the pins.
+/// @param pull The mode for the pull up/down resistors.
+/// @return `Success` if the mode could be successfully set for all pins.
+///
+Status setMode(const PinSet &pins, Mode mode, Pull pull = Pull::None);
+
+/// Drive all pins in a set to the given states.
+///
+/// This has the same effect as setting the mode `Mode::High` or `Mode::Low` for each pin,
+/// but all pins sharing a port are changed with one set and one clear register access.
+///
+/// @param pins The set of pins to change.
+/// @param values The values for the pins, a set bit drives the pin high.
+/// @return `Success` if all pins could be changed.
+///
+Status writePins(const PinSet &pins, PinValues values);
+
+/// Read the digital input from all pins in a set.
+///
+/// All pins sharing a port are read with one register access.
+///
+/// @param pins The set of pins to read.
+/// @return The values of the pins, a set bit for a pin in high state.
+///
+PinValues readPins(const PinSet &pins);
+
 
 }
 }
@@ -0,0 +1,174 @@
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#include "MemoryStatistics.hpp"
+
+
+#include "FreeMemory.hpp"
+#include "InterruptLock.hpp"
+#include "StringBuilder.hpp"
+#include "StringWriter.hpp"
+
+#include <cstring>
+#include <limits>
+
+
+namespace lr {
+namespace MemoryStatistics {
+
+
+namespace {
+
+
+uint8_t *gStackLimit = nullptr; ///< The lowest address of the painted stack.
+uint8_t *gStackTop = nullptr; ///< The address after the highest byte of the painted stack.
+HeapStatistics gHeapStatistics = {0, 0, 0, 0, std::numeric_limits<uint32_t>::max(), {}}; ///< The heap statistics.
+
+
+/// Write one line with a label and a number of bytes.
+///
+void MemoryStatistics_writeValue(StringWriter &writer, const char *label, uint32_t value, const char *unit)
+{
+    InlineString<64> line;
+    line.append(label);
+    line.append(": ");
+    line.appendNumber(value);
+    line.append(unit);
+    writer.writeLine(line.getData());
+}
+
+
+}
+
+
+void paintStack(uint8_t *stackLimit, uint8_t *stackTop) noexcept
+{
+    gStackLimit = stackLimit;
+    gStackTop = stackTop;
+    // Never paint the part of the stack which is currently in use.
+    volatile uint8_t marker = 0;
+    auto paintEnd = const_cast<uint8_t*>(&marker);
+    if (paintEnd < stackLimit || paintEnd >= stackTop) {
+        paintEnd = stackTop;
+    } else if (static_cast<uint32_t>(paintEnd - stackLimit) > cStackPaintMargin) {
+        paintEnd -= cStackPaintMargin;
+    } else {
+        paintEnd = stackLimit;
+    }
+    std::memset(stackLimit, cStackPattern, static_cast<std::size_t>(paintEnd - stackLimit));
+}
+
+
+uint32_t getStackSize() noexcept
+{
+    return static_cast<uint32_t>(gStackTop - gStackLimit);
+}
+
+
+uint32_t getUnusedStack() noexcept
+{
+    const uint8_t *position = gStackLimit;
+    while (position < gStackTop && *position == cStackPattern) {
+        ++position;
+    }
+    return static_cast<uint32_t>(position - gStackLimit);
+}
+
+
+uint32_t getMaximumStackUsage() noexcept
+{
+    return getStackSize() - getUnusedStack();
+}
+
+
+#if LR_MEMORY_STATISTICS
+
+void recordAllocation(uint32_t size) noexcept
+{
+    const auto freeMemory = getFreeMemory();
+    InterruptLock lock;
+    gHeapStatistics.currentSize += size;
+    if (gHeapStatistics.currentSize > gHeapStatistics.maximumSize) {
+        gHeapStatistics.maximumSize = gHeapStatistics.currentSize;
+    }
+    gHeapStatistics.allocationCount += 1;
+    gHeapStatistics.bucketCounts[getBucketIndex(size)] += 1;
+    if (freeMemory < gHeapStatistics.lowestFreeMemory) {
+        gHeapStatistics.lowestFreeMemory = freeMemory;
+    }
+}
+
+
+void recordRelease(uint32_t size) noexcept
+{
+    InterruptLock lock;
+    gHeapStatistics.currentSize -= size;
+    gHeapStatistics.releaseCount += 1;
+}
+
+#endif
+
+
+HeapStatistics getHeapStatistics() noexcept
+{
+    InterruptLock lock;
+    return gHeapStatistics;
+}
+
+
+void resetHeapStatistics() noexcept
+{
+    InterruptLock lock;
+    const auto currentSize = gHeapStatistics.currentSize;
+    gHeapStatistics = HeapStatistics();
+    gHeapStatistics.currentSize = currentSize;
+    gHeapStatistics.maximumSize = currentSize;
+    gHeapStatistics.lowestFreeMemory = std::numeric_limits<uint32_t>::max();
+}
+
+
+void writeReport(StringWriter &writer) noexcept
+{
+    MemoryStatistics_writeValue(writer, "Stack size", getStackSize(), " bytes");
+    MemoryStatistics_writeValue(writer, "Stack maximum usage", getMaximumStackUsage(), " bytes");
+    const auto heap = getHeapStatistics();
+    MemoryStatistics_writeValue(writer, "Heap current size", heap.currentSize, " bytes");
+    MemoryStatistics_writeValue(writer, "Heap maximum size", heap.maximumSize, " bytes");
+    MemoryStatistics_writeValue(writer, "Heap allocations", heap.allocationCount, "");
+    MemoryStatistics_writeValue(writer, "Heap releases", heap.releaseCount, "");
+    if (heap.allocationCount > 0) {
+        MemoryStatistics_writeValue(writer, "Lowest free memory", heap.lowestFreeMemory, " bytes");
+    }
+    for (uint8_t i = 0; i < cBucketCount; ++i) {
+        InlineString<64> line;
+        if (i < cBucketCount - 1) {
+            line.append("Allocations up to ");
+            line.appendNumber(getBucketLimit(i));
+        } else {
+            line.append("Allocations above ");
+            line.appendNumber(getBucketLimit(i - 1));
+        }
+        line.append(" bytes: ");
+        line.appendNumber(heap.bucketCounts[i]);
+        writer.writeLine(line.getData());
+    }
+}
+
+
+}
+}
+
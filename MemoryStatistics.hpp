@@ -0,0 +1,185 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+
+#include <cstdint>
+
+
+/// @namespace lr::MemoryStatistics
+/// Instrumentation to measure the memory usage of the firmware.
+///
+/// The stack usage is measured with a watermark. Call `paintStack()` early at boot, to fill the
+/// unused stack with a pattern. Later, `getMaximumStackUsage()` scans the stack for the deepest
+/// changed byte.
+///
+/// The heap usage is recorded for the allocations made by `String` and `RingBuffer`. Recording
+/// is enabled by setting `LR_MEMORY_STATISTICS` to `1` at build time. If it is disabled, the
+/// record functions are empty and the heap statistics stay zero.
+///
+/// Use `writeReport()` to print all values, and tune the buffer sizes from the measured data.
+///
+
+#ifndef LR_MEMORY_STATISTICS
+#define LR_MEMORY_STATISTICS 0
+#endif
+
+
+namespace lr {
+
+
+class StringWriter;
+
+
+namespace MemoryStatistics {
+
+
+/// The number of size buckets for the allocations.
+///
+/// The first bucket counts allocations up to 16 bytes, every following bucket doubles
+/// the limit. The last bucket counts all allocations larger than 1024 bytes.
+///
+constexpr uint8_t cBucketCount = 8;
+
+/// The limit of the first size bucket, in bytes.
+///
+constexpr uint32_t cFirstBucketLimit = 16;
+
+/// The pattern used to paint the stack.
+///
+constexpr uint8_t cStackPattern = 0xa5;
+
+/// The number of bytes below the current stack pointer, which are not painted.
+///
+constexpr uint32_t cStackPaintMargin = 64;
+
+
+/// The recorded heap statistics.
+///
+struct HeapStatistics
+{
+    uint32_t currentSize; ///< The number of currently allocated bytes.
+    uint32_t maximumSize; ///< The maximum number of allocated bytes at any time.
+    uint32_t allocationCount; ///< The number of allocations.
+    uint32_t releaseCount; ///< The number of released allocations.
+    uint32_t lowestFreeMemory; ///< The lowest value of `getFreeMemory()` seen at an allocation.
+    uint32_t bucketCounts[cBucketCount]; ///< The number of allocations for each size bucket.
+};
+
+
+/// Paint the unused stack with a pattern.
+///
+/// Call this function as early as possible at boot. It fills the stack from `stackLimit`
+/// up to the current stack pointer, minus a safety margin of `cStackPaintMargin` bytes.
+///
+/// @param stackLimit The lowest address of the stack.
+/// @param stackTop The address after the highest byte of the stack, where the stack starts.
+///
+void paintStack(uint8_t *stackLimit, uint8_t *stackTop) noexcept;
+
+/// Get the size of the painted stack.
+///
+/// @return The size of the stack in bytes, or zero if `paintStack()` was not called.
+///
+uint32_t getStackSize() noexcept;
+
+/// Get the number of stack bytes which were never used.
+///
+/// This function scans the stack from the limit, until it finds the first changed byte.
+///
+/// @return The number of unused bytes.
+///
+uint32_t getUnusedStack() noexcept;
+
+/// Get the maximum number of stack bytes used since `paintStack()` was called.
+///
+/// @return The maximum stack usage in bytes.
+///
+uint32_t getMaximumStackUsage() noexcept;
+
+/// Get the size limit of a bucket.
+///
+/// @param index The index of the bucket.
+/// @return The maximum allocation size counted in this bucket, or zero for the last bucket
+///     which has no limit.
+///
+constexpr uint32_t getBucketLimit(uint8_t index) noexcept {
+    return (index < cBucketCount - 1) ? (cFirstBucketLimit << index) : 0;
+}
+
+/// Get the index of the bucket for an allocation size.
+///
+/// @param size The size of the allocation.
+/// @return The index of the bucket.
+///
+constexpr uint8_t getBucketIndex(uint32_t size) noexcept {
+    uint8_t index = 0;
+    while (index < cBucketCount - 1 && size > getBucketLimit(index)) {
+        ++index;
+    }
+    return index;
+}
+
+#if LR_MEMORY_STATISTICS
+
+/// Record a new heap allocation.
+///
+/// @param size The size of the allocation in bytes.
+///
+void recordAllocation(uint32_t size) noexcept;
+
+/// Record a released heap allocation.
+///
+/// @param size The size of the allocation in bytes.
+///
+void recordRelease(uint32_t size) noexcept;
+
+#else
+
+inline void recordAllocation(uint32_t) noexcept {}
+inline void recordRelease(uint32_t) noexcept {}
+
+#endif
+
+/// Get the recorded heap statistics.
+///
+/// @return A copy of the current heap statistics.
+///
+HeapStatistics getHeapStatistics() noexcept;
+
+/// Reset the heap statistics.
+///
+/// The counters are set to zero and the maximum size to the current size.
+/// The current size is kept, as the allocations are still in use.
+///
+void resetHeapStatistics() noexcept;
+
+/// Write a report with all statistics.
+///
+/// The report does not allocate any memory from the heap.
+///
+/// @param writer The writer for the report.
+///
+void writeReport(StringWriter &writer) noexcept;
+
+
+}
+}
+
+
@@ -19,14 +19,114 @@
 
 
 #include "IntegerMath.hpp"
+#include "MemoryStatistics.hpp"
 
 #include <cstring>
 #include <cstdlib>
+#include <type_traits>
 
 
 namespace lr {
 
 
+/// A contiguous region of elements in a ring buffer.
+///
+/// @tparam Size The type used for size calculations.
+/// @tparam Element The type for the elements in the buffer.
+///
+template<typename Size, typename Element>
+struct RingBufferSpan
+{
+    /// Find the first element equal to a given one.
+    ///
+    /// For byte elements, the search uses `std::memchr`, which scans a word at a time on most platforms.
+    ///
+    /// @param element The element to search.
+    /// @return The index of the first matching element, or `size` if there is no match.
+    ///
+    inline Size findFirst(Element element) const noexcept {
+        if (size == 0) {
+            // An empty region of a disabled buffer has no data pointer.
+            return size;
+        }
+        if constexpr (sizeof(Element) == 1 && std::is_integral<Element>::value) {
+            const auto match = static_cast<const Element*>(std::memchr(data, static_cast<int>(element), size));
+            return (match != nullptr) ? static_cast<Size>(match - data) : size;
+        } else {
+            for (Size i = 0; i < size; ++i) {
+                if (data[i] == element) {
+                    return i;
+                }
+            }
+            return size;
+        }
+    }
+
+    /// Find the first element equal to a given one, in the first elements of the region.
+    ///
+    /// @param element The element to search.
+    /// @param limit The maximum number of elements to search.
+    /// @return The index of the first matching element, or the number of searched elements if there is no match.
+    ///
+    inline Size findFirst(Element element, Size limit) const noexcept {
+        return RingBufferSpan{data, IntegerMath::min(size, limit)}.findFirst(element);
+    }
+
+    Element *data; ///< The pointer to the first element of the region.
+    Size size; ///< The number of elements in the region.
+};
+
+
+/// The readable elements of a ring buffer, in up to two contiguous regions.
+///
+/// The `second` region is only used if the readable elements wrap around at the end of the buffer.
+///
+/// @tparam Size The type used for size calculations.
+/// @tparam Element The type for the elements in the buffer.
+///
+template<typename Size, typename Element>
+struct RingBufferRegions
+{
+    /// Get the total number of elements in both regions.
+    ///
+    inline Size getSize() const noexcept {
+        return static_cast<Size>(first.size + second.size);
+    }
+
+    /// Find the first element equal to a given one, in both regions.
+    ///
+    /// @param element The element to search.
+    /// @return The index of the first matching element, or `getSize()` if there is no match.
+    ///
+    inline Size findFirst(Element element) const noexcept {
+        const auto index = first.findFirst(element);
+        if (index < first.size) {
+            return index;
+        }
+        return static_cast<Size>(first.size + second.findFirst(element));
+    }
+
+    /// Find the first element equal to a given one, in the first elements of both regions.
+    ///
+    /// Use this method to stop the search early, if only a limited number of elements is read.
+    ///
+    /// @param element The element to search.
+    /// @param limit The maximum number of elements to search.
+    /// @return The index of the first matching element, or `min(limit, getSize())` if there is no match.
+    ///
+    inline Size findFirst(Element element, Size limit) const noexcept {
+        const auto index = first.findFirst(element, limit);
+        if (index < first.size || index >= limit) {
+            return index;
+        }
+        return static_cast<Size>(first.size + second.findFirst(element, static_cast<Size>(limit - first.size)));
+    }
+
+    RingBufferSpan<Size, Element> first; ///< The first region, starting at the read position.
+    RingBufferSpan<Size, Element> second; ///< The second region, starting at the begin of the buffer.
+};
+
+
 /// A simple but universal ring buffer.
 ///
 /// The ring buffer will store maximum `size()` elements and overwrite existing
@@ -50,6 +150,11 @@ class RingBuffer
     // Not yet implemented in GNU compiler:
     //static_assert(std::is_trivially_copyable<Element>::value, "The element has to be trivially copyable.");
     
+public:
+    /// If writing to a full buffer overwrites the oldest elements.
+    ///
+    constexpr static bool cOverwritesOldest = true;
+
 public:
     /// Create a new ring buffer.
     ///
@@ -71,12 +176,16 @@ public:
     {
         if (_size > 0) {
             _data = new Element[size];
+            MemoryStatistics::recordAllocation(static_cast<uint32_t>(sizeof(Element)) * _size);
         }
     }
     
     /// dtor
     ///
     ~RingBuffer() noexcept {
+        if (_data != nullptr) {
+            MemoryStatistics::recordRelease(static_cast<uint32_t>(sizeof(Element)) * _size);
+        }
         delete[] _data;
     }
     
@@ -210,49 +319,78 @@ public:
     /// To see if the end mark could be read, just compare the last
     /// read element in the buffer.
     ///
+    /// The end mark is searched in the first `count` elements, and the
+    /// elements are copied in one bulk operation afterwards.
+    ///
     /// @param elements The buffer for the elements to read.
     /// @param count The maximum number of elements to read into the buffer.
     /// @param endMark The element which marks the end to read.
     /// @return The actual number of elements stored in the buffer.
     ///
     Size readToEnd(Element *elements, Size count, Element endMark) {
-        // Check if no read is possible.
-        if (count == 0 || elements == nullptr || _count == 0) {
-            return 0;
+        const auto regions = peekReadable();
+        const auto index = regions.findFirst(endMark, count);
+        if (index < count && index < regions.getSize()) {
+            count = static_cast<Size>(index + 1);
         }
-        // Limit the number of read elements if we have not enough.
-        if (count > _count) {
-            count = _count;
-        }
-        // Copy the first batch.
-        const auto firstElementsToCopy = IntegerMath::min<Size>(static_cast<Size>(_size - _readPos), count);
-        auto readPtr = (_data + _readPos);
-        for (Size i = 0; i < firstElementsToCopy; ++i) {
-            elements[i] = readPtr[i];
-            if (readPtr[i] == endMark) {
-                count = (i + 1);
-                goto readToEndFinished;
-            }
-        }
-        // Do we need a second batch?
-        if (firstElementsToCopy < count) {
-            elements += firstElementsToCopy;
-            const auto secondElementsToCopy = (count - firstElementsToCopy);
-            for (Size i = 0; i < secondElementsToCopy; ++i) {
-                elements[i] = _data[i];
-                if (_data[i] == endMark) {
-                    count = (firstElementsToCopy + i + 1);
-                    goto readToEndFinished;
-                }
-            }
-        }
-    readToEndFinished:
-        // Advance the positions.
-        IntegerMath::ringIncrement<Size>(_readPos, count, _size);
-        _count -= count;
-        return count;
+        return read(elements, count);
+    }
+
+    /// Find the first element equal to the given one, without consuming any elements.
+    ///
+    /// @param element The element to search.
+    /// @return The index of the first matching element, or `getCount()` if there is no match.
+    ///
+    Size findFirst(Element element) noexcept {
+        return peekReadable().findFirst(element);
     }
     
+    /// Get the readable elements without consuming them.
+    ///
+    /// Use this method to pass the buffered data directly to a driver, without copying it into an
+    /// intermediate buffer. After the data was processed, call `consume()` with the number of
+    /// processed elements.
+    ///
+    /// @return The readable elements in up to two regions.
+    ///
+    RingBufferRegions<Size, Element> peekReadable() noexcept {
+        const auto firstSize = IntegerMath::min<Size>(static_cast<Size>(_size - _readPos), _count);
+        return RingBufferRegions<Size, Element>{
+            {_data + _readPos, firstSize},
+            {_data, static_cast<Size>(_count - firstSize)}};
+    }
+
+    /// Remove elements from the read side of the buffer.
+    ///
+    /// @param count The number of elements to remove. Must be less or equal to `getCount()`.
+    ///
+    void consume(Size count) noexcept {
+        IntegerMath::ringIncrement(_readPos, count, _size);
+        _count -= count;
+    }
+
+    /// Get the contiguous free region at the write position.
+    ///
+    /// Write the new elements directly into this region, and call `commit()` with the number of
+    /// written elements. The region may be smaller than the free space in the buffer, if the free
+    /// space wraps around at the end of the buffer.
+    ///
+    /// @return The writable region, with a size of zero if the buffer is full.
+    ///
+    RingBufferSpan<Size, Element> acquireWritable() noexcept {
+        return RingBufferSpan<Size, Element>{_data + _writePos, IntegerMath::min<Size>(
+            static_cast<Size>(_size - _writePos), static_cast<Size>(_size - _count))};
+    }
+
+    /// Add elements written into the region returned by `acquireWritable()`.
+    ///
+    /// @param count The number of written elements. Must be less or equal to the size of the region.
+    ///
+    void commit(Size count) noexcept {
+        IntegerMath::ringIncrement(_writePos, count, _size);
+        _count += count;
+    }
+
     /// Reset the buffer.
     ///
     void reset() {
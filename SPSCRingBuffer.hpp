@@ -0,0 +1,318 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+
+#include "IntegerMath.hpp"
+#include "RingBuffer.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+
+namespace lr {
+
+
+/// A ring buffer for one producer and one consumer in different contexts.
+///
+/// One side, e.g. an UART receive interrupt, writes elements into the buffer and the other side,
+/// e.g. the main loop, reads them. No interrupt lock is required, as each side only writes its own
+/// position. There is no shared element count, the count is calculated from both positions.
+///
+/// In contrast to `RingBuffer`, this buffer never overwrites existing elements. If the buffer is
+/// full, new elements are rejected, because the producer is not allowed to change the read position.
+///
+/// Producer methods: `write()`, `push()`, `acquireWritable()` and `commit()`.
+/// Consumer methods: `read()`, `pop()`, `readToEnd()`, `peekReadable()`, `consume()` and `reset()`.
+/// All other methods can be called from both sides.
+///
+/// Design Note: As with `event::SubmissionQueue`, the buffer expects exactly one producer and one
+/// consumer. If interrupts with different priorities write to the buffer, you have to protect the
+/// calls in the lower priority interrupt with an `InterruptLock`.
+///
+/// @tparam Element The type for the elements in the buffer. This has to be a scalar type.
+/// @tparam capacity The maximum number of elements in the buffer. Has to be a power of two,
+///     in the range 2-32768, or zero to disable the buffer.
+///
+template<typename Element, uint16_t capacity>
+class SPSCRingBuffer
+{
+    static_assert(capacity == 0 || (capacity >= 2 && capacity <= 0x8000u),
+        "The capacity has to be in the range 2-32768.");
+    static_assert((capacity & (capacity - 1)) == 0, "The capacity has to be a power of two.");
+
+public:
+    /// The type used for size calculations.
+    ///
+    using Size = uint16_t;
+
+    /// A contiguous region of elements in this buffer.
+    ///
+    using Span = RingBufferSpan<Size, Element>;
+
+    /// The readable elements of this buffer.
+    ///
+    using Regions = RingBufferRegions<Size, Element>;
+
+    /// If writing to a full buffer overwrites the oldest elements.
+    ///
+    constexpr static bool cOverwritesOldest = false;
+
+public:
+    /// Create a new empty ring buffer.
+    ///
+    constexpr SPSCRingBuffer() noexcept
+        : _writePosition(0), _readPosition(0), _data() {}
+
+public:
+    /// Check if this buffer is disabled.
+    ///
+    /// @return `true` if the capacity of the buffer is zero.
+    ///
+    constexpr bool isDisabled() const noexcept {
+        return capacity == 0;
+    }
+
+    /// Check if this buffer is enabled.
+    ///
+    /// @return `true` if the capacity of the buffer is non-zero.
+    ///
+    constexpr bool isEnabled() const noexcept {
+        return capacity != 0;
+    }
+
+    /// Get the size of the buffer.
+    ///
+    /// @return The capacity of the buffer.
+    ///
+    constexpr Size getSize() const noexcept {
+        return capacity;
+    }
+
+    /// Get the number of elements in the buffer.
+    ///
+    /// If called from the producer, the actual count may be lower, if called from the consumer,
+    /// the actual count may be higher.
+    ///
+    /// @return The number of elements in the buffer.
+    ///
+    Size getCount() const noexcept {
+        return static_cast<Size>(
+            _writePosition.load(std::memory_order_acquire) - _readPosition.load(std::memory_order_acquire));
+    }
+
+    /// Check if the buffer if empty.
+    ///
+    /// @return `true` if the buffer is empty.
+    ///
+    bool isEmpty() const noexcept {
+        return getCount() == 0;
+    }
+
+    /// Write a single element to the buffer.
+    ///
+    /// @param element The element to write.
+    /// @return `true` if the element was written, `false` if the buffer is full.
+    ///
+    bool push(Element element) noexcept {
+        const auto writePosition = _writePosition.load(std::memory_order_relaxed);
+        const auto readPosition = _readPosition.load(std::memory_order_acquire);
+        if (static_cast<Size>(writePosition - readPosition) >= capacity) {
+            return false;
+        }
+        _data[writePosition & cMask] = element;
+        _writePosition.store(static_cast<Size>(writePosition + 1), std::memory_order_release);
+        return true;
+    }
+
+    /// Write elements to the buffer.
+    ///
+    /// If there is not enough free space in the buffer, only the first elements are written.
+    ///
+    /// @param elements A pointer to the array with elements.
+    /// @param count The number of elements in the array.
+    /// @return The number of elements written to the buffer.
+    ///
+    Size write(const Element *elements, Size count) noexcept {
+        if (count == 0 || elements == nullptr) {
+            return 0;
+        }
+        const auto writePosition = _writePosition.load(std::memory_order_relaxed);
+        const auto readPosition = _readPosition.load(std::memory_order_acquire);
+        count = IntegerMath::min<Size>(count, static_cast<Size>(capacity - (writePosition - readPosition)));
+        copyIn(writePosition & cMask, elements, count);
+        _writePosition.store(static_cast<Size>(writePosition + count), std::memory_order_release);
+        return count;
+    }
+
+    /// Get the contiguous free region at the write position.
+    ///
+    /// See `RingBuffer::acquireWritable()`.
+    ///
+    /// @return The writable region, with a size of zero if the buffer is full.
+    ///
+    Span acquireWritable() noexcept {
+        const auto writePosition = _writePosition.load(std::memory_order_relaxed);
+        const auto readPosition = _readPosition.load(std::memory_order_acquire);
+        const auto index = static_cast<Size>(writePosition & cMask);
+        return Span{_data + index, IntegerMath::min<Size>(
+            static_cast<Size>(capacity - index), static_cast<Size>(capacity - (writePosition - readPosition)))};
+    }
+
+    /// Add elements written into the region returned by `acquireWritable()`.
+    ///
+    /// @param count The number of written elements. Must be less or equal to the size of the region.
+    ///
+    void commit(Size count) noexcept {
+        const auto writePosition = _writePosition.load(std::memory_order_relaxed);
+        _writePosition.store(static_cast<Size>(writePosition + count), std::memory_order_release);
+    }
+
+    /// Read a single element from the buffer.
+    ///
+    /// @param element The variable to store the element.
+    /// @return `true` if an element was read, `false` if the buffer is empty.
+    ///
+    bool pop(Element &element) noexcept {
+        const auto readPosition = _readPosition.load(std::memory_order_relaxed);
+        const auto writePosition = _writePosition.load(std::memory_order_acquire);
+        if (readPosition == writePosition) {
+            return false;
+        }
+        element = _data[readPosition & cMask];
+        _readPosition.store(static_cast<Size>(readPosition + 1), std::memory_order_release);
+        return true;
+    }
+
+    /// Read elements from the buffer.
+    ///
+    /// @param elements The buffer for the elements to read.
+    /// @param count The maximum number of elements to read into the buffer.
+    /// @return The actual number of elements stored in the buffer.
+    ///
+    Size read(Element *elements, Size count) noexcept {
+        if (count == 0 || elements == nullptr) {
+            return 0;
+        }
+        const auto readPosition = _readPosition.load(std::memory_order_relaxed);
+        const auto writePosition = _writePosition.load(std::memory_order_acquire);
+        count = IntegerMath::min<Size>(count, static_cast<Size>(writePosition - readPosition));
+        copyOut(elements, readPosition & cMask, count);
+        _readPosition.store(static_cast<Size>(readPosition + count), std::memory_order_release);
+        return count;
+    }
+
+    /// Read elements from the buffer, up to a given element.
+    ///
+    /// See `RingBuffer::readToEnd()`.
+    ///
+    /// @param elements The buffer for the elements to read.
+    /// @param count The maximum number of elements to read into the buffer.
+    /// @param endMark The element which marks the end to read.
+    /// @return The actual number of elements stored in the buffer.
+    ///
+    Size readToEnd(Element *elements, Size count, Element endMark) noexcept {
+        const auto regions = peekReadable();
+        const auto index = regions.findFirst(endMark, count);
+        if (index < count && index < regions.getSize()) {
+            count = static_cast<Size>(index + 1);
+        }
+        return read(elements, count);
+    }
+
+    /// Find the first element equal to the given one, without consuming any elements.
+    ///
+    /// See `RingBuffer::findFirst()`.
+    ///
+    /// @param element The element to search.
+    /// @return The index of the first matching element, or `getCount()` if there is no match.
+    ///
+    Size findFirst(Element element) noexcept {
+        return peekReadable().findFirst(element);
+    }
+
+    /// Get the readable elements without consuming them.
+    ///
+    /// See `RingBuffer::peekReadable()`.
+    ///
+    /// @return The readable elements in up to two regions.
+    ///
+    Regions peekReadable() noexcept {
+        const auto readPosition = _readPosition.load(std::memory_order_relaxed);
+        const auto writePosition = _writePosition.load(std::memory_order_acquire);
+        const auto index = static_cast<Size>(readPosition & cMask);
+        const auto count = static_cast<Size>(writePosition - readPosition);
+        const auto firstSize = IntegerMath::min<Size>(static_cast<Size>(capacity - index), count);
+        return Regions{{_data + index, firstSize}, {_data, static_cast<Size>(count - firstSize)}};
+    }
+
+    /// Remove elements from the read side of the buffer.
+    ///
+    /// @param count The number of elements to remove. Must be less or equal to `getCount()`.
+    ///
+    void consume(Size count) noexcept {
+        const auto readPosition = _readPosition.load(std::memory_order_relaxed);
+        _readPosition.store(static_cast<Size>(readPosition + count), std::memory_order_release);
+    }
+
+    /// Reset the buffer.
+    ///
+    /// This drops all elements in the buffer. Only call this method from the consumer.
+    ///
+    void reset() noexcept {
+        _readPosition.store(_writePosition.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+private:
+    /// Copy elements into the buffer storage.
+    ///
+    void copyIn(Size index, const Element *elements, Size count) noexcept {
+        const auto firstCount = IntegerMath::min<Size>(static_cast<Size>(capacity - index), count);
+        std::memcpy(_data + index, elements, sizeof(Element)*firstCount);
+        if (firstCount < count) {
+            std::memcpy(_data, elements + firstCount, sizeof(Element)*static_cast<Size>(count - firstCount));
+        }
+    }
+
+    /// Copy elements from the buffer storage.
+    ///
+    void copyOut(Element *elements, Size index, Size count) const noexcept {
+        const auto firstCount = IntegerMath::min<Size>(static_cast<Size>(capacity - index), count);
+        std::memcpy(elements, _data + index, sizeof(Element)*firstCount);
+        if (firstCount < count) {
+            std::memcpy(elements + firstCount, _data, sizeof(Element)*static_cast<Size>(count - firstCount));
+        }
+    }
+
+private:
+    /// The mask for the positions.
+    ///
+    constexpr static Size cMask = static_cast<Size>(capacity - 1);
+
+private:
+    std::atomic<Size> _writePosition; ///< The free running write position, only changed by the producer.
+    std::atomic<Size> _readPosition; ///< The free running read position, only changed by the consumer.
+    Element _data[(capacity > 0) ? capacity : 1]; ///< The actual buffer.
+};
+
+
+}
+
+
@@ -60,6 +60,13 @@ public:
         Partial, ///< Not all data would be sent or received.
         Error, ///< Unspecific error, see API for details.
     };
+
+    /// A contiguous block of data for `sendv()`.
+    ///
+    struct Span {
+        const uint8_t *data; ///< A pointer to the data.
+        DataSize size; ///< The size of the data.
+    };
     
 public: // Output
     /// Get the number of bytes which can be sent.
@@ -93,6 +100,36 @@ public: // Output
         DataSize dataSize,
         DataSize *dataSent = nullptr) noexcept = 0;
     
+    /// Send a number of data blocks to the serial line.
+    ///
+    /// This gathers all blocks into one logical send operation. Implementations which can send larger
+    /// blocks more efficiently, e.g. one USB packet instead of one for each block, should override this
+    /// method. The default implementation calls `send()` for each block, until one is not sent completely.
+    ///
+    /// @param[in] spans A pointer to the array with the data blocks.
+    /// @param[in] spanCount The number of data blocks in the array.
+    /// @param[out] dataSent If this pointer is passed to the function, the
+    ///     total number of actually sent bytes is returned.
+    /// @return `Success`, `Partial` or `Error`.
+    ///
+    virtual Status sendv(
+        const Span *spans,
+        uint8_t spanCount,
+        DataSize *dataSent = nullptr) noexcept
+    {
+        DataSize totalSent = 0;
+        Status status = Status::Success;
+        for (uint8_t i = 0; i < spanCount && status == Status::Success; ++i) {
+            DataSize sent = 0;
+            status = send(spans[i].data, spans[i].size, &sent);
+            totalSent += sent;
+        }
+        if (dataSent != nullptr) {
+            *dataSent = totalSent;
+        }
+        return status;
+    }
+
     /// Reset the send buffer.
     ///
     /// This will reset the send buffer, dropping all data which is waiting
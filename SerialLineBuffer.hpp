@@ -18,8 +18,16 @@
 //
 
 
+#include "AsyncSerialLine.hpp"
+#include "IntegerMath.hpp"
 #include "RingBuffer.hpp"
 #include "SerialLine.hpp"
+#include "SPSCRingBuffer.hpp"
+#include "StaticRingBuffer.hpp"
+#include "Timer.hpp"
+#include "event/Loop.hpp"
+
+#include <limits>
 
 
 namespace lr {
@@ -32,7 +40,10 @@ namespace lr {
 /// the buffer for this direction. In this case, send or receive calls are passed to the underlying serial
 /// interface directly, without any buffering.
 ///
-/// If a buffer is full, the oldest data is overwritten with new one.
+/// If a buffer is full, the oldest data is overwritten with new one. Buffers which do not allow to overwrite
+/// data, like `SPSCRingBuffer`, drop the new data instead. Use `setOverflowPolicy()` to reject new data or
+/// to block until the data was sent. The number of dropped bytes and the high-water marks of the buffers are
+/// recorded in the statistics, see `getStatistics()`.
 ///
 /// This buffer was designed for three specific use cases:
 ///
@@ -52,6 +63,8 @@ namespace lr {
 /// Note this implementation does not implement a proper protection if you mix e.g. `send()` calls from the main
 /// loop and interrupts. Also the `synchronize()` method is not protected and you have to add additional code to
 /// make sure no the interrupt does not occur in the `synchronize()` method.
+/// Use `SPSCSerialLineBuffer` if one interrupt shall call `send()` or `receive()`, while `synchronize()` is
+/// called from the main loop. This variant uses lock-free single-producer/single-consumer ring buffers.
 ///
 /// 3. Caching
 /// ----------
@@ -60,19 +73,55 @@ namespace lr {
 /// `synchronize()` method in the main loop. Depending on the built-in buffer and implementation of of the underlying
 /// serial line (DMA, etc,), this may improve the performance and reduce delays.
 ///
-class SerialLineBuffer : public SerialLine
+/// @tparam SendBufferClass The buffer class for the send direction, e.g. `RingBuffer` or `StaticRingBuffer`.
+/// @tparam ReceiveBufferClass The buffer class for the receive direction.
+///
+template<typename SendBufferClass, typename ReceiveBufferClass>
+class BasicSerialLineBuffer : public SerialLine
 {
 public:
     using BufferSizeType = uint16_t;
 
+    /// The policy if data is written into a full buffer.
+    ///
+    enum class OverflowPolicy : uint8_t {
+        OverwriteOldest, ///< Overwrite the oldest data in the buffer. Buffers which do not support this, reject new data.
+        RejectNew, ///< Reject the new data, send calls return `Partial`.
+        BlockUntilSynchronized, ///< Call `synchronize()` for the send direction until there is enough space.
+    };
+
+    /// The statistics of the buffer.
+    ///
+    struct Statistics {
+        uint32_t droppedSendBytes; ///< The number of sent bytes which were overwritten or rejected.
+        uint32_t droppedReceiveBytes; ///< The number of received bytes which were overwritten.
+        uint32_t synchronizeCount; ///< The number of `synchronize()` calls.
+        BufferSizeType sendHighWaterMark; ///< The maximum number of bytes in the send buffer.
+        BufferSizeType receiveHighWaterMark; ///< The maximum number of bytes in the receive buffer.
+    };
+
 public:
-    /// Create a new serial line buffer.
+    /// Create a new serial line buffer with statically sized buffers.
+    ///
+    /// @param serialLine A pointer to the underlying serial line implementation. Must not be `nullptr`.
+    ///
+    explicit BasicSerialLineBuffer(SerialLine *serialLine) noexcept
+        : _serialLine(serialLine), _sendBuffer(), _receiveBuffer(),
+        _overflowPolicy(OverflowPolicy::OverwriteOldest), _statistics(), _loop(nullptr), _pollHandle(),
+        _eventByteBudget(0), _asyncLine(nullptr), _asyncCompletionFlags(), _sendInFlight(0),
+        _isReceiveInFlight(false) {}
+
+    /// Create a new serial line buffer with dynamically sized buffers.
     ///
     /// @param serialLine A pointer to the underlying serial line implementation. Must not be `nullptr`.
     /// @param sendSize The size of the send buffer. `0` to disable the send buffer.
     /// @param receiveSize The size of the receive buffer, `0` to disable the receive buffer.
     ///
-    SerialLineBuffer(SerialLine *serialLine, BufferSizeType sendSize, BufferSizeType receiveSize);
+    BasicSerialLineBuffer(SerialLine *serialLine, BufferSizeType sendSize, BufferSizeType receiveSize) noexcept
+        : _serialLine(serialLine), _sendBuffer(sendSize), _receiveBuffer(receiveSize),
+        _overflowPolicy(OverflowPolicy::OverwriteOldest), _statistics(), _loop(nullptr), _pollHandle(),
+        _eventByteBudget(0), _asyncLine(nullptr), _asyncCompletionFlags(), _sendInFlight(0),
+        _isReceiveInFlight(false) {}
 
 public:
     /// Synchronise the buffer.
@@ -81,12 +130,117 @@ public:
     /// If a buffer is disabled (by setting it to zero), the calls are made immediately and the disabled direction
     /// is ignored in this method.
     ///
+    /// The data is passed directly between the storage of the ring buffers and the underlying serial line,
+    /// without an intermediate copy.
+    ///
+    /// @return `Success`.
+    ///
     Status synchronize() noexcept;
-    
+
+    /// Synchronise the buffer, with a limit for the transferred bytes.
+    ///
+    /// Use this method to limit the time spent in one call, e.g. if a large backlog is flushed after the
+    /// underlying serial line was connected.
+    ///
+    /// @param byteBudget The maximum number of bytes to send and the maximum number of bytes to receive.
+    /// @return `Success` if all data was synchronised, `Partial` if the budget was exhausted.
+    ///
+    Status synchronize(DataSize byteBudget) noexcept;
+
+    /// Synchronise the buffer, with a limit for the time spent in the call.
+    ///
+    /// The data is transferred in chunks of `cTimeBudgetChunkSize` bytes, until all data was synchronised
+    /// or the time budget is exhausted. A single chunk is not interrupted.
+    ///
+    /// @param timeBudget The maximum time to spend in this call.
+    /// @return `Success` if all data was synchronised, `Partial` if the budget was exhausted.
+    ///
+    Status synchronize(Milliseconds timeBudget) noexcept;
+
+    /// Synchronise the buffer from an event loop.
+    ///
+    /// The buffer adds a repeated event to the loop, which checks for pending data in the given interval.
+    /// As soon there is data to send or receive, a poll event is added which calls `synchronize()` with the
+    /// given byte budget in each pass of the loop. If all data was synchronised, the poll event is removed
+    /// again, so the loop can sleep. Call `requestSynchronize()` after sending data from the main loop, to
+    /// add the poll event without waiting for the next check.
+    ///
+    /// @param loop The event loop to use.
+    /// @param checkInterval The interval to check for pending data.
+    /// @param byteBudget The byte budget for each synchronisation, `0` for no limit.
+    ///
+    void attachToLoop(event::Loop &loop, Milliseconds checkInterval = 10_ms, DataSize byteBudget = 0) noexcept;
+
+    /// Add the poll event to synchronise the buffer, if it is attached to an event loop.
+    ///
+    /// Do not call this method from an interrupt.
+    ///
+    void requestSynchronize() noexcept;
+
+    /// Use asynchronous transfers of the underlying serial line.
+    ///
+    /// In this mode, `synchronize()` starts a background transfer for the first contiguous region of the
+    /// send buffer and another one for the free region of the receive buffer, and returns. If the buffer
+    /// is attached to an event loop, the completion of a transfer signals the given interrupt flags and the
+    /// next transfer is started from the loop. Otherwise, call `synchronize()` regularly.
+    ///
+    /// While a send transfer is active, the send buffer never overwrites data, the overflow policy
+    /// `OverwriteOldest` rejects new data instead. The receive buffer only uses free space.
+    ///
+    /// A reset keeps the memory of an active transfer reserved. `sendReset()` drops the buffered data only
+    /// after the active send transfer is complete, and `receiveReset()` keeps the bytes of the active receive
+    /// transfer.
+    ///
+    /// Call this method before `attachToLoop()`.
+    ///
+    /// @param asyncLine The asynchronous interface of the underlying serial line. This must be the same object
+    ///     which was passed to the constructor.
+    /// @param completionFlags The interrupt flags to signal the completion of a transfer.
+    ///
+    void enableAsyncTransfer(AsyncSerialLine *asyncLine, event::InterruptFlags completionFlags) noexcept;
+
+    /// Check if a complete block was received.
+    ///
+    /// This searches the receive buffer for the block end mark, without consuming any data. Use this method
+    /// to call `receiveBlock()` only if a complete block, e.g. a line, is available.
+    ///
+    /// @param blockEndMark The block end mark.
+    /// @return `true` if the receive buffer contains the block end mark. If the receive buffer is disabled,
+    ///     `true` is returned if any data is available.
+    ///
+    bool hasReceivedBlock(uint8_t blockEndMark) noexcept;
+
+    /// Set the overflow policy.
+    ///
+    /// The policy is used for both directions. In the receive direction, `RejectNew` and
+    /// `BlockUntilSynchronized` leave the data in the underlying serial line until there is space in the buffer.
+    ///
+    /// Only use `BlockUntilSynchronized` if the underlying serial line accepts data eventually, and never if
+    /// `send()` is called from an interrupt. The default is `OverwriteOldest`.
+    ///
+    /// @param overflowPolicy The new overflow policy.
+    ///
+    inline void setOverflowPolicy(OverflowPolicy overflowPolicy) noexcept {
+        _overflowPolicy = overflowPolicy;
+    }
+
+    /// Get the statistics of this buffer.
+    ///
+    inline const Statistics& getStatistics() const noexcept {
+        return _statistics;
+    }
+
+    /// Reset all statistics.
+    ///
+    inline void resetStatistics() noexcept {
+        _statistics = Statistics();
+    }
+
 public: // Implement SerialLine
     DataSize sendBytesAvailable() noexcept override;
     Status send(uint8_t value) noexcept override;
     Status send(const uint8_t *data, DataSize dataSize, DataSize *dataSent = nullptr) noexcept override;
+    Status sendv(const Span *spans, uint8_t spanCount, DataSize *dataSent = nullptr) noexcept override;
     Status sendReset() noexcept override;
     DataSize receiveBytesAvailable() noexcept override;
     Status receive(uint8_t &value) noexcept override;
@@ -94,12 +248,535 @@ public: // Implement SerialLine
     Status receiveBlock(uint8_t *data, DataSize dataSize, uint8_t blockEndMark, DataSize *dataReceived) noexcept override;
     Status receiveReset() noexcept override;
 
+public:
+    /// The number of bytes transferred between the checks of the time budget.
+    ///
+    constexpr static DataSize cTimeBudgetChunkSize = 64;
+
+private:
+    /// Send buffered data to the underlying serial line.
+    ///
+    /// @param byteBudget The maximum number of bytes to send.
+    /// @return `true` if the budget was exhausted.
+    ///
+    bool synchronizeSend(DataSize byteBudget) noexcept;
+
+    /// Receive data from the underlying serial line into the buffer.
+    ///
+    /// @param byteBudget The maximum number of bytes to receive.
+    /// @return `true` if the budget was exhausted.
+    ///
+    bool synchronizeReceive(DataSize byteBudget) noexcept;
+
+    /// Finish the last asynchronous transfers and start new ones.
+    ///
+    void synchronizeAsync() noexcept;
+
+    /// Get the completion signal for asynchronous transfers.
+    ///
+    inline AsyncSerialLine::Completion getCompletion() const noexcept {
+        return AsyncSerialLine::Completion{_loop, _asyncCompletionFlags};
+    }
+
+    /// Check if there is data to send or receive.
+    ///
+    bool hasPendingData() noexcept;
+
+    /// The repeated event to check for pending data.
+    ///
+    void onCheckEvent();
+
+    /// The poll event to synchronise the buffer.
+    ///
+    void onPollEvent();
+
+    /// Check if new data in the send buffer overwrites the oldest data if the buffer is full.
+    ///
+    inline bool isOverwritingSendData() const noexcept {
+        return SendBufferClass::cOverwritesOldest && _overflowPolicy == OverflowPolicy::OverwriteOldest
+            && _asyncLine == nullptr;
+    }
+
+    /// Write data into the send buffer, using the overflow policy.
+    ///
+    /// @return The number of bytes written into the buffer.
+    ///
+    DataSize writeSendData(const uint8_t *data, DataSize dataSize) noexcept;
+
 private:
     SerialLine *_serialLine; ///< The underlying serial line.
-    RingBuffer<BufferSizeType, uint8_t> _sendBuffer; ///< The send buffer.
-    RingBuffer<BufferSizeType, uint8_t> _receiveBuffer; ///< The receive buffer.
+    SendBufferClass _sendBuffer; ///< The send buffer.
+    ReceiveBufferClass _receiveBuffer; ///< The receive buffer.
+    OverflowPolicy _overflowPolicy; ///< The overflow policy.
+    Statistics _statistics; ///< The statistics.
+    event::Loop *_loop; ///< The event loop, if the buffer is attached to a loop.
+    event::Handle _pollHandle; ///< The handle of the poll event, invalid if there is no poll event.
+    DataSize _eventByteBudget; ///< The byte budget for the synchronisation from the event loop.
+    AsyncSerialLine *_asyncLine; ///< The asynchronous interface of the serial line, or `nullptr`.
+    event::InterruptFlags _asyncCompletionFlags; ///< The interrupt flags for the completion of a transfer.
+    DataSize _sendInFlight; ///< The number of bytes to consume after the active send transfer.
+    bool _isReceiveInFlight; ///< If a receive transfer is active.
+};
+
+
+/// The serial line buffer with buffers allocated on the heap.
+///
+/// The buffer sizes are passed to the constructor.
+///
+class SerialLineBuffer
+    : public BasicSerialLineBuffer<RingBuffer<uint16_t, uint8_t>, RingBuffer<uint16_t, uint8_t>>
+{
+public:
+    /// Create a new serial line buffer.
+    ///
+    /// @param serialLine A pointer to the underlying serial line implementation. Must not be `nullptr`.
+    /// @param sendSize The size of the send buffer. `0` to disable the send buffer.
+    /// @param receiveSize The size of the receive buffer, `0` to disable the receive buffer.
+    ///
+    SerialLineBuffer(SerialLine *serialLine, BufferSizeType sendSize, BufferSizeType receiveSize);
 };
 
 
+/// The serial line buffer with inline buffers, which do not use the heap.
+///
+/// Use power-of-two sizes for the fastest index calculations.
+///
+/// @tparam sendSize The size of the send buffer. `0` to disable the send buffer.
+/// @tparam receiveSize The size of the receive buffer, `0` to disable the receive buffer.
+///
+template<uint16_t sendSize, uint16_t receiveSize>
+using StaticSerialLineBuffer = BasicSerialLineBuffer<
+    StaticRingBuffer<uint8_t, sendSize>, StaticRingBuffer<uint8_t, receiveSize>>;
+
+
+/// The serial line buffer with lock-free buffers, to send or receive data from one interrupt.
+///
+/// Each buffer has one producer and one consumer. For the send buffer, `send()` is the producer and
+/// `synchronize()` the consumer. For the receive buffer, `synchronize()` is the producer and `receive()`
+/// the consumer. If a buffer is full, new data is dropped.
+///
+/// @tparam sendSize The size of the send buffer. A power of two or `0` to disable the send buffer.
+/// @tparam receiveSize The size of the receive buffer. A power of two or `0` to disable the receive buffer.
+///
+template<uint16_t sendSize, uint16_t receiveSize>
+using SPSCSerialLineBuffer = BasicSerialLineBuffer<
+    SPSCRingBuffer<uint8_t, sendSize>, SPSCRingBuffer<uint8_t, receiveSize>>;
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+SerialLine::Status BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::synchronize() noexcept
+{
+    synchronize(std::numeric_limits<DataSize>::max());
+    return Status::Success;
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+SerialLine::Status BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::synchronize(DataSize byteBudget) noexcept
+{
+    ++_statistics.synchronizeCount;
+    if (_asyncLine != nullptr) {
+        synchronizeAsync();
+        return Status::Success;
+    }
+    bool isBudgetExhausted = false;
+    if (_sendBuffer.isEnabled()) {
+        isBudgetExhausted = synchronizeSend(byteBudget);
+    }
+    if (_receiveBuffer.isEnabled()) {
+        isBudgetExhausted |= synchronizeReceive(byteBudget);
+    }
+    return isBudgetExhausted ? Status::Partial : Status::Success;
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+SerialLine::Status BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::synchronize(Milliseconds timeBudget) noexcept
+{
+    const auto startTime = Timer::tickMilliseconds();
+    while (synchronize(cTimeBudgetChunkSize) == Status::Partial) {
+        if (startTime.deltaTo(Timer::tickMilliseconds()) >= static_cast<Milliseconds::TickDelta>(timeBudget.ticks())) {
+            return Status::Partial;
+        }
+    }
+    return Status::Success;
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+void BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::attachToLoop(event::Loop &loop, Milliseconds checkInterval, DataSize byteBudget) noexcept
+{
+    _loop = &loop;
+    _eventByteBudget = (byteBudget > 0) ? byteBudget : std::numeric_limits<DataSize>::max();
+    loop.addRepeatedEvent(event::Call::member<BasicSerialLineBuffer, &BasicSerialLineBuffer::onCheckEvent>(*this),
+        checkInterval, event::Priority::Normal, event::RepeatPolicy::Skip);
+    if (_asyncLine != nullptr) {
+        loop.addInterruptEvent(event::Call::member<BasicSerialLineBuffer, &BasicSerialLineBuffer::onCheckEvent>(*this),
+            _asyncCompletionFlags, true, event::Priority::Normal);
+    }
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+void BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::enableAsyncTransfer(AsyncSerialLine *asyncLine, event::InterruptFlags completionFlags) noexcept
+{
+    if (static_cast<SerialLine*>(asyncLine) != _serialLine) {
+        return;
+    }
+    _asyncLine = asyncLine;
+    _asyncCompletionFlags = completionFlags;
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+void BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::requestSynchronize() noexcept
+{
+    if (_loop != nullptr && !_pollHandle.isValid()) {
+        _pollHandle = _loop->addPollEvent(
+            event::Call::member<BasicSerialLineBuffer, &BasicSerialLineBuffer::onPollEvent>(*this),
+            true, event::Priority::Normal);
+    }
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+bool BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::hasPendingData() noexcept
+{
+    if (_asyncLine != nullptr) {
+        // Only report data which can be transferred now, the completion interrupt reports the rest.
+        return (_sendBuffer.isEnabled() && !_asyncLine->isSendAsyncActive() && !_sendBuffer.isEmpty())
+            || (_receiveBuffer.isEnabled() && !_asyncLine->isReceiveAsyncActive()
+                && (_isReceiveInFlight || _receiveBuffer.getCount() < _receiveBuffer.getSize()));
+    }
+    return (_sendBuffer.isEnabled() && !_sendBuffer.isEmpty() && _serialLine->sendBytesAvailable() > 0)
+        || (_receiveBuffer.isEnabled() && _serialLine->receiveBytesAvailable() > 0);
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+void BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::onCheckEvent()
+{
+    if (hasPendingData()) {
+        requestSynchronize();
+    }
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+void BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::onPollEvent()
+{
+    if (synchronize(_eventByteBudget) == Status::Success && !hasPendingData()) {
+        _loop->cancel(_pollHandle);
+        _pollHandle = event::Handle();
+    }
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+void BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::synchronizeAsync() noexcept
+{
+    if (_sendBuffer.isEnabled() && !_asyncLine->isSendAsyncActive()) {
+        _sendBuffer.consume(_sendInFlight);
+        _sendInFlight = 0;
+        const auto region = _sendBuffer.peekReadable().first;
+        if (region.size > 0 && _asyncLine->sendAsync(region.data, region.size, getCompletion()) == Status::Success) {
+            _sendInFlight = region.size;
+        }
+    }
+    if (_receiveBuffer.isEnabled() && !_asyncLine->isReceiveAsyncActive()) {
+        if (_isReceiveInFlight) {
+            _receiveBuffer.commit(_asyncLine->getReceivedAsyncSize());
+            _isReceiveInFlight = false;
+            _statistics.receiveHighWaterMark = IntegerMath::max(
+                _statistics.receiveHighWaterMark, _receiveBuffer.getCount());
+        }
+        const auto region = _receiveBuffer.acquireWritable();
+        if (region.size > 0 && _asyncLine->receiveAsync(region.data, region.size, getCompletion()) == Status::Success) {
+            _isReceiveInFlight = true;
+        }
+    }
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+bool BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::synchronizeSend(DataSize byteBudget) noexcept
+{
+    const auto bytesAvailable = IntegerMath::min(_serialLine->sendBytesAvailable(), _sendBuffer.getCount());
+    auto bytesToSend = IntegerMath::min(bytesAvailable, byteBudget);
+    while (bytesToSend > 0) {
+        // Send directly from the ring buffer storage, at most the contiguous first region.
+        const auto region = _sendBuffer.peekReadable().first;
+        DataSize sentBytes = 0;
+        _serialLine->send(region.data, IntegerMath::min(bytesToSend, region.size), &sentBytes);
+        if (sentBytes == 0) {
+            break;
+        }
+        _sendBuffer.consume(sentBytes);
+        bytesToSend -= sentBytes;
+    }
+    return bytesAvailable > byteBudget;
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+bool BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::synchronizeReceive(DataSize byteBudget) noexcept
+{
+    const auto bytesAvailable = _serialLine->receiveBytesAvailable();
+    auto bytesToReceive = IntegerMath::min(bytesAvailable, byteBudget);
+    while (bytesToReceive > 0) {
+        auto region = _receiveBuffer.acquireWritable();
+        if (region.size == 0) {
+            if (!ReceiveBufferClass::cOverwritesOldest || _overflowPolicy != OverflowPolicy::OverwriteOldest) {
+                break;
+            }
+            // The buffer is full, drop the oldest data to make room for the new one.
+            const auto droppedBytes = IntegerMath::min(bytesToReceive, _receiveBuffer.getCount());
+            _receiveBuffer.consume(droppedBytes);
+            _statistics.droppedReceiveBytes += droppedBytes;
+            region = _receiveBuffer.acquireWritable();
+        }
+        // Receive directly into the ring buffer storage.
+        DataSize receivedBytes = 0;
+        _serialLine->receive(region.data, IntegerMath::min(bytesToReceive, region.size), &receivedBytes);
+        if (receivedBytes == 0) {
+            break;
+        }
+        _receiveBuffer.commit(receivedBytes);
+        bytesToReceive -= receivedBytes;
+    }
+    _statistics.receiveHighWaterMark = IntegerMath::max(_statistics.receiveHighWaterMark, _receiveBuffer.getCount());
+    return bytesAvailable > byteBudget;
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+SerialLine::DataSize BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::writeSendData(const uint8_t *data, DataSize dataSize) noexcept
+{
+    const auto freeBytes = static_cast<DataSize>(_sendBuffer.getSize() - _sendBuffer.getCount());
+    DataSize writtenBytes = dataSize;
+    if (isOverwritingSendData()) {
+        if (dataSize > freeBytes) {
+            _statistics.droppedSendBytes += (dataSize - freeBytes);
+        }
+        _sendBuffer.write(data, dataSize);
+    } else if (_overflowPolicy == OverflowPolicy::BlockUntilSynchronized) {
+        auto bytesToWrite = dataSize;
+        auto bytesToCopy = IntegerMath::min(bytesToWrite, freeBytes);
+        while (true) {
+            _sendBuffer.write(data, bytesToCopy);
+            data += bytesToCopy;
+            bytesToWrite -= bytesToCopy;
+            if (bytesToWrite == 0) {
+                break;
+            }
+            if (_asyncLine != nullptr) {
+                synchronizeAsync();
+            } else {
+                synchronizeSend(std::numeric_limits<DataSize>::max());
+            }
+            bytesToCopy = IntegerMath::min(bytesToWrite,
+                static_cast<DataSize>(_sendBuffer.getSize() - _sendBuffer.getCount()));
+        }
+    } else {
+        writtenBytes = IntegerMath::min(dataSize, freeBytes);
+        _sendBuffer.write(data, writtenBytes);
+        _statistics.droppedSendBytes += (dataSize - writtenBytes);
+    }
+    _statistics.sendHighWaterMark = IntegerMath::max(_statistics.sendHighWaterMark, _sendBuffer.getCount());
+    return writtenBytes;
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+bool BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::hasReceivedBlock(uint8_t blockEndMark) noexcept
+{
+    if (_receiveBuffer.isDisabled()) {
+        return _serialLine->receiveBytesAvailable() > 0;
+    }
+    const auto regions = _receiveBuffer.peekReadable();
+    return regions.findFirst(blockEndMark) < regions.getSize();
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+SerialLine::DataSize BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::sendBytesAvailable() noexcept
+{
+    if (_sendBuffer.isDisabled()) {
+        return _serialLine->sendBytesAvailable();
+    }
+    if (isOverwritingSendData()) {
+        return std::numeric_limits<DataSize>::max();
+    }
+    return static_cast<DataSize>(_sendBuffer.getSize() - _sendBuffer.getCount());
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+SerialLine::Status BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::send(uint8_t value) noexcept
+{
+    if (_sendBuffer.isDisabled()) {
+        return _serialLine->send(value);
+    }
+    if (writeSendData(&value, 1) == 0) {
+        return Status::Partial;
+    }
+    return Status::Success;
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+SerialLine::Status
+BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::send(const uint8_t *data, DataSize dataSize, DataSize *dataSent) noexcept
+{
+    if (_sendBuffer.isDisabled()) {
+        return _serialLine->send(data, dataSize, dataSent);
+    }
+    const auto writtenBytes = writeSendData(data, dataSize);
+    if (dataSent != nullptr) {
+        *dataSent = writtenBytes;
+    }
+    if (writtenBytes < dataSize) {
+        return Status::Partial;
+    }
+    return Status::Success;
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+SerialLine::Status
+BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::sendv(const Span *spans, uint8_t spanCount, DataSize *dataSent) noexcept
+{
+    if (_sendBuffer.isDisabled()) {
+        return _serialLine->sendv(spans, spanCount, dataSent);
+    }
+    DataSize totalWritten = 0;
+    Status status = Status::Success;
+    for (uint8_t i = 0; i < spanCount; ++i) {
+        const auto writtenBytes = writeSendData(spans[i].data, spans[i].size);
+        totalWritten += writtenBytes;
+        if (writtenBytes < spans[i].size) {
+            status = Status::Partial;
+            break;
+        }
+    }
+    if (dataSent != nullptr) {
+        *dataSent = totalWritten;
+    }
+    return status;
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+SerialLine::Status BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::sendReset() noexcept
+{
+    if (_sendBuffer.isDisabled()) {
+        return _serialLine->sendReset();
+    }
+    if (_sendInFlight > 0 && _asyncLine->isSendAsyncActive()) {
+        // The active transfer still reads from the buffer, drop the data after its completion.
+        _sendInFlight = _sendBuffer.getCount();
+    } else {
+        _sendBuffer.reset();
+        _sendInFlight = 0;
+    }
+    _serialLine->sendReset();
+    return Status::Success;
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+SerialLine::DataSize BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::receiveBytesAvailable() noexcept
+{
+    if (_receiveBuffer.isDisabled()) {
+        return _serialLine->receiveBytesAvailable();
+    }
+    return _receiveBuffer.getCount();
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+SerialLine::Status BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::receive(uint8_t &value) noexcept
+{
+    if (_receiveBuffer.isDisabled()) {
+        return _serialLine->receive(value);
+    }
+    if (_receiveBuffer.isEmpty()) {
+        return Status::Partial;
+    }
+    _receiveBuffer.read(&value, 1);
+    return Status::Success;
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+SerialLine::Status
+BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::receive(uint8_t *data, DataSize dataSize, DataSize *dataReceived) noexcept
+{
+    if (_receiveBuffer.isDisabled()) {
+        return _serialLine->receive(data, dataSize, dataReceived);
+    }
+    const auto bytesToRead = IntegerMath::min(dataSize, _receiveBuffer.getCount());
+    if (bytesToRead > 0) {
+        _receiveBuffer.read(data, bytesToRead);
+    }
+    if (dataReceived != nullptr) {
+        *dataReceived = bytesToRead;
+    }
+    if (bytesToRead < dataSize) {
+        return Status::Partial;
+    } else {
+        return Status::Success;
+    }
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+SerialLine::Status BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::receiveBlock(
+    uint8_t *data,
+    DataSize dataSize,
+    uint8_t blockEndMark,
+    DataSize *dataReceived) noexcept
+{
+    if (_receiveBuffer.isDisabled()) {
+        return _serialLine->receiveBlock(data, dataSize, blockEndMark, dataReceived);
+    }
+    const auto regions = _receiveBuffer.peekReadable();
+    const auto count = regions.getSize();
+    const auto endIndex = regions.findFirst(blockEndMark, dataSize);
+    const bool isBlockComplete = (endIndex < dataSize && endIndex < count);
+    const auto bytesToRead = isBlockComplete ? static_cast<DataSize>(endIndex + 1) : IntegerMath::min(dataSize, count);
+    if (bytesToRead > 0) {
+        _receiveBuffer.read(data, bytesToRead);
+    }
+    if (dataReceived != nullptr) {
+        *dataReceived = bytesToRead;
+    }
+    if (isBlockComplete) {
+        return Status::Success;
+    } else {
+        return Status::Partial;
+    }
+}
+
+
+template<typename SendBufferClass, typename ReceiveBufferClass>
+SerialLine::Status BasicSerialLineBuffer<SendBufferClass, ReceiveBufferClass>::receiveReset() noexcept
+{
+    if (_receiveBuffer.isDisabled()) {
+        return _serialLine->receiveReset();
+    }
+    if (_isReceiveInFlight && _asyncLine->isReceiveAsyncActive()) {
+        // The active transfer still writes into the buffer, only drop the data received so far.
+        _receiveBuffer.consume(_receiveBuffer.getCount());
+    } else {
+        _receiveBuffer.reset();
+        _isReceiveInFlight = false;
+    }
+    _serialLine->receiveReset();
+    return Status::Success;
+}
+
+
+
 }
 
@@ -18,6 +18,9 @@
 #include "SerialLineShell.hpp"
 
 
+#include "ShellCommandRegistry.hpp"
+
+#include <algorithm>
 #include <cstring>
 #include <cstdlib>
 
@@ -27,6 +30,7 @@ namespace lr {
 
 namespace {
 const char *cCSI = "\x1b[";
+const char cLineEnd[] = {'\r', '\n'};
 }
 
 
@@ -40,11 +44,17 @@ SerialLineShell::SerialLineShell(lr::SerialLine *serialLine, const uint8_t lineB
     _inputMode(InputMode::LineEdit),
     _prompt(),
     _lineFn(nullptr),
+    _lineViewFn(nullptr),
+    _commandRegistry(nullptr),
     _lineExpansionFn(nullptr),
     _keyFn(nullptr),
     _sendPrompt(true),
     _escapeDeadline(10_ms),
-    _escapeState(EscapeState::None)
+    _escapeState(EscapeState::None),
+    _frameDepth(0),
+    _cursorMove(0),
+    _echoLength(0),
+    _echoBuffer()
 {
     _lineBuffer = static_cast<char*>(malloc(lineBufferSize+1));
     std::memset(_lineBuffer, 0, lineBufferSize+1);
@@ -59,6 +69,7 @@ SerialLineShell::~SerialLineShell()
 
 void SerialLineShell::pollEvent()
 {
+    beginFrame();
     if (_sendPrompt && isPromptMode()) {
         write(_prompt);
         _sendPrompt = false;
@@ -67,16 +78,148 @@ void SerialLineShell::pollEvent()
         _escapeState = EscapeState::None;
         handleInput(static_cast<char>(Key::Escape));
     }
-    uint8_t readByte;
-    while (isSuccessful(_writer.serialLine()->receive(readByte))) {
-        const Key key = handleEscape(readByte);
-        if (key != Key::None) {
-            readByte = static_cast<char>(key);
+    uint8_t input[cReceiveBlockSize];
+    SerialLine::DataSize inputSize = cReceiveBlockSize;
+    while (inputSize == cReceiveBlockSize) {
+        inputSize = 0;
+        if (_writer.serialLine()->receive(input, cReceiveBlockSize, &inputSize) == SerialLine::Status::Error) {
+            break;
         }
-        if (_escapeState == EscapeState::None) {
-            handleInput(static_cast<char>(readByte));
+        for (SerialLine::DataSize i = 0; i < inputSize; ++i) {
+            uint8_t readByte = input[i];
+            const Key key = handleEscape(readByte);
+            if (key != Key::None) {
+                readByte = static_cast<char>(key);
+            }
+            if (_escapeState == EscapeState::None) {
+                handleInput(static_cast<char>(readByte));
+            }
+        }
+    }
+    endFrame();
+}
+
+
+void SerialLineShell::beginFrame()
+{
+    _frameDepth += 1;
+}
+
+
+void SerialLineShell::endFrame()
+{
+    if (_frameDepth == 0) {
+        return;
+    }
+    if (_frameDepth == 1) {
+        flushEcho();
+    }
+    _frameDepth -= 1;
+}
+
+
+void SerialLineShell::writeOutput(const char *text, uint16_t length)
+{
+    if (_cursorMove != 0) {
+        writeCursorMove();
+    }
+    if (_frameDepth == 0) {
+        _writer.write(text, length);
+        return;
+    }
+    if (length > cEchoBufferSize - _echoLength) {
+        flushEcho();
+        if (length > cEchoBufferSize) {
+            _writer.write(text, length);
+            return;
         }
     }
+    std::memcpy(_echoBuffer + _echoLength, text, length);
+    _echoLength += length;
+}
+
+
+void SerialLineShell::flushEcho()
+{
+    if (_cursorMove != 0) {
+        writeCursorMove();
+    }
+    if (_echoLength > 0) {
+        _writer.write(_echoBuffer, _echoLength);
+        _echoLength = 0;
+    }
+}
+
+
+StringWriter::Status SerialLineShell::write(const String &text)
+{
+    if (_frameDepth == 0) {
+        return _writer.write(text);
+    }
+    writeOutput(text.getData(), text.getLength());
+    return Status::Success;
+}
+
+
+StringWriter::Status SerialLineShell::write(char c, uint8_t count)
+{
+    if (_frameDepth == 0) {
+        return _writer.write(c, count);
+    }
+    for (uint8_t i = 0; i < count; ++i) {
+        writeOutput(&c, 1);
+    }
+    return Status::Success;
+}
+
+
+StringWriter::Status SerialLineShell::write(const char *text)
+{
+    if (_frameDepth == 0) {
+        return _writer.write(text);
+    }
+    writeOutput(text, static_cast<uint16_t>(std::strlen(text)));
+    return Status::Success;
+}
+
+
+StringWriter::Status SerialLineShell::write(const char *text, uint16_t length)
+{
+    if (_frameDepth == 0) {
+        return _writer.write(text, length);
+    }
+    writeOutput(text, length);
+    return Status::Success;
+}
+
+
+StringWriter::Status SerialLineShell::writeLine(const String &text)
+{
+    if (_frameDepth == 0) {
+        return _writer.writeLine(text);
+    }
+    write(text);
+    return writeLine();
+}
+
+
+StringWriter::Status SerialLineShell::writeLine(const char *text)
+{
+    if (_frameDepth == 0) {
+        return _writer.writeLine(text);
+    }
+    write(text);
+    return writeLine();
+}
+
+
+StringWriter::Status SerialLineShell::writeLine()
+{
+    if (_frameDepth == 0) {
+        return _writer.writeLine();
+    }
+    writeOutput(cLineEnd, sizeof(cLineEnd));
+    return Status::Success;
 }
 
 
@@ -136,6 +279,7 @@ void SerialLineShell::handleInput(char c)
     switch (_inputMode) {
     case InputMode::Keys:
         if (_keyFn != nullptr) {
+            flushEcho();
             _keyFn(c);
         }
         break;
@@ -221,8 +365,18 @@ void SerialLineShell::handleLineEdit(char c)
             break;
         case Key::Return:
             writeLine();
+            // Hidden lines, like passwords, are never executed, as the registry echoes unknown commands.
+            if (_commandRegistry != nullptr && _inputMode == InputMode::LineEdit && _lineLength > 0) {
+                flushEcho();
+                _commandRegistry->execute(StringView(_lineBuffer, _lineLength), *this);
+            }
+            if (_lineViewFn != nullptr && _lineLength > 0) {
+                flushEcho();
+                _lineViewFn(StringView(_lineBuffer, _lineLength));
+            }
             if (_lineFn != nullptr && _lineLength > 0) {
                 const String line(_lineBuffer, _lineLength);
+                flushEcho();
                 _lineFn(line);
             }
             _lineLength = 0;
@@ -231,12 +385,15 @@ void SerialLineShell::handleLineEdit(char c)
             break;
         case Key::Tab:
         case Key::Escape:
-            if (_lineExpansionFn != nullptr) {
+            if (_lineExpansionFn != nullptr || (_commandRegistry != nullptr && _inputMode == InputMode::LineEdit)) {
                 uint8_t cursorPosition = _lineCursorPosition;
                 String line(_lineBuffer, _lineLength);
-                const auto lineExpansion = _lineExpansionFn(line, cursorPosition);
+                flushEcho();
+                const auto lineExpansion = (_lineExpansionFn != nullptr)
+                    ? _lineExpansionFn(line, cursorPosition)
+                    : _commandRegistry->expandLine(line, cursorPosition, *this);
                 if (lineExpansion != LineExpansion::Failed) {
-                    _lineLength = line.getLength();
+                    _lineLength = static_cast<uint8_t>(std::min<String::Size>(line.getLength(), _lineBufferMaximumSize));
                     std::memcpy(_lineBuffer, line.getData(), _lineLength);
                     _lineCursorPosition = cursorPosition;
                     if (_lineCursorPosition > _lineLength) {
@@ -252,7 +409,7 @@ void SerialLineShell::handleLineEdit(char c)
                     writeCursorHorizontalAbsolute(0);
                 case LineExpansion::NewPrompt:
                     write(_prompt);
-                    write(line);
+                    write(_lineBuffer, _lineLength);
                     writeCursorHorizontalAbsolute(_lineCursorPosition + _prompt.getLength());
                     break;
                 }
@@ -268,14 +425,11 @@ void SerialLineShell::handleLineEdit(char c)
 
 void SerialLineShell::updateEndOfLine()
 {
+    // Rewrite the end of the line and move back, which combines with following cursor moves.
     const uint8_t endCount = _lineLength - _lineCursorPosition;
-    writeSaveCursorPosition();
-    if (endCount > 0) {
-        const auto endData = reinterpret_cast<uint8_t*>(_lineBuffer + _lineCursorPosition);
-        _writer.serialLine()->send(endData, endCount);
-    }
+    writeOutput(_lineBuffer + _lineCursorPosition, endCount);
     write(' ', 1);
-    writeRestoreCursorPosition();
+    moveCursor(-static_cast<int16_t>(endCount + 1));
 }
 
 
@@ -302,6 +456,18 @@ void SerialLineShell::setLineFn(LineFn lineFn)
 }
 
 
+void SerialLineShell::setLineViewFn(LineViewFn lineViewFn)
+{
+    _lineViewFn = lineViewFn;
+}
+
+
+void SerialLineShell::setCommandRegistry(const ShellCommandRegistry *registry)
+{
+    _commandRegistry = registry;
+}
+
+
 void SerialLineShell::setLineExpansionFn(LineExpansionFn lineExpansionFn)
 {
     _lineExpansionFn = lineExpansionFn;
@@ -316,35 +482,58 @@ void SerialLineShell::setKeysFn(KeysFn keysFn)
 
 void SerialLineShell::writeCSI(char command)
 {
-    String text(cCSI);
-    text.append(command);
-    write(text);
+    char text[cMaximumCSISize];
+    const auto size = formatCSI(text, command, 0, 0, false);
+    writeOutput(text, size);
 }
 
 
 void SerialLineShell::writeCSI(char command, uint8_t x)
 {
-    String text(cCSI);
-    if (x > 0) {
-        text.appendNumber(x);
-    }
-    text.append(command);
-    write(text);
+    char text[cMaximumCSISize];
+    const auto size = formatCSI(text, command, x, 0, false);
+    writeOutput(text, size);
 }
 
 
 void SerialLineShell::writeCSI(char command, uint8_t x, uint8_t y)
 {
-    String text(cCSI);
-    if (x > 0) {
-        text.appendNumber(x);
+    char text[cMaximumCSISize];
+    const auto size = formatCSI(text, command, x, y, true);
+    writeOutput(text, size);
+}
+
+
+uint8_t SerialLineShell::formatCSI(char *text, char command, uint8_t x, uint8_t y, bool hasY)
+{
+    uint8_t size = 0;
+    text[size++] = cCSI[0];
+    text[size++] = cCSI[1];
+    size += formatNumber(text + size, x);
+    if (hasY) {
+        text[size++] = ';';
+        size += formatNumber(text + size, y);
     }
-    text.append(';');
-    if (y > 0) {
-        text.appendNumber(y);
+    text[size++] = command;
+    return size;
+}
+
+
+uint8_t SerialLineShell::formatNumber(char *text, uint8_t value)
+{
+    // Zero is omitted, as it is the default value for all parameters.
+    if (value == 0) {
+        return 0;
     }
-    text.append(command);
-    write(text);
+    uint8_t size = 0;
+    if (value >= 100) {
+        text[size++] = static_cast<char>('0' + value / 100);
+    }
+    if (value >= 10) {
+        text[size++] = static_cast<char>('0' + (value / 10) % 10);
+    }
+    text[size++] = static_cast<char>('0' + value % 10);
+    return size;
 }
 
 
@@ -368,24 +557,27 @@ void SerialLineShell::writeCursorDown(uint8_t count)
 
 void SerialLineShell::writeCursorForward(uint8_t count)
 {
-    writeCSI('C', count);
+    moveCursor((count > 0) ? count : 1);
 }
 
 
 void SerialLineShell::writeCursorBack(uint8_t count)
 {
-    writeCSI('D', count);
+    moveCursor(-static_cast<int16_t>((count > 0) ? count : 1));
 }
 
 
 void SerialLineShell::writeCursorHorizontalAbsolute(uint8_t column)
 {
+    // An absolute position makes any pending relative move redundant.
+    _cursorMove = 0;
     writeCSI('G', column+1);
 }
 
 
 void SerialLineShell::writeCursorPosition(uint8_t row, uint8_t column)
 {
+    _cursorMove = 0;
     writeCSI('H', row+1, column+1);
 }
 
@@ -410,8 +602,32 @@ void SerialLineShell::writeSaveCursorPosition()
 
 void SerialLineShell::writeRestoreCursorPosition()
 {
+    _cursorMove = 0;
     writeCSI('u');
 }
 
 
+void SerialLineShell::moveCursor(int16_t delta)
+{
+    if (_frameDepth == 0) {
+        writeCSI((delta > 0) ? 'C' : 'D', static_cast<uint8_t>((delta > 0) ? delta : -delta));
+        return;
+    }
+    _cursorMove += delta;
+}
+
+
+void SerialLineShell::writeCursorMove()
+{
+    const char command = (_cursorMove > 0) ? 'C' : 'D';
+    int16_t count = (_cursorMove > 0) ? _cursorMove : static_cast<int16_t>(-_cursorMove);
+    _cursorMove = 0;
+    while (count > 0) {
+        const auto step = static_cast<uint8_t>((count > 0xff) ? 0xff : count);
+        writeCSI(command, step);
+        count -= step;
+    }
+}
+
+
 }
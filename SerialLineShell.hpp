@@ -28,6 +28,9 @@
 namespace lr {
 
 
+class ShellCommandRegistry;
+
+
 /// A serial line shell implementation.
 ///
 /// This class implements the base for a shell based serial line interface. It automatically
@@ -38,6 +41,12 @@ namespace lr {
 /// To use this class, you have to call the `pollEvent()` from your event loop. To respond to user input,
 /// you can poll the `readLine()` method or register a callback.
 ///
+/// Input is read in blocks from the serial line. Each `pollEvent()` renders one frame: the echo and all other
+/// output generated while the input is processed are collected in a small buffer and sent with one call,
+/// before any callback is called and at the end of the poll. Relative cursor moves within a frame are
+/// combined into a single sequence, so redundant moves are never sent. Use `beginFrame()` and `endFrame()`
+/// to render your own output the same way.
+///
 class SerialLineShell : public StringWriter
 {
 public:
@@ -81,6 +90,14 @@ public:
     ///
     using LineFn = void(*)(const String&);
 
+    /// Callback for a complete line, as view into the line buffer.
+    ///
+    /// The view is only valid while the callback is running.
+    ///
+    /// @param 1 The view to the complete line.
+    ///
+    using LineViewFn = void(*)(StringView);
+
     /// Callback for a single key in `Keys` mode.
     ///
     /// Known escape sequences are converted to the values in the `Key` enumeration.
@@ -132,6 +149,25 @@ public:
     ///
     void setLineFn(LineFn lineFn);
 
+    /// Set a callback for every new line, which gets a view to the line buffer.
+    ///
+    /// This callback is called in the same situations as the one set with `setLineFn()`, but the line
+    /// is not copied. Use it with a `StringViewTokenizer` to parse commands without any allocation.
+    /// If both callbacks are set, this one is called first.
+    ///
+    void setLineViewFn(LineViewFn lineViewFn);
+
+    /// Set a command registry to execute each line.
+    ///
+    /// If a registry is set, every line is executed as command, without copying the line. The output and
+    /// error messages of the command are written to this shell. If no line expansion callback is set, the
+    /// tab key completes the command names from the registry. Lines entered in `InputMode::HiddenEdit`
+    /// are not executed, they are only passed to the line callbacks.
+    ///
+    /// @param registry The command registry, or `nullptr` to remove the registry.
+    ///
+    void setCommandRegistry(const ShellCommandRegistry *registry);
+
     /// Set a callback for a line expansion.
     ///
     /// If this callback is set, it is called if the user presses the tab key in line edit mode.
@@ -145,6 +181,17 @@ public:
     ///
     void setKeysFn(KeysFn keysFn);
 
+    /// Begin a render frame.
+    ///
+    /// All output until the matching `endFrame()` is collected and sent in as few calls as possible.
+    /// Frames can be nested, the output is sent at the end of the outermost frame.
+    ///
+    void beginFrame();
+
+    /// End a render frame and send the collected output.
+    ///
+    void endFrame();
+
     /// Send a bell signal.
     ///
     void writeBell();
@@ -202,24 +249,13 @@ public:
     void writeCSI(char command, uint8_t x, uint8_t y);
 
 public: // Implement StringWriter by wrapping the SerialLineStringWriter.
-    inline Status write(const String &text) override {
-        return _writer.write(text);
-    }
-    inline Status write(char c, uint8_t count) override {
-        return _writer.write(c, count);
-    }
-    inline Status write(const char *text) override {
-        return _writer.write(text);
-    }
-    inline Status writeLine(const String &text) override {
-        return _writer.writeLine(text);
-    }
-    inline Status writeLine(const char *text) override {
-        return _writer.writeLine(text);
-    }
-    inline Status writeLine() override {
-        return _writer.writeLine();
-    }
+    Status write(const String &text) override;
+    Status write(char c, uint8_t count) override;
+    Status write(const char *text) override;
+    Status write(const char *text, uint16_t length) override;
+    Status writeLine(const String &text) override;
+    Status writeLine(const char *text) override;
+    Status writeLine() override;
 
 private:
     /// Handle character input.
@@ -252,6 +288,57 @@ private:
     ///
     void updateEndOfLine();
 
+    /// Format a CSI sequence.
+    ///
+    /// @param text The buffer for the sequence, with a size of at least `cMaximumCSISize`.
+    /// @param command The command character.
+    /// @param x The first parameter, omitted if zero.
+    /// @param y The second parameter, omitted if zero.
+    /// @param hasY If the sequence has a second parameter.
+    /// @return The size of the sequence.
+    ///
+    static uint8_t formatCSI(char *text, char command, uint8_t x, uint8_t y, bool hasY);
+
+    /// Format a parameter of a CSI sequence.
+    ///
+    /// @return The number of written characters, zero if the value is zero.
+    ///
+    static uint8_t formatNumber(char *text, uint8_t value);
+
+    /// Write output, collecting it in the echo buffer while input is processed.
+    ///
+    /// @param text A pointer to the characters to write.
+    /// @param length The number of characters to write.
+    ///
+    void writeOutput(const char *text, uint16_t length);
+
+    /// Write all collected output from the echo buffer to the serial line.
+    ///
+    void flushEcho();
+
+    /// Move the cursor horizontally, combining the move with other moves in the current frame.
+    ///
+    /// @param delta The number of columns to move, positive values move forward.
+    ///
+    void moveCursor(int16_t delta);
+
+    /// Write the combined cursor move of the current frame.
+    ///
+    void writeCursorMove();
+
+private:
+    /// The maximum size of a CSI sequence with two parameters.
+    ///
+    constexpr static uint8_t cMaximumCSISize = 10;
+
+    /// The number of bytes read from the serial line with one call.
+    ///
+    constexpr static uint8_t cReceiveBlockSize = 32;
+
+    /// The size of the buffer to collect the echo and other output while input is processed.
+    ///
+    constexpr static uint8_t cEchoBufferSize = 64;
+
 private:
     /// Escape sequence state.
     ///
@@ -270,11 +357,17 @@ private:
     InputMode  _inputMode; ///< The current input mode.
     String _prompt; ///< The current prompt.
     LineFn _lineFn; ///< The callback for each line.
+    LineViewFn _lineViewFn; ///< The callback for each line, as view.
+    const ShellCommandRegistry *_commandRegistry; ///< The registry to execute commands.
     LineExpansionFn _lineExpansionFn; ///< The function for a line expansion.
     KeysFn _keyFn; ///< The callback for each keypress.
     bool _sendPrompt; ///< If a prompt has to be sent.
     Timer::Deadline _escapeDeadline; ///< A timer wait for an escape sequence.
     EscapeState _escapeState; ///< The escape state.
+    uint8_t _frameDepth; ///< The nesting depth of render frames. Output is collected if not zero.
+    int16_t _cursorMove; ///< The combined horizontal cursor move, not sent yet.
+    uint8_t _echoLength; ///< The number of characters in the echo buffer.
+    char _echoBuffer[cEchoBufferSize]; ///< The buffer to collect output while input is processed.
 };
 
 
@@ -19,11 +19,20 @@
 
 
 #include "SerialLine.hpp"
+#include "IntegerMath.hpp"
+
+#include <cstring>
 
 
 namespace lr {
 
 
+namespace {
+const uint8_t cLineEnd[] = {'\r', '\n'};
+const uint8_t cRepeatBlockSize = 32;
+}
+
+
 SerialLineStringWriter::SerialLineStringWriter(SerialLine *serialLine)
     : _serialLine(serialLine)
 {
@@ -46,25 +55,26 @@ StringWriter::Status SerialLineStringWriter::write(const String &text)
 
 StringWriter::Status SerialLineStringWriter::write(char c, uint8_t count)
 {
-    for (uint8_t i = 0; i < count; ++i) {
-        const auto result = _serialLine->send(static_cast<uint8_t>(c));
-        if (result == SerialLine::Status::Error) {
-            return Status::Error;
-        }
+    if (count == 0) {
+        return Status::Success;
     }
-    return Status::Success;
+    // Send all characters as one block, using one span for each part of the repeat block.
+    uint8_t block[cRepeatBlockSize];
+    std::memset(block, c, IntegerMath::min(count, cRepeatBlockSize));
+    SerialLine::Span spans[(0xffu + cRepeatBlockSize - 1) / cRepeatBlockSize];
+    uint8_t spanCount = 0;
+    while (count > 0) {
+        const auto size = IntegerMath::min(count, cRepeatBlockSize);
+        spans[spanCount++] = SerialLine::Span{block, size};
+        count -= size;
+    }
+    return sendSpans(spans, spanCount);
 }
 
 
 StringWriter::Status SerialLineStringWriter::write(const char *text)
 {
-    uint8_t textSize = 0;
-    for (uint8_t i = 0; i < 0xffu; ++i) {
-        if (text[i] == '\0') {
-            textSize = i;
-            break;
-        }
-    }
+    const auto textSize = getTextLength(text);
     if (textSize > 0) {
         const auto result = _serialLine->send(reinterpret_cast<const uint8_t*>(text), textSize);
         if (result == SerialLine::Status::Error) {
@@ -75,37 +85,49 @@ StringWriter::Status SerialLineStringWriter::write(const char *text)
 }
 
 
-StringWriter::Status SerialLineStringWriter::writeLine(const String &text)
+StringWriter::Status SerialLineStringWriter::write(const char *text, uint16_t length)
 {
-    if (hasError(write(text))) {
-        return Status::Error;
-    }
-    if (hasError(writeLine())) {
-        return Status::Error;
+    if (length > 0) {
+        const auto result = _serialLine->send(reinterpret_cast<const uint8_t*>(text), length);
+        if (result == SerialLine::Status::Error) {
+            return Status::Error;
+        }
     }
     return Status::Success;
 }
 
 
+StringWriter::Status SerialLineStringWriter::writeLine(const String &text)
+{
+    const SerialLine::Span spans[] = {
+        {reinterpret_cast<const uint8_t*>(text.getData()), text.getLength()},
+        {cLineEnd, sizeof(cLineEnd)}};
+    return sendSpans(spans, 2);
+}
+
+
 StringWriter::Status SerialLineStringWriter::writeLine(const char *text)
 {
-    if (hasError(write(text))) {
-        return Status::Error;
-    }
-    if (hasError(writeLine())) {
-        return Status::Error;
-    }
-    return Status::Success;
+    const SerialLine::Span spans[] = {
+        {reinterpret_cast<const uint8_t*>(text), getTextLength(text)},
+        {cLineEnd, sizeof(cLineEnd)}};
+    return sendSpans(spans, 2);
 }
 
 
 StringWriter::Status SerialLineStringWriter::writeLine()
 {
-    auto result = _serialLine->send('\r');
+    const auto result = _serialLine->send(cLineEnd, sizeof(cLineEnd));
     if (result == SerialLine::Status::Error) {
         return Status::Error;
     }
-    result = _serialLine->send('\n');
+    return Status::Success;
+}
+
+
+StringWriter::Status SerialLineStringWriter::sendSpans(const SerialLine::Span *spans, uint8_t spanCount)
+{
+    const auto result = _serialLine->sendv(spans, spanCount);
     if (result == SerialLine::Status::Error) {
         return Status::Error;
     }
@@ -113,5 +135,18 @@ StringWriter::Status SerialLineStringWriter::writeLine()
 }
 
 
+uint8_t SerialLineStringWriter::getTextLength(const char *text)
+{
+    uint8_t textSize = 0;
+    for (uint8_t i = 0; i < 0xffu; ++i) {
+        if (text[i] == '\0') {
+            textSize = i;
+            break;
+        }
+    }
+    return textSize;
+}
+
+
 }
 
@@ -49,10 +49,26 @@ public: // Implement StringWriter
     Status write(const String &text) override;
     Status write(char c, uint8_t count) override;
     Status write(const char *text) override;
+    Status write(const char *text, uint16_t length) override;
     Status writeLine(const String &text) override;
     Status writeLine(const char *text) override;
     Status writeLine() override;
 
+public:
+    /// Send a number of data blocks with one call to the serial line.
+    ///
+    /// @param spans A pointer to the array with the data blocks.
+    /// @param spanCount The number of data blocks in the array.
+    /// @return `Success` or `Error`. Like with all other write calls, data which does not fit
+    ///     into the buffer of the serial line is silently discarded.
+    ///
+    Status sendSpans(const SerialLine::Span *spans, uint8_t spanCount);
+
+private:
+    /// Get the length of a null terminated string, which is limited to 254 characters.
+    ///
+    static uint8_t getTextLength(const char *text);
+
 private:
     SerialLine *_serialLine; ///< The used serial line.
 };
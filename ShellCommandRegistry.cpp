@@ -0,0 +1,276 @@
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#include "ShellCommandRegistry.hpp"
+
+
+#include "String.hpp"
+#include "StringViewTokenizer.hpp"
+
+
+namespace lr {
+
+
+ShellArguments::ShellArguments() noexcept
+    : _command(), _values(), _numbers(), _count(0)
+{
+}
+
+
+StringView ShellArguments::get(uint8_t index) const noexcept
+{
+    if (index >= _count) {
+        return StringView();
+    }
+    return _values[index];
+}
+
+
+int32_t ShellArguments::getInt32(uint8_t index) const noexcept
+{
+    if (index >= _count) {
+        return 0;
+    }
+    return _numbers[index].i;
+}
+
+
+uint32_t ShellArguments::getUInt32(uint8_t index) const noexcept
+{
+    if (index >= _count) {
+        return 0;
+    }
+    return _numbers[index].u;
+}
+
+
+namespace {
+
+
+/// Write a view to the output.
+///
+inline void ShellCommandRegistry_write(StringWriter &output, StringView text) noexcept
+{
+    output.write(text.getData(), text.getLength());
+}
+
+
+/// Write the usage of a command, based on the argument specification.
+///
+void ShellCommandRegistry_writeUsage(StringWriter &output, const ShellCommand &command) noexcept
+{
+    output.write("Usage: ");
+    output.write(command.name);
+    bool isOptional = false;
+    if (command.arguments != nullptr) {
+        for (const char *type = command.arguments; *type != '\0'; ++type) {
+            switch (*type) {
+            case '?':
+                isOptional = true;
+                continue;
+            case 'i':
+                output.write(isOptional ? " [int]" : " <int>");
+                break;
+            case 'u':
+                output.write(isOptional ? " [uint]" : " <uint>");
+                break;
+            case '*':
+                output.write(" [...]");
+                break;
+            default:
+                output.write(isOptional ? " [word]" : " <word>");
+                break;
+            }
+        }
+    }
+    output.writeLine();
+}
+
+
+}
+
+
+ShellCommandRegistry::Result ShellCommandRegistry::execute(StringView line, StringWriter &output) const noexcept
+{
+    StringViewTokenizer tokenizer(line, ' ');
+    const auto name = tokenizer.getNextToken();
+    if (name.isEmpty()) {
+        return Result::Empty;
+    }
+    const auto command = find(name);
+    if (command == nullptr) {
+        output.write("Unknown command: ");
+        ShellCommandRegistry_write(output, name);
+        output.writeLine();
+        return Result::UnknownCommand;
+    }
+    ShellArguments arguments;
+    arguments._command = name;
+    if (!parseArguments(command->arguments, tokenizer.getTail(), arguments)) {
+        ShellCommandRegistry_writeUsage(output, *command);
+        return Result::InvalidArguments;
+    }
+    command->handler(output, arguments);
+    return Result::Success;
+}
+
+
+const ShellCommand* ShellCommandRegistry::find(StringView name) const noexcept
+{
+    const auto index = getFirstIndex(name);
+    if (index < _count && SortTools::compareStrings(_commands[index].name, name) == 0) {
+        return &_commands[index];
+    }
+    return nullptr;
+}
+
+
+void ShellCommandRegistry::writeHelp(StringWriter &output) const noexcept
+{
+    StringView::Size nameWidth = 0;
+    for (uint8_t i = 0; i < _count; ++i) {
+        const StringView name(_commands[i].name);
+        if (name.getLength() > nameWidth) {
+            nameWidth = name.getLength();
+        }
+    }
+    for (uint8_t i = 0; i < _count; ++i) {
+        const auto &command = _commands[i];
+        const StringView name(command.name);
+        ShellCommandRegistry_write(output, name);
+        if (command.help != nullptr) {
+            output.write(' ', static_cast<uint8_t>(nameWidth - name.getLength() + 2));
+            output.write(command.help);
+        }
+        output.writeLine();
+    }
+}
+
+
+SerialLineShell::LineExpansion ShellCommandRegistry::expandLine(
+    String &line, uint8_t &cursorPosition, StringWriter &output) const noexcept
+{
+    using LineExpansion = SerialLineShell::LineExpansion;
+    // Only the command name at the end of the line is expanded.
+    const StringView prefix(line);
+    if (cursorPosition != prefix.getLength() || prefix.getFirstIndex(' ') != StringView::notFound) {
+        return LineExpansion::Failed;
+    }
+    const auto firstIndex = getFirstIndex(prefix);
+    uint8_t lastIndex = firstIndex;
+    while (lastIndex < _count && SortTools::startsWith(_commands[lastIndex].name, prefix)) {
+        ++lastIndex;
+    }
+    if (lastIndex == firstIndex) {
+        return LineExpansion::Failed;
+    }
+    const char *firstName = _commands[firstIndex].name;
+    if (lastIndex - firstIndex == 1) {
+        line = firstName;
+        line.append(' ');
+        cursorPosition = static_cast<uint8_t>(line.getLength());
+        return LineExpansion::Inline;
+    }
+    // As the names are sorted, the common part of the first and the last match is common to all.
+    const char *lastName = _commands[lastIndex - 1].name;
+    StringView::Size commonLength = prefix.getLength();
+    while (firstName[commonLength] != '\0' && firstName[commonLength] == lastName[commonLength]) {
+        ++commonLength;
+    }
+    if (commonLength > prefix.getLength()) {
+        line = String(firstName, commonLength);
+        cursorPosition = static_cast<uint8_t>(commonLength);
+        return LineExpansion::Inline;
+    }
+    output.writeLine();
+    for (uint8_t i = firstIndex; i < lastIndex; ++i) {
+        output.write(_commands[i].name);
+        output.write(' ');
+    }
+    output.writeLine();
+    return LineExpansion::NewPrompt;
+}
+
+
+bool ShellCommandRegistry::parseArguments(const char *specification, StringView tail, ShellArguments &arguments) noexcept
+{
+    StringViewTokenizer tokenizer(tail, ' ');
+    bool isOptional = false;
+    uint8_t index = 0;
+    for (const char *type = (specification != nullptr) ? specification : ""; *type != '\0'; ++type) {
+        if (*type == '?') {
+            isOptional = true;
+            continue;
+        }
+        if (*type == '*') {
+            // Accept all remaining words.
+            auto token = tokenizer.getNextToken();
+            while (!token.isEmpty()) {
+                if (index >= ShellArguments::cMaximumCount) {
+                    return false;
+                }
+                arguments._values[index] = token;
+                ++index;
+                token = tokenizer.getNextToken();
+            }
+            break;
+        }
+        const auto token = tokenizer.getNextToken();
+        if (token.isEmpty()) {
+            if (!isOptional) {
+                return false;
+            }
+            break;
+        }
+        if (index >= ShellArguments::cMaximumCount) {
+            return false;
+        }
+        if (*type == 'i') {
+            const auto result = token.toInt32();
+            if (result.hasError()) {
+                return false;
+            }
+            arguments._numbers[index].i = result.getValue();
+        } else if (*type == 'u') {
+            const auto result = token.toUInt32();
+            if (result.hasError()) {
+                return false;
+            }
+            arguments._numbers[index].u = result.getValue();
+        }
+        arguments._values[index] = token;
+        ++index;
+    }
+    // There must be no additional arguments.
+    if (!tokenizer.getNextToken().isEmpty()) {
+        return false;
+    }
+    arguments._count = index;
+    return true;
+}
+
+
+uint8_t ShellCommandRegistry::getFirstIndex(StringView prefix) const noexcept
+{
+    return static_cast<uint8_t>(SortTools::lowerBound(_commands, _count, [&prefix](const ShellCommand &command) {
+        return SortTools::compareStrings(command.name, prefix) < 0;
+    }));
+}
+
+
+}
+
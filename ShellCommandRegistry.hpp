@@ -0,0 +1,273 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+
+#include "SerialLineShell.hpp"
+#include "SortTools.hpp"
+#include "StringView.hpp"
+#include "StringWriter.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace lr {
+
+
+/// The parsed arguments of a shell command.
+///
+/// All arguments are views into the line buffer of the shell, so they are only valid while
+/// the command handler is running. Numeric arguments are already parsed and checked.
+///
+class ShellArguments
+{
+public:
+    /// The maximum number of arguments for a command.
+    ///
+    constexpr static uint8_t cMaximumCount = 8;
+
+public:
+    /// Create empty arguments.
+    ///
+    ShellArguments() noexcept;
+
+public:
+    /// Get the name of the command.
+    ///
+    inline StringView getCommand() const noexcept {
+        return _command;
+    }
+
+    /// Get the number of arguments, without the command.
+    ///
+    inline uint8_t getCount() const noexcept {
+        return _count;
+    }
+
+    /// Get an argument as a view.
+    ///
+    /// @param index The index of the argument, starting with zero for the first argument after the command.
+    /// @return The view to the argument, or an empty view if there is no such argument.
+    ///
+    StringView get(uint8_t index) const noexcept;
+
+    /// Get a numeric argument.
+    ///
+    /// @param index The index of the argument, which has to be specified as `i` argument.
+    /// @return The parsed value, or zero if there is no such argument.
+    ///
+    int32_t getInt32(uint8_t index) const noexcept;
+
+    /// Get a numeric argument.
+    ///
+    /// @param index The index of the argument, which has to be specified as `u` argument.
+    /// @return The parsed value, or zero if there is no such argument.
+    ///
+    uint32_t getUInt32(uint8_t index) const noexcept;
+
+private:
+    friend class ShellCommandRegistry;
+
+    /// A parsed number.
+    ///
+    union Number {
+        int32_t i; ///< A signed number.
+        uint32_t u; ///< An unsigned number.
+    };
+
+private:
+    StringView _command; ///< The command name.
+    StringView _values[cMaximumCount]; ///< The views to all arguments.
+    Number _numbers[cMaximumCount]; ///< The parsed numbers, for numeric arguments.
+    uint8_t _count; ///< The number of arguments.
+};
+
+
+/// A single command for the shell.
+///
+/// The argument specification is a string with one character per argument:
+/// - `s`: A word, accessed as view.
+/// - `i`: A signed 32-bit integer.
+/// - `u`: An unsigned 32-bit integer.
+/// - `?`: All following arguments are optional.
+/// - `*`: Any number of additional words, up to `ShellArguments::cMaximumCount`. Has to be the last character.
+///
+/// Integers accept decimal numbers and the `0x` and `0b` prefixes. An empty specification or `nullptr`
+/// means the command has no arguments.
+///
+struct ShellCommand {
+    /// The handler for a command.
+    ///
+    /// @param 1 The writer for the output of the command.
+    /// @param 2 The parsed arguments.
+    ///
+    using Handler = void(*)(StringWriter&, const ShellArguments&);
+
+    const char *name; ///< The name of the command.
+    Handler handler; ///< The handler for the command.
+    const char *arguments; ///< The argument specification.
+    const char *help; ///< A short help text, or `nullptr`.
+};
+
+
+/// A table of shell commands, sorted at compile time.
+///
+/// Declare the table `constexpr` to sort it by the compiler and keep it in flash memory.
+///
+/// **Usage:**
+/// ```
+/// constexpr ShellCommandTable<2> cCommands({{
+///     {"set", &onSet, "su", "Set a value."},
+///     {"get", &onGet, "s", "Get a value."},
+/// }});
+/// const ShellCommandRegistry gRegistry(cCommands);
+/// shell.setCommandRegistry(&gRegistry);
+/// ```
+///
+/// @tparam commandCount The number of commands in the table.
+///
+template<std::size_t commandCount>
+class ShellCommandTable
+{
+    static_assert(commandCount > 0 && commandCount < 0x100u, "The table needs 1-255 commands.");
+
+public:
+    /// The array with all commands.
+    ///
+    using Commands = std::array<ShellCommand, commandCount>;
+
+public:
+    /// Create a new command table.
+    ///
+    /// @param commands The commands, in any order.
+    ///
+    constexpr explicit ShellCommandTable(const Commands &commands) noexcept
+        : _commands(commands)
+    {
+        SortTools::insertionSort(_commands, [](const ShellCommand &a, const ShellCommand &b) {
+            return SortTools::compareStrings(a.name, b.name) < 0;
+        });
+    }
+
+public:
+    /// Access the sorted commands.
+    ///
+    constexpr const ShellCommand* getCommands() const noexcept {
+        return _commands.data();
+    }
+
+    /// Get the number of commands.
+    ///
+    constexpr static uint8_t getCount() noexcept {
+        return static_cast<uint8_t>(commandCount);
+    }
+
+private:
+    Commands _commands; ///< The commands, sorted by name.
+};
+
+
+/// A registry to dispatch command lines to their handlers.
+///
+/// The registry splits a line into words, looks up the command with a binary search in the sorted table
+/// and parses the arguments as specified. No memory is allocated for any of these steps. The same table is
+/// used for the tab completion of command names.
+///
+class ShellCommandRegistry
+{
+public:
+    /// The result of executing a line.
+    ///
+    enum class Result : uint8_t {
+        Success, ///< The command was executed.
+        Empty, ///< The line was empty.
+        UnknownCommand, ///< There is no command with this name.
+        InvalidArguments, ///< The arguments do not match the specification.
+    };
+
+public:
+    /// Create a registry for the given table.
+    ///
+    /// @param table The sorted table with the commands.
+    ///
+    template<std::size_t commandCount>
+    constexpr explicit ShellCommandRegistry(const ShellCommandTable<commandCount> &table) noexcept
+        : _commands(table.getCommands()), _count(table.getCount())
+    {
+    }
+
+public:
+    /// Execute a command line.
+    ///
+    /// If the command is unknown or the arguments are invalid, an error is written to the output.
+    ///
+    /// @param line The command line.
+    /// @param output The writer for the output of the command and errors.
+    /// @return The result of the execution.
+    ///
+    Result execute(StringView line, StringWriter &output) const noexcept;
+
+    /// Find a command by its name.
+    ///
+    /// @param name The name of the command.
+    /// @return A pointer to the command, or `nullptr` if there is no such command.
+    ///
+    const ShellCommand* find(StringView name) const noexcept;
+
+    /// Write a list with all commands and their help text.
+    ///
+    /// @param output The writer for the list.
+    ///
+    void writeHelp(StringWriter &output) const noexcept;
+
+    /// Expand the command name of a line.
+    ///
+    /// This method can be used as line expansion for the shell. If the name is unique, it is completed.
+    /// If there are multiple matches, the common part is completed, or if this is not possible,
+    /// all matching commands are written to the output.
+    ///
+    /// @param line The current line, which is modified if the name is completed.
+    /// @param cursorPosition The current cursor position, which is modified if the name is completed.
+    /// @param output The writer to list multiple matches.
+    /// @return The line expansion result.
+    ///
+    SerialLineShell::LineExpansion expandLine(String &line, uint8_t &cursorPosition, StringWriter &output) const noexcept;
+
+private:
+    /// Parse the arguments for a command.
+    ///
+    /// @return `true` if the arguments match the specification.
+    ///
+    static bool parseArguments(const char *specification, StringView tail, ShellArguments &arguments) noexcept;
+
+    /// Get the index of the first command which is not less than the given prefix.
+    ///
+    uint8_t getFirstIndex(StringView prefix) const noexcept;
+
+private:
+    const ShellCommand *_commands; ///< The sorted commands.
+    uint8_t _count; ///< The number of commands.
+};
+
+
+}
+
+
@@ -0,0 +1,134 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+
+#include "StringView.hpp"
+
+#include <cstddef>
+
+
+/// @namespace lr::SortTools
+///
+/// Small sort and search tools for tables, which work in constant expressions.
+///
+/// These tools are used to sort static tables at compile time, so they can be placed in flash
+/// memory and searched with a binary search at runtime.
+///
+
+namespace lr {
+namespace SortTools {
+
+
+/// Compare two zero terminated strings, like `strcmp`.
+///
+/// @return A negative value, zero or a positive value.
+///
+constexpr int compareStrings(const char *a, const char *b) noexcept
+{
+    std::size_t i = 0;
+    while (a[i] != '\0' && a[i] == b[i]) {
+        ++i;
+    }
+    const auto ca = static_cast<unsigned char>(a[i]);
+    const auto cb = static_cast<unsigned char>(b[i]);
+    return (ca < cb) ? -1 : ((ca > cb) ? 1 : 0);
+}
+
+
+/// Compare a zero terminated string with a view, like `strcmp`.
+///
+/// @return A negative value, zero or a positive value.
+///
+constexpr int compareStrings(const char *a, const StringView &b) noexcept
+{
+    for (StringView::Size i = 0; i < b.getLength(); ++i) {
+        const auto ca = static_cast<unsigned char>(a[i]);
+        const auto cb = static_cast<unsigned char>(b.getCharAt(i));
+        if (ca != cb) {
+            return (ca < cb) ? -1 : 1;
+        }
+    }
+    return (a[b.getLength()] == '\0') ? 0 : 1;
+}
+
+
+/// Check if a zero terminated string starts with the characters of a view.
+///
+constexpr bool startsWith(const char *str, const StringView &prefix) noexcept
+{
+    for (StringView::Size i = 0; i < prefix.getLength(); ++i) {
+        if (str[i] != prefix.getCharAt(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/// Sort an array, using a stable insertion sort.
+///
+/// This sort is only suitable for small tables, but works in constant expressions.
+///
+/// @param elements The array to sort.
+/// @param isLess The function to compare two elements.
+///
+template<typename Array, typename IsLess>
+constexpr void insertionSort(Array &elements, IsLess isLess) noexcept
+{
+    for (std::size_t i = 1; i < elements.size(); ++i) {
+        const auto element = elements[i];
+        std::size_t j = i;
+        while (j > 0 && isLess(element, elements[j - 1])) {
+            elements[j] = elements[j - 1];
+            --j;
+        }
+        elements[j] = element;
+    }
+}
+
+
+/// Find the first element which is not less than a key, in a sorted array.
+///
+/// @param elements A pointer to the sorted elements.
+/// @param count The number of elements.
+/// @param isLess A function which returns `true` if the given element is less than the key.
+/// @return The index of the first element not less than the key, or `count`.
+///
+template<typename Element, typename IsLess>
+constexpr std::size_t lowerBound(const Element *elements, std::size_t count, IsLess isLess) noexcept
+{
+    std::size_t low = 0;
+    std::size_t high = count;
+    while (low < high) {
+        const std::size_t middle = low + (high - low) / 2;
+        if (isLess(elements[middle])) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+
+}
+}
+
+
@@ -0,0 +1,283 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+
+#include "IntegerMath.hpp"
+#include "RingBuffer.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+
+namespace lr {
+
+
+/// A ring buffer with a fixed capacity and inline storage.
+///
+/// This ring buffer provides the same interface and behaviour as `RingBuffer`, but the storage is part
+/// of the object, so no memory is allocated from the heap. Declare the buffer as a static or global
+/// variable to place it in the data segment.
+///
+/// If the capacity is a power of two, positions are wrapped using a single mask operation. For all
+/// other capacities, one compare is required for each wrap.
+///
+/// A capacity of zero "disables" the buffer, in the same way as a `RingBuffer` with zero size.
+/// A capacity of one is rejected at compile time. `RingBuffer` does not work with the size one, and
+/// both buffers are used interchangeably as backing store, e.g. in `BasicSerialLineBuffer`. Rejecting it
+/// here keeps the supported sizes identical. To buffer a single element, use a plain variable.
+///
+/// @tparam Element The type for the elements in the buffer. This has to be a scalar type.
+/// @tparam capacity The maximum number of elements in the buffer.
+///
+template<typename Element, uint16_t capacity>
+class StaticRingBuffer
+{
+    static_assert(capacity != 1, "A capacity of one is not supported, to match the sizes supported by RingBuffer.");
+
+public:
+    /// The type used for size calculations.
+    ///
+    using Size = uint16_t;
+
+    /// A contiguous region of elements in this buffer.
+    ///
+    using Span = RingBufferSpan<Size, Element>;
+
+    /// The readable elements of this buffer.
+    ///
+    using Regions = RingBufferRegions<Size, Element>;
+
+    /// If writing to a full buffer overwrites the oldest elements.
+    ///
+    constexpr static bool cOverwritesOldest = true;
+
+public:
+    /// Create a new empty ring buffer.
+    ///
+    constexpr StaticRingBuffer() noexcept
+        : _readPos(0), _writePos(0), _count(0), _data() {}
+
+public:
+    /// Check if this buffer is disabled.
+    ///
+    /// @return `true` if the capacity of the buffer is zero.
+    ///
+    constexpr bool isDisabled() const noexcept {
+        return capacity == 0;
+    }
+
+    /// Check if this buffer is enabled.
+    ///
+    /// @return `true` if the capacity of the buffer is non-zero.
+    ///
+    constexpr bool isEnabled() const noexcept {
+        return capacity != 0;
+    }
+
+    /// Get the size of the buffer.
+    ///
+    /// @return The capacity of the buffer.
+    ///
+    constexpr Size getSize() const noexcept {
+        return capacity;
+    }
+
+    /// Get the number of elements in the buffer.
+    ///
+    /// @return The number of elements in the buffer.
+    ///
+    Size getCount() const noexcept {
+        return _count;
+    }
+
+    /// Check if the buffer if empty.
+    ///
+    /// @return `true` if the buffer is empty.
+    ///
+    bool isEmpty() const noexcept {
+        return _count == 0;
+    }
+
+    /// Write elements to the buffer.
+    ///
+    /// If you write more elements as the buffer can hold, only the last elements are actually
+    /// copied. If the buffer is full, the oldest elements are overwritten.
+    ///
+    /// @param elements A pointer to the array with elements.
+    /// @param count The number of elements in the array.
+    ///
+    void write(const Element *elements, Size count) noexcept {
+        if (count == 0 || elements == nullptr || isDisabled()) {
+            return;
+        }
+        if (count > capacity) {
+            elements += (count - capacity);
+            count = capacity;
+        }
+        const auto firstCount = IntegerMath::min<Size>(static_cast<Size>(capacity - _writePos), count);
+        std::memcpy(_data + _writePos, elements, sizeof(Element)*firstCount);
+        if (firstCount < count) {
+            std::memcpy(_data, elements + firstCount, sizeof(Element)*static_cast<Size>(count - firstCount));
+        }
+        _writePos = wrap(_writePos + count);
+        const auto free = static_cast<Size>(capacity - _count);
+        if (count > free) {
+            _readPos = wrap(_readPos + (count - free));
+            _count = capacity;
+        } else {
+            _count += count;
+        }
+    }
+
+    /// Read elements from the buffer.
+    ///
+    /// @param elements The buffer for the elements to read.
+    /// @param count The maximum number of elements to read into the buffer.
+    /// @return The actual number of elements stored in the buffer.
+    ///
+    Size read(Element *elements, Size count) noexcept {
+        if (count == 0 || elements == nullptr || _count == 0) {
+            return 0;
+        }
+        if (count > _count) {
+            count = _count;
+        }
+        const auto firstCount = IntegerMath::min<Size>(static_cast<Size>(capacity - _readPos), count);
+        std::memcpy(elements, _data + _readPos, sizeof(Element)*firstCount);
+        if (firstCount < count) {
+            std::memcpy(elements + firstCount, _data, sizeof(Element)*static_cast<Size>(count - firstCount));
+        }
+        _readPos = wrap(_readPos + count);
+        _count -= count;
+        return count;
+    }
+
+    /// Read elements from the buffer, up to a given element.
+    ///
+    /// This function reads elements as the regular `read` method, but if an element which
+    /// equals `endMark` was read, reading is stopped. The end mark is always copied to the
+    /// read buffer.
+    ///
+    /// @param elements The buffer for the elements to read.
+    /// @param count The maximum number of elements to read into the buffer.
+    /// @param endMark The element which marks the end to read.
+    /// @return The actual number of elements stored in the buffer.
+    ///
+    Size readToEnd(Element *elements, Size count, Element endMark) noexcept {
+        const auto regions = peekReadable();
+        const auto index = regions.findFirst(endMark, count);
+        if (index < count && index < regions.getSize()) {
+            count = static_cast<Size>(index + 1);
+        }
+        return read(elements, count);
+    }
+
+    /// Find the first element equal to the given one, without consuming any elements.
+    ///
+    /// See `RingBuffer::findFirst()`.
+    ///
+    /// @param element The element to search.
+    /// @return The index of the first matching element, or `getCount()` if there is no match.
+    ///
+    Size findFirst(Element element) noexcept {
+        return peekReadable().findFirst(element);
+    }
+
+    /// Get the readable elements without consuming them.
+    ///
+    /// See `RingBuffer::peekReadable()`.
+    ///
+    /// @return The readable elements in up to two regions.
+    ///
+    Regions peekReadable() noexcept {
+        const auto firstSize = IntegerMath::min<Size>(static_cast<Size>(capacity - _readPos), _count);
+        return Regions{{_data + _readPos, firstSize}, {_data, static_cast<Size>(_count - firstSize)}};
+    }
+
+    /// Remove elements from the read side of the buffer.
+    ///
+    /// @param count The number of elements to remove. Must be less or equal to `getCount()`.
+    ///
+    void consume(Size count) noexcept {
+        _readPos = wrap(_readPos + count);
+        _count -= count;
+    }
+
+    /// Get the contiguous free region at the write position.
+    ///
+    /// See `RingBuffer::acquireWritable()`.
+    ///
+    /// @return The writable region, with a size of zero if the buffer is full.
+    ///
+    Span acquireWritable() noexcept {
+        return Span{_data + _writePos, IntegerMath::min<Size>(
+            static_cast<Size>(capacity - _writePos), static_cast<Size>(capacity - _count))};
+    }
+
+    /// Add elements written into the region returned by `acquireWritable()`.
+    ///
+    /// @param count The number of written elements. Must be less or equal to the size of the region.
+    ///
+    void commit(Size count) noexcept {
+        _writePos = wrap(_writePos + count);
+        _count += count;
+    }
+
+    /// Reset the buffer.
+    ///
+    void reset() noexcept {
+        _readPos = 0;
+        _writePos = 0;
+        _count = 0;
+    }
+
+private:
+    /// If the capacity is a power of two.
+    ///
+    constexpr static bool cIsPowerOfTwo = (capacity & (capacity - 1)) == 0;
+
+    /// The mask for the positions, if the capacity is a power of two.
+    ///
+    constexpr static Size cMask = static_cast<Size>(capacity - 1);
+
+    /// Wrap a position which was advanced by at most the capacity.
+    ///
+    /// @param position The position, which has to be less than two times the capacity.
+    /// @return The position in the range 0 to capacity-1.
+    ///
+    constexpr static Size wrap(uint32_t position) noexcept {
+        if constexpr (cIsPowerOfTwo) {
+            return static_cast<Size>(position & cMask);
+        } else {
+            return static_cast<Size>(position >= capacity ? position - capacity : position);
+        }
+    }
+
+private:
+    Size _readPos; ///< The read position.
+    Size _writePos; ///< The write position.
+    Size _count; ///< The number of elements in the buffer.
+    Element _data[(capacity > 0) ? capacity : 1]; ///< The actual buffer.
+};
+
+
+}
+
+
@@ -18,6 +18,10 @@
 #include "String.hpp"
 
 
+#include "MemoryStatistics.hpp"
+#include "StringFormat.hpp"
+
+#include <algorithm>
 #include <cstring>
 #include <cstdlib>
 
@@ -26,114 +30,159 @@ namespace lr {
 
 
 String::String() noexcept
-    : _length(0), _capacity(0), _data(nullptr)
+    : _length(0), _capacity(cInlineCapacity)
 {
+    _storage.local[0] = '\0';
 }
 
 
 String::~String() noexcept
 {
-    if (_data != nullptr) {
-        free(_data);
+    if (!isInline()) {
+        MemoryStatistics::recordRelease(static_cast<uint32_t>(_capacity)+1);
+        free(_storage.heap);
     }
 }
 
 
 String::String(const char *str) noexcept
-    : _length(0), _capacity(0), _data(nullptr)
+    : String()
 {
-    _length = static_cast<Size>(std::strlen(str));
-    reserve(_length);
-    std::memcpy(_data, str, _length+1);
+    const auto length = static_cast<Size>(std::strlen(str));
+    reserve(length);
+    std::memcpy(getMutableData(), str, length+1);
+    _length = length;
 }
 
 
 String::String(const char *str, String::Size count) noexcept
-    : _length(count), _capacity(0), _data(nullptr)
+    : String()
 {
-    reserve(_length);
-    std::memcpy(_data, str, _length);
-    _data[_length] = '\0'; // Add the missing end mark.
+    reserve(count);
+    char *data = getMutableData();
+    std::memcpy(data, str, count);
+    data[count] = '\0'; // Add the missing end mark.
+    _length = count;
 }
 
 
 String::String(const String &other) noexcept
-    : _length(other._length), _capacity(other._length), _data(nullptr)
+    : String()
 {
-    reserve(other.getLength());
-    std::memcpy(_data, other._data, _length+1);
+    reserve(other._length);
+    std::memcpy(getMutableData(), other.getData(), other._length+1);
+    _length = other._length;
 }
 
 
 String::String(String &&other) noexcept
-    : _length(other._length), _capacity(other._length), _data(other._data)
+    : String()
 {
-    other._data = nullptr;
-    other._length = 0;
-    other._capacity = 0;
+    takeFrom(other);
 }
 
 
 String& String::operator=(const String &other) noexcept
 {
-    if (_data != nullptr) {
-        free(_data);
-        _data = nullptr;
-        _capacity = 0;
+    if (this == &other) {
+        return *this;
     }
+    // Reuse the existing memory block, if the other string fits into it.
+    reserve(other._length);
+    std::memcpy(getMutableData(), other.getData(), other._length+1);
     _length = other._length;
-    reserve(_length);
-    std::memcpy(_data, other._data, _length+1);
     return *this;
 }
 
 
 String& String::operator=(const char *str) noexcept
 {
-    if (_data != nullptr) {
-        free(_data);
-        _data = nullptr;
-        _capacity = 0;
-    }
-    const Size strLen = std::strlen(str);
+    const auto strLen = static_cast<Size>(std::strlen(str));
+    reserve(strLen);
+    std::memmove(getMutableData(), str, strLen+1);
     _length = strLen;
-    reserve(_length);
-    std::strcpy(_data, str);
     return *this;
 }
 
 
 String& String::operator=(String &&other) noexcept
+{
+    if (this != &other) {
+        clear();
+        takeFrom(other);
+    }
+    return *this;
+}
+
+
+void String::clear() noexcept
+{
+    if (!isInline()) {
+        MemoryStatistics::recordRelease(static_cast<uint32_t>(_capacity)+1);
+        free(_storage.heap);
+    }
+    _length = 0;
+    _capacity = cInlineCapacity;
+    _storage.local[0] = '\0';
+}
+
+
+void String::takeFrom(String &other) noexcept
 {
     _length = other._length;
-    _capacity = other._length;
-    _data = other._data;
-    other._data = nullptr;
+    _capacity = other._capacity;
+    if (other.isInline()) {
+        std::memcpy(_storage.local, other._storage.local, other._length+1);
+    } else {
+        _storage.heap = other._storage.heap;
+    }
     other._length = 0;
-    other._capacity = 0;
-    return *this;
+    other._capacity = cInlineCapacity;
+    other._storage.local[0] = '\0';
+}
+
+
+namespace {
+
+
+/// Get a comparable string, an empty string is equal to `nullptr`.
+///
+inline const char* String_comparable(const char *str) noexcept
+{
+    return (str != nullptr) ? str : "";
+}
+
+
+/// Check if a pointer points into a block of characters.
+///
+/// @param pointer The pointer to test.
+/// @param begin The first character of the block.
+/// @param size The size of the block.
+/// @return `true` if the pointer is in the range `begin` to `begin+size`.
+///
+inline bool String_isInside(const char *pointer, const char *begin, String::Size size) noexcept
+{
+    const auto address = reinterpret_cast<uintptr_t>(pointer);
+    const auto beginAddress = reinterpret_cast<uintptr_t>(begin);
+    return address >= beginAddress && address < beginAddress + size;
+}
+
+
 }
 
 
 bool String::operator==(const String &other) const noexcept
 {
-    if (_data == nullptr && other._data == nullptr) {
-        return true;
-    } else if (_data == nullptr || other._data == nullptr) {
+    if (_length != other._length) {
         return false;
     }
-    return std::strcmp(_data, other._data) == 0;
+    return std::memcmp(getData(), other.getData(), _length) == 0;
 }
 
 
 bool String::operator==(const char *str) const noexcept
 {
-    if (_data == nullptr && str == nullptr) {
-        return true;
-    } else if (_data == nullptr || str == nullptr) {
-        return false;
-    }
-    return std::strcmp(_data, str) == 0;
+    return std::strcmp(getData(), String_comparable(str)) == 0;
 }
 
 
@@ -151,23 +200,13 @@ bool String::operator!=(const char *str) const noexcept
 
 bool String::operator<(const String &other) const noexcept
 {
-    if (_data == nullptr && other._data != nullptr) {
-        return true;
-    } else if (_data == nullptr || other._data == nullptr) {
-        return false;
-    }
-    return std::strcmp(_data, other._data) < 0;
+    return std::strcmp(getData(), other.getData()) < 0;
 }
 
 
 bool String::operator<(const char *str) const noexcept
 {
-    if (_data == nullptr && str != nullptr) {
-        return true;
-    } else if (_data == nullptr || str == nullptr) {
-        return false;
-    }
-    return std::strcmp(_data, str) < 0;
+    return std::strcmp(getData(), String_comparable(str)) < 0;
 }
 
 
@@ -185,23 +224,13 @@ bool String::operator<=(const char *str) const noexcept
 
 bool String::operator>(const String &other) const noexcept
 {
-    if (_data != nullptr && other._data == nullptr) {
-        return true;
-    } else if (_data == nullptr || other._data == nullptr) {
-        return false;
-    }
-    return std::strcmp(_data, other._data) > 0;
+    return std::strcmp(getData(), other.getData()) > 0;
 }
 
 
 bool String::operator>(const char *str) const noexcept
 {
-    if (_data != nullptr && str == nullptr) {
-        return true;
-    } else if (_data == nullptr || str == nullptr) {
-        return false;
-    }
-    return std::strcmp(_data, str) > 0;
+    return std::strcmp(getData(), String_comparable(str)) > 0;
 }
 
 
@@ -222,10 +251,13 @@ void String::append(const String &other) noexcept
     if (other.isEmpty()) {
         return;
     }
-    const Size newLength = _length + other.getLength();
+    const Size otherLength = other._length;
+    const Size newLength = _length + otherLength;
     reserve(newLength);
-    std::strcpy(_data + _length, other._data);
+    // The other string may be this one, so copy using the saved length.
+    std::memcpy(getMutableData() + _length, other.getData(), otherLength);
     _length = newLength;
+    getMutableData()[_length] = '\0';
 }
 
 
@@ -239,8 +271,36 @@ void String::append(const char *str) noexcept
         return;
     }
     const Size newLength = _length + strLen;
+    // The text may point into this string, which is moved by `reserve()`.
+    const bool isInside = String_isInside(str, getData(), _length);
+    const auto offset = isInside ? (str - getData()) : 0;
+    reserve(newLength);
+    if (isInside) {
+        str = getData() + offset;
+    }
+    std::memmove(getMutableData() + _length, str, strLen+1);
+    _length = newLength;
+}
+
+
+void String::append(StringView text) noexcept
+{
+    if (text.isEmpty()) {
+        return;
+    }
+    const Size textLength = text.getLength();
+    const Size newLength = _length + textLength;
+    // The view may point into this string, which is moved by `reserve()`.
+    const char *source = text.getData();
+    const bool isInside = String_isInside(source, getData(), _length);
+    const auto offset = isInside ? (source - getData()) : 0;
     reserve(newLength);
-    std::strcpy(_data + _length, str);
+    if (isInside) {
+        source = getData() + offset;
+    }
+    char *data = getMutableData();
+    std::memmove(data + _length, source, textLength);
+    data[newLength] = '\0';
     _length = newLength;
 }
 
@@ -249,16 +309,31 @@ void String::append(char c) noexcept
 {
     const Size newLength = _length + 1;
     reserve(newLength);
-    _data[_length] = c;
-    _data[_length+1] = '\0';
+    char *data = getMutableData();
+    data[_length] = c;
+    data[newLength] = '\0';
     _length = newLength;
 }
 
 
-void String::reserve(Size capacity) noexcept
+namespace {
+
+
+/// Calculate the new capacity for a string which has to grow.
+///
+/// Small strings grow in small linear steps. Above `cGeometricGrowthThreshold` the capacity grows at
+/// least by the factor 1.5, if the geometric growth policy is selected. This makes appending single
+/// characters run in amortised constant time. The result is limited to the range of the size type.
+///
+/// @param currentCapacity The current capacity of the string.
+/// @param requiredCapacity The minimum required capacity.
+/// @return The new capacity, which is never smaller than the required one.
+///
+inline String::Size String_getGrowCapacity(String::Size currentCapacity, String::Size requiredCapacity) noexcept
 {
+    uint32_t capacity = requiredCapacity;
     if (capacity < 32) {
-        // For strings below 32 bytes, reserve in 8 byte steps.
+        // For strings below 32 bytes, reserve in 4 byte steps.
         capacity = ((capacity/4)+1)*4;
     } else if (capacity < 128) {
         // For strings below 128 bytes, reserve in 16 byte steps.
@@ -267,25 +342,62 @@ void String::reserve(Size capacity) noexcept
         // For larger strings, reserve in 32 byte steps.
         capacity = ((capacity/32)+1)*32;
     }
-    if (_capacity >= capacity) {
+    if (String::cGrowthPolicy == String::GrowthPolicy::Geometric
+        && currentCapacity >= String::cGeometricGrowthThreshold) {
+        capacity = std::max<uint32_t>(capacity, static_cast<uint32_t>(currentCapacity) + (currentCapacity / 2));
+    }
+    return static_cast<String::Size>(std::min<uint32_t>(capacity, std::numeric_limits<String::Size>::max()));
+}
+
+
+}
+
+
+void String::reserve(Size capacity) noexcept
+{
+    // Strings which fit into the current block, or the inline storage, need no allocation.
+    if (getCapacity() >= capacity) {
         return;
     }
+    capacity = String_getGrowCapacity(getCapacity(), capacity);
     // Change or allocate the memory block.
-    _data = static_cast<char*>(std::realloc(_data, capacity+1));
-    // If this operation shortens the string, adjust the length and add a zero byte.
-    if (capacity < _length) {
-        _data[capacity] = '\0';
-        _length = capacity;
+    if (isInline()) {
+        const auto data = static_cast<char*>(std::malloc(capacity+1));
+        std::memcpy(data, _storage.local, _length+1);
+        _storage.heap = data;
+    } else {
+        MemoryStatistics::recordRelease(static_cast<uint32_t>(_capacity)+1);
+        _storage.heap = static_cast<char*>(std::realloc(_storage.heap, capacity+1));
     }
+    MemoryStatistics::recordAllocation(static_cast<uint32_t>(capacity)+1);
     _capacity = capacity;
 }
 
 
+void String::appendReserve(Size count) noexcept
+{
+    const uint32_t capacity = static_cast<uint32_t>(_length) + count;
+    reserve(static_cast<Size>(std::min<uint32_t>(capacity, std::numeric_limits<Size>::max())));
+}
+
+
 void String::squeeze() noexcept
 {
-    if (_length != _capacity) {
+    if (isInline() || _length == _capacity) {
+        return;
+    }
+    if (_length <= cInlineCapacity) {
+        // Move short strings back to the inline storage and release the heap block.
+        char *data = _storage.heap;
+        std::memcpy(_storage.local, data, _length+1);
+        MemoryStatistics::recordRelease(static_cast<uint32_t>(_capacity)+1);
+        free(data);
+        _capacity = cInlineCapacity;
+    } else {
+        MemoryStatistics::recordRelease(static_cast<uint32_t>(_capacity)+1);
         _capacity = _length;
-        _data = static_cast<char*>(std::realloc(_data, _capacity+1));
+        _storage.heap = static_cast<char*>(std::realloc(_storage.heap, _capacity+1));
+        MemoryStatistics::recordAllocation(static_cast<uint32_t>(_capacity)+1);
     }
 }
 
@@ -300,27 +412,10 @@ String String_hex(Type value) noexcept
 {
     String result;
     result.reserve(digitCount);
-    for (uint8_t i = 0; i < digitCount; ++i) {
-        const auto nibble = static_cast<uint8_t>(value >> ((digitCount-1)*4));
-        result.append(String::getHexDigit(nibble));
-        value <<= 4;
-    }
+    StringFormat::appendHex<Type, digitCount>(result, value);
     return result;
 }
 
-
-/// Helper function to append a value as hex string.
-///
-template<typename Type, uint8_t digitCount>
-void String_appendHex(String &str, Type value) noexcept
-{
-    for (uint8_t i = 0; i < digitCount; ++i) {
-        const auto nibble = static_cast<uint8_t>(value >> ((digitCount-1)*4));
-        str.append(String::getHexDigit(nibble));
-        value <<= 4;
-    }
-}
-
     
 /// Helper function to convert a value into a binary string.
 ///
@@ -329,81 +424,19 @@ String String_bin(Type value) noexcept
 {
     String result;
     result.reserve(digitCount);
-    for (uint8_t i = 0; i < digitCount; ++i) {
-        if ((value & (static_cast<Type>(1)<<(digitCount-1))) != 0) {
-            result.append('1');
-        } else {
-            result.append('0');
-        }
-        value <<= 1;
-    }
+    StringFormat::appendBin<Type, digitCount>(result, value);
     return result;
 }
 
-    
-/// Helper function to append a value as binary string.
-///
-template<typename Type, uint8_t digitCount>
-void String_appendBin(String &str, Type value) noexcept
-{
-    for (uint8_t i = 0; i < digitCount; ++i) {
-        if ((value & (static_cast<Type>(1)<<(digitCount-1))) != 0) {
-            str.append('1');
-        } else {
-            str.append('0');
-        }
-        value <<= 1;
-    }
-}
-
-    
-/// Prepare decimal digits, in reverse order.
-///
-inline uint8_t String_prepareDigits(char *digits, uint32_t value) noexcept
-{
-    uint8_t digitCount = 0;
-    if (value == 0) {
-        digits[0] = '0';
-        digitCount = 1;
-    } else {
-        while (value != 0) {
-            const uint8_t index = (value % 10);
-            value /= 10;
-            digits[digitCount] = ('0' + index);
-            digitCount += 1;
-        }
-    }
-    return digitCount;
-}
-
-    
-/// Align the prepared digits, with padding and in the correct order.
-///
-inline void String_alignNumber(String &str, const char *digits, const uint8_t digitCount, const uint8_t width, const char fillChar)
-{
-    for (uint8_t i = 0; i < (width-digitCount); ++i) {
-        str.append(fillChar);
-    }
-    if (width >= digitCount) {
-        for (int8_t i = digitCount-1; i >= 0; --i) {
-            str.append(digits[i]);
-        }
-    } else {
-        const int8_t dropCount = (digitCount-width);
-        for (int8_t i = digitCount-1; i >= dropCount; --i) {
-            str.append(digits[i]);
-        }
-    }
-}
 
-    
-/// Create a string with the aligned digits.
+/// Create a string with a decimal number.
 ///
-inline String String_createNumber(const char *digits, const uint8_t digitCount, const uint8_t width, const char fillChar)
+template<typename Type>
+inline String String_createNumber(Type value, const uint8_t width, const char fillChar) noexcept
 {
     String result;
     result.reserve(width);
-    String_alignNumber(result, digits, digitCount, width, fillChar);
+    StringFormat::appendNumber(result, value, width, fillChar);
     return result;
 }
 
@@ -431,34 +464,13 @@ String String::hex(uint32_t value) noexcept
     
 String String::number(uint32_t value, uint8_t width, char fillChar) noexcept
 {
-    // Prepare all required digits.
-    char digits[11];
-    const auto digitCount = String_prepareDigits(digits, value);
-    if (width == 0) {
-        width = digitCount;
-    }
-    // Create the aligned string.
-    return String_createNumber(digits, digitCount, width, fillChar);
+    return String_createNumber(value, width, fillChar);
 }
 
     
 String String::number(int32_t value, uint8_t width, char fillChar) noexcept
 {
-    // Prepare all required digits.
-    char digits[12];
-    uint8_t digitCount;
-    if (value < 0) {
-        digitCount = String_prepareDigits(digits, value * -1);
-        digits[digitCount] = '-';
-        digitCount += 1;
-    } else {
-        digitCount = String_prepareDigits(digits, value);
-    }
-    if (width == 0) {
-        width = digitCount;
-    }
-    // Create the aligned string.
-    return String_createNumber(digits, digitCount, width, fillChar);
+    return String_createNumber(value, width, fillChar);
 }
 
                       
@@ -482,70 +494,49 @@ String String::bin(uint32_t value) noexcept
     
 void String::appendHex(uint8_t value) noexcept
 {
-    String_appendHex<uint8_t, 2>(*this, value);
+    StringFormat::appendHex<uint8_t, 2>(*this, value);
 }
 
 
 void String::appendHex(uint16_t value) noexcept
 {
-    String_appendHex<uint16_t, 4>(*this, value);
+    StringFormat::appendHex<uint16_t, 4>(*this, value);
 }
 
     
 void String::appendHex(uint32_t value) noexcept
 {
-    String_appendHex<uint32_t, 8>(*this, value);
+    StringFormat::appendHex<uint32_t, 8>(*this, value);
 }
 
     
 void String::appendBin(uint8_t value) noexcept
 {
-    String_appendBin<uint8_t, 8>(*this, value);
+    StringFormat::appendBin<uint8_t, 8>(*this, value);
 }
 
     
 void String::appendBin(uint16_t value) noexcept
 {
-    String_appendBin<uint16_t, 16>(*this, value);
+    StringFormat::appendBin<uint16_t, 16>(*this, value);
 }
 
     
 void String::appendBin(uint32_t value) noexcept
 {
-    String_appendBin<uint32_t, 32>(*this, value);
+    StringFormat::appendBin<uint32_t, 32>(*this, value);
 }
 
     
 void String::appendNumber(uint32_t value, uint8_t width, char fillChar) noexcept
 {
-    // Prepare all required digits.
-    char digits[11];
-    const auto digitCount = String_prepareDigits(digits, value);
-    if (width == 0) {
-        width = digitCount;
-    }
-    // Append the aligned string.
-    String_alignNumber(*this, digits, digitCount, width, fillChar);
+    StringFormat::appendNumber(*this, value, width, fillChar);
 }
 
     
 void String::appendNumber(int32_t value, uint8_t width, char fillChar) noexcept
 {
-    // Prepare all required digits.
-    char digits[12];
-    uint8_t digitCount;
-    if (value < 0) {
-        digitCount = String_prepareDigits(digits, value * -1);
-        digits[digitCount] = '-';
-        digitCount += 1;
-    } else {
-        digitCount = String_prepareDigits(digits, value);
-    }
-    if (width == 0) {
-        width = digitCount;
-    }
-    // Append the aligned string.
-    String_alignNumber(*this, digits, digitCount, width, fillChar);
+    StringFormat::appendNumber(*this, value, width, fillChar);
 }
 
 
@@ -560,8 +551,9 @@ String::Size String::getFirstIndex(char c, String::Size offset) const noexcept
     if (_length == 0) {
         return notFound;
     }
+    const char *data = getData();
     for (Size i = offset; i < _length; ++i) {
-        if (_data[i] == c) {
+        if (data[i] == c) {
             return i;
         }
     }
@@ -577,7 +569,7 @@ String String::getSlice(String::Size index, String::Size length) const noexcept
     if (index + length > _length) {
         length = (_length - index);
     }
-    return String(_data + index, length);
+    return String(getData() + index, length);
 }
 
 
@@ -587,113 +579,39 @@ String String::getTail(String::Size index) const noexcept
 }
 
 
-namespace {
-
-
-/// Try to convert this string into an integer of the given type.
-///
-/// This function will return an error if the string contains an number which cannot be stored in the chosen
-/// integer type.
-///
-/// @tparam IntType The integer type for the result.
-/// @return The result of the conversion.
-///
-template<typename IntType>
-StatusResult<IntType> toInt(const String &str) noexcept
-{
-    if (str.isEmpty()) {
-        return StatusResult<IntType>::error();
-    }
-    IntType result = 0;
-    IntType factor;
-    if (str.getCharAt(0) == '-') {
-        // Negative number are only allowed for signed integer types.
-        if (!std::numeric_limits<IntType>::is_signed) {
-            return StatusResult<IntType>::error();
-        }
-        factor = -1;
-    } else {
-        factor = 1;
-    }
-    String::Size index = str.getLength();
-    while (index > 0) {
-        index -= 1;
-        const char c = str.getCharAt(index);
-        if (c >= '0' && c <= '9') {
-            const auto digit = static_cast<IntType>(c - '0');
-            // Only handle digits greater than zero.
-            if (digit > 0) {
-                // If the factor already reached the end of the range, this will not work.
-                if (factor == 0) {
-                    return StatusResult<IntType>::error();
-                }
-                // Try to calculate the digit for the current factor.
-                IntType digitWithFactor;
-                if (IntegerMath::multiplyCheckOverflow(digit, factor, &digitWithFactor)) {
-                    return StatusResult<IntType>::error();
-                }
-                // Try to add it to the result.
-                if (IntegerMath::addCheckOverflow(digitWithFactor, result, &result)) {
-                    return StatusResult<IntType>::error();
-                }
-            }
-        } else if (c == '-') {
-            if (index > 0) {
-                // The sign has to be the last element for the number.
-                return StatusResult<IntType>::error();
-            }
-        } else {
-            // Invalid character in the number.
-            return StatusResult<IntType>::error();
-        }
-        // If the factor already had an overflow, ignore it.
-        if (factor != 0) {
-            // Try to move the factor.
-            if (IntegerMath::multiplyCheckOverflow(factor, static_cast<IntType>(10), &factor)) {
-                factor = 0;
-            }
-        }
-    }
-    return StatusResult<IntType>::success(result);
-}
-
-
-}
-
-
 StatusResult<uint32_t> String::toUInt32() const
 {
-    return toInt<uint32_t>(*this);
+    return StringView(*this).toUInt32();
 }
 
 
 StatusResult<int32_t> String::toInt32() const
 {
-    return toInt<int32_t>(*this);
+    return StringView(*this).toInt32();
 }
 
 
 StatusResult<uint16_t> String::toUInt16() const
 {
-    return toInt<uint16_t>(*this);
+    return StringView(*this).toUInt16();
 }
 
 
 StatusResult<int16_t> String::toInt16() const
 {
-    return toInt<int16_t>(*this);
+    return StringView(*this).toInt16();
 }
 
 
 StatusResult<uint8_t> String::toUInt8() const
 {
-    return toInt<uint8_t>(*this);
+    return StringView(*this).toUInt8();
 }
 
 
 StatusResult<int8_t> String::toInt8() const
 {
-    return toInt<int8_t>(*this);
+    return StringView(*this).toInt8();
 }
 
 
@@ -19,12 +19,23 @@
 
 
 #include "StatusTools.hpp"
+#include "StringView.hpp"
 #include "IntegerMath.hpp"
 
 #include <cstdint>
 #include <limits>
 
 
+/// The growth policy for the capacity of strings.
+///
+/// If this is set to `1`, strings grow geometrically above a threshold. Set it to `0`
+/// to use linear steps, which wastes less memory, but reallocates more often.
+///
+#ifndef LR_STRING_GEOMETRIC_GROWTH
+#define LR_STRING_GEOMETRIC_GROWTH 1
+#endif
+
+
 namespace lr {
 
 
@@ -35,6 +46,10 @@ namespace lr {
 /// checks for imported char arrays are omitted, therefore importing
 /// strings without null end byte may lead to undefined results.
 ///
+/// Short strings, up to `cInlineCapacity` characters, are stored
+/// inside the object itself and never touch the heap. Only if a
+/// string grows beyond this size, a memory block is allocated.
+///
 class String
 {
 public:
@@ -46,6 +61,26 @@ public:
     ///
     constexpr static Size notFound = std::numeric_limits<Size>::max();
 
+    /// The number of characters which are stored inline, without heap allocation.
+    ///
+    constexpr static Size cInlineCapacity = 11;
+
+    /// The policy how the capacity grows.
+    ///
+    enum class GrowthPolicy : uint8_t {
+        Linear, ///< Grow the capacity in linear steps of 4, 16 or 32 bytes.
+        Geometric, ///< Grow the capacity by the factor 1.5, above `cGeometricGrowthThreshold`.
+    };
+
+    /// The growth policy used for all strings, selected with `LR_STRING_GEOMETRIC_GROWTH`.
+    ///
+    constexpr static GrowthPolicy cGrowthPolicy =
+        (LR_STRING_GEOMETRIC_GROWTH != 0) ? GrowthPolicy::Geometric : GrowthPolicy::Linear;
+
+    /// The capacity from which on the geometric growth is used.
+    ///
+    constexpr static Size cGeometricGrowthThreshold = 32;
+
 public: // Construction and Copy
     /// Create an empty string.
     ///
@@ -164,6 +199,14 @@ public: // String Manipulation
     ///
     void append(const char *str) noexcept;
 
+    /// Append the characters of a view to this one.
+    ///
+    /// The view may point into this string, e.g. to append a part of it to itself.
+    ///
+    /// @param[in] text The characters to append.
+    ///
+    void append(StringView text) noexcept;
+
     /// Append a char to this one.
     ///
     /// @param[in] c The char to append.
@@ -404,26 +447,51 @@ public:
 
     /// Access the data of this string
     ///
+    /// The returned data is always terminated with a zero byte.
+    ///
     inline const char* getData() const noexcept {
-        return _data;
+        return isInline() ? _storage.local : _storage.heap;
     }
 
     /// Access a single character of this string.
     ///
     inline char getCharAt(Size index) const noexcept {
-        return _data[index];
+        return getData()[index];
+    }
+
+    /// Get a view to the characters of this string.
+    ///
+    /// The view is only valid as long this string is not modified or destroyed.
+    ///
+    inline operator StringView() const noexcept {
+        return StringView(getData(), _length);
+    }
+
+    /// Check if the string data is stored inline, without heap allocation.
+    ///
+    inline bool isInline() const noexcept {
+        return _capacity == cInlineCapacity;
     }
     
     /// Reserve memory for the string.
     ///
     /// This will reserve minimum space for a string with the size `size`.
-    /// Depending on the string length, this function will most likely
-    /// reserve more memory. The function will never reduce the capacity.
+    /// Depending on the string length and the growth policy, this function
+    /// will most likely reserve more memory. The function will never reduce
+    /// the capacity.
     ///
     /// @param[in] capacity The minimum capacity to reserve.
     ///
     void reserve(Size capacity) noexcept;
 
+    /// Reserve memory to append the given number of characters.
+    ///
+    /// Use this before appending many parts, to grow the string with a single allocation.
+    ///
+    /// @param[in] count The number of characters which will be appended.
+    ///
+    void appendReserve(Size count) noexcept;
+
     /// Squeeze the memory for this string.
     ///
     /// Calling this function will reduce the memory to the minimum
@@ -432,10 +500,36 @@ public:
     ///
     void squeeze() noexcept;
 
+private:
+    /// Access the mutable data of this string.
+    ///
+    inline char* getMutableData() noexcept {
+        return isInline() ? _storage.local : _storage.heap;
+    }
+
+    /// Release any heap memory and reset this string to an empty inline string.
+    ///
+    void clear() noexcept;
+
+    /// Take over the data of another string and reset the other one.
+    ///
+    void takeFrom(String &other) noexcept;
+
+private:
+    /// The storage for the string data.
+    ///
+    /// Design Note: A heap block is always larger than `cInlineCapacity`, therefore the
+    /// capacity itself marks the inline mode and no additional flag is required.
+    ///
+    union Storage {
+        char *heap; ///< The allocated data block, if the string is larger than the inline capacity.
+        char local[cInlineCapacity+1]; ///< The inline data for short strings.
+    };
+
 private:
     Size _length; ///< The length of the string (without zero byte).
-    Size _capacity; ///< The capacity of the data block.
-    char *_data; ///< The string data.
+    Size _capacity; ///< The capacity of the data block. Equal to `cInlineCapacity` for inline strings.
+    Storage _storage; ///< The string data.
 };
 
 
@@ -0,0 +1,136 @@
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#include "StringBuilder.hpp"
+
+
+#include "String.hpp"
+#include "StringFormat.hpp"
+
+#include <cstring>
+
+
+namespace lr {
+
+
+namespace {
+
+
+/// The buffer used for builders created with a buffer size of zero.
+///
+/// It only ever contains the zero byte, because the capacity of these builders is zero.
+///
+char StringBuilder_emptyBuffer[1] = {'\0'};
+
+
+}
+
+
+StringBuilder::StringBuilder(char *buffer, StringBuilder::Size size) noexcept
+    : _buffer(size > 0 ? buffer : StringBuilder_emptyBuffer), _capacity(size > 0 ? size - 1 : 0),
+    _length(0), _isTruncated(false)
+{
+    _buffer[0] = '\0';
+}
+
+
+void StringBuilder::append(StringView text) noexcept
+{
+    Size count = text.getLength();
+    if (count > _capacity - _length) {
+        count = _capacity - _length;
+        _isTruncated = true;
+    }
+    std::memcpy(_buffer + _length, text.getData(), count);
+    _length += count;
+    _buffer[_length] = '\0';
+}
+
+
+void StringBuilder::append(const char *str) noexcept
+{
+    if (str == nullptr) {
+        return;
+    }
+    append(StringView(str));
+}
+
+
+void StringBuilder::appendHex(uint8_t value) noexcept
+{
+    StringFormat::appendHex<uint8_t, 2>(*this, value);
+}
+
+
+void StringBuilder::appendHex(uint16_t value) noexcept
+{
+    StringFormat::appendHex<uint16_t, 4>(*this, value);
+}
+
+
+void StringBuilder::appendHex(uint32_t value) noexcept
+{
+    StringFormat::appendHex<uint32_t, 8>(*this, value);
+}
+
+
+void StringBuilder::appendBin(uint8_t value) noexcept
+{
+    StringFormat::appendBin<uint8_t, 8>(*this, value);
+}
+
+
+void StringBuilder::appendBin(uint16_t value) noexcept
+{
+    StringFormat::appendBin<uint16_t, 16>(*this, value);
+}
+
+
+void StringBuilder::appendBin(uint32_t value) noexcept
+{
+    StringFormat::appendBin<uint32_t, 32>(*this, value);
+}
+
+
+void StringBuilder::appendNumber(uint32_t value, uint8_t width, char fillChar) noexcept
+{
+    StringFormat::appendNumber(*this, value, width, fillChar);
+}
+
+
+void StringBuilder::appendNumber(int32_t value, uint8_t width, char fillChar) noexcept
+{
+    StringFormat::appendNumber(*this, value, width, fillChar);
+}
+
+
+void StringBuilder::clear() noexcept
+{
+    _length = 0;
+    _isTruncated = false;
+    _buffer[0] = '\0';
+}
+
+
+String StringBuilder::toString() const noexcept
+{
+    return String(_buffer, _length);
+}
+
+
+}
+
@@ -0,0 +1,258 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+
+#include "StringView.hpp"
+
+#include <cstdint>
+
+
+namespace lr {
+
+
+class String;
+
+
+/// A string builder which formats text into a fixed buffer.
+///
+/// The builder never allocates memory. It works on a caller provided buffer and provides
+/// the same append methods as `String`, using the same formatters. If the text does
+/// not fit into the buffer, it is truncated and the builder is marked as truncated.
+/// The text in the buffer is always terminated with a zero byte.
+///
+/// Example:
+/// ```
+/// char buffer[32];
+/// StringBuilder builder(buffer, sizeof(buffer));
+/// builder.append("Value: ");
+/// builder.appendNumber(value, 4, '0');
+/// writer->writeLine(builder.getData());
+/// ```
+///
+/// See `InlineString` for a builder with its own buffer.
+///
+class StringBuilder
+{
+public:
+    /// The size type for the builder.
+    ///
+    using Size = uint16_t;
+
+public:
+    /// Create a new builder for the given buffer.
+    ///
+    /// @param buffer The buffer for the text.
+    /// @param size The size of the buffer in bytes, including the zero byte. Must be at least one,
+    ///     with a size of zero the buffer is not used and the builder always stays empty.
+    ///
+    StringBuilder(char *buffer, Size size) noexcept;
+
+    /// Builders can not be copied, because they point to their buffer.
+    ///
+    StringBuilder(const StringBuilder&) = delete;
+
+    /// Builders can not be assigned, because they point to their buffer.
+    ///
+    StringBuilder& operator=(const StringBuilder&) = delete;
+
+public: // String Manipulation
+    /// Append text to this builder.
+    ///
+    /// @param text The text to append.
+    ///
+    void append(StringView text) noexcept;
+
+    /// Append text to this builder.
+    ///
+    /// @param str The text to append. This text has to end in a zero byte.
+    ///
+    void append(const char *str) noexcept;
+
+    /// Append a char to this builder.
+    ///
+    /// @param c The char to append.
+    ///
+    inline void append(char c) noexcept {
+        if (_length < _capacity) {
+            _buffer[_length] = c;
+            _length += 1;
+            _buffer[_length] = '\0';
+        } else {
+            _isTruncated = true;
+        }
+    }
+
+    /// Append a value in hex representation to this builder.
+    ///
+    /// @param[in] value The value to append.
+    ///
+    void appendHex(uint8_t value) noexcept;
+    void appendHex(uint16_t value) noexcept; ///< @copydoc StringBuilder::appendHex(uint8_t)
+    void appendHex(uint32_t value) noexcept; ///< @copydoc StringBuilder::appendHex(uint8_t)
+
+    /// Append a value in binary representation to this builder.
+    ///
+    /// @param[in] value The value to append.
+    ///
+    void appendBin(uint8_t value) noexcept;
+    void appendBin(uint16_t value) noexcept; ///< @copydoc StringBuilder::appendBin(uint8_t)
+    void appendBin(uint32_t value) noexcept; ///< @copydoc StringBuilder::appendBin(uint8_t)
+
+    /// Append a value as decimal number to this builder.
+    ///
+    /// @param[in] value The value to append.
+    /// @param[in] width The width of the field, see `String::number()`.
+    /// @param[in] fillChar The character to fill the field.
+    ///
+    void appendNumber(uint32_t value, uint8_t width = 0, char fillChar = ' ') noexcept;
+
+    /// Append a value as decimal number to this builder.
+    ///
+    /// @param[in] value The value to append.
+    /// @param[in] width The width of the field, see `String::number()`.
+    /// @param[in] fillChar The character to fill the field.
+    ///
+    void appendNumber(int32_t value, uint8_t width = 0, char fillChar = ' ') noexcept;
+
+    /// Append a value as decimal number to this builder.
+    ///
+    inline void appendNumber(uint8_t value, uint8_t width = 0, char fillChar = ' ') noexcept {
+        appendNumber(static_cast<uint32_t>(value), width, fillChar);
+    }
+
+    /// Append a value as decimal number to this builder.
+    ///
+    inline void appendNumber(uint16_t value, uint8_t width = 0, char fillChar = ' ') noexcept {
+        appendNumber(static_cast<uint32_t>(value), width, fillChar);
+    }
+
+    /// Append a value as decimal number to this builder.
+    ///
+    inline void appendNumber(int8_t value, uint8_t width = 0, char fillChar = ' ') noexcept {
+        appendNumber(static_cast<int32_t>(value), width, fillChar);
+    }
+
+    /// Append a value as decimal number to this builder.
+    ///
+    inline void appendNumber(int16_t value, uint8_t width = 0, char fillChar = ' ') noexcept {
+        appendNumber(static_cast<int32_t>(value), width, fillChar);
+    }
+
+    /// Remove all text from this builder and reset the truncated state.
+    ///
+    void clear() noexcept;
+
+public:
+    /// Check if this builder is empty.
+    ///
+    inline bool isEmpty() const noexcept {
+        return _length == 0;
+    }
+
+    /// Get the length of the text.
+    ///
+    inline Size getLength() const noexcept {
+        return _length;
+    }
+
+    /// Get the maximum length of the text.
+    ///
+    inline Size getCapacity() const noexcept {
+        return _capacity;
+    }
+
+    /// Check if text was truncated, because it did not fit into the buffer.
+    ///
+    inline bool isTruncated() const noexcept {
+        return _isTruncated;
+    }
+
+    /// Access the text, terminated with a zero byte.
+    ///
+    inline const char* getData() const noexcept {
+        return _buffer;
+    }
+
+    /// Get a view to the text.
+    ///
+    inline operator StringView() const noexcept {
+        return StringView(_buffer, _length);
+    }
+
+    /// Create a string with a copy of the text.
+    ///
+    String toString() const noexcept;
+
+private:
+    char *_buffer; ///< The buffer for the text.
+    Size _capacity; ///< The maximum length of the text, without zero byte.
+    Size _length; ///< The current length of the text.
+    bool _isTruncated; ///< If text was truncated.
+};
+
+
+/// A string builder with an inline buffer of a fixed size.
+///
+/// Use this builder as a local variable to format text without any heap allocation.
+///
+/// @tparam capacity The maximum length of the text, without the zero byte.
+///
+template<uint16_t capacity>
+class InlineString : public StringBuilder
+{
+    static_assert(capacity < 0xffffu, "The capacity plus the zero byte has to fit into the size type.");
+
+public:
+    /// Create a new empty string.
+    ///
+    InlineString() noexcept : StringBuilder(_storage, capacity+1) {}
+
+    /// Create a new string with the given text.
+    ///
+    /// @param text The initial text.
+    ///
+    explicit InlineString(StringView text) noexcept : StringBuilder(_storage, capacity+1) {
+        append(text);
+    }
+
+    /// Copy a string.
+    ///
+    InlineString(const InlineString &other) noexcept : StringBuilder(_storage, capacity+1) {
+        append(StringView(other));
+    }
+
+    /// Assign a string.
+    ///
+    InlineString& operator=(const InlineString &other) noexcept {
+        if (this != &other) {
+            clear();
+            append(StringView(other));
+        }
+        return *this;
+    }
+
+private:
+    char _storage[capacity+1]; ///< The inline buffer.
+};
+
+
+}
+
+
@@ -0,0 +1,310 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+
+#include "StringView.hpp"
+
+#include <cstdint>
+
+
+/// @namespace lr::StringFormat
+///
+/// The number formatters shared by `String` and `StringBuilder`.
+///
+/// The `write*` kernels write the digits into a plain buffer and can be used in
+/// constant expressions. The `append*` functions append the formatted characters to a
+/// target, which has to provide `append(char)` and `append(StringView)` methods. This way,
+/// every string type uses the same formatting code.
+///
+
+namespace lr {
+namespace StringFormat {
+
+
+/// The decimal digit pairs from "00" to "99".
+///
+inline constexpr char cDigitPairs[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/// The hex digits for all nibble values.
+///
+inline constexpr char cHexDigits[17] = "0123456789abcdef";
+
+/// The binary representation for all nibble values.
+///
+inline constexpr char cBinaryNibbles[16][4] = {
+    {'0', '0', '0', '0'},
+    {'0', '0', '0', '1'},
+    {'0', '0', '1', '0'},
+    {'0', '0', '1', '1'},
+    {'0', '1', '0', '0'},
+    {'0', '1', '0', '1'},
+    {'0', '1', '1', '0'},
+    {'0', '1', '1', '1'},
+    {'1', '0', '0', '0'},
+    {'1', '0', '0', '1'},
+    {'1', '0', '1', '0'},
+    {'1', '0', '1', '1'},
+    {'1', '1', '0', '0'},
+    {'1', '1', '0', '1'},
+    {'1', '1', '1', '0'},
+    {'1', '1', '1', '1'}
+};
+
+
+/// Get a hex digit from a nibble.
+///
+constexpr char getHexDigit(const uint8_t value) noexcept
+{
+    return cHexDigits[value & 0x0fu];
+}
+
+
+/// Divide a value by 10000, using a multiplication with the reciprocal.
+///
+/// The result is exact for all 32-bit values. This avoids the slow division library call
+/// on cores without a hardware divider.
+///
+constexpr uint32_t divideBy10000(uint32_t value) noexcept
+{
+    return static_cast<uint32_t>((static_cast<uint64_t>(value) * 0xd1b71759u) >> 45);
+}
+
+
+/// Divide a value by 100, using a multiplication with the reciprocal.
+///
+/// The result is only exact for values below 43699, which covers the remainder of
+/// a division by 10000.
+///
+constexpr uint32_t divideBy100(uint32_t value) noexcept
+{
+    return (value * 5243u) >> 19;
+}
+
+
+/// Get the number of decimal digits for a value.
+///
+/// @param value The value.
+/// @return The number of digits, 1-10.
+///
+constexpr uint8_t getDecimalDigitCount(uint32_t value) noexcept
+{
+    if (value < 10000u) {
+        return (value < 100u) ? ((value < 10u) ? 1 : 2) : ((value < 1000u) ? 3 : 4);
+    }
+    if (value < 100000000u) {
+        return (value < 1000000u) ? ((value < 100000u) ? 5 : 6) : ((value < 10000000u) ? 7 : 8);
+    }
+    return (value < 1000000000u) ? 9 : 10;
+}
+
+
+/// Write a pair of decimal digits.
+///
+/// @param text The buffer for the two digits.
+/// @param value The value from 0 to 99.
+///
+constexpr void writeDigitPair(char *text, uint32_t value) noexcept
+{
+    text[0] = cDigitPairs[value * 2];
+    text[1] = cDigitPairs[value * 2 + 1];
+}
+
+
+/// Write the decimal digits for a value.
+///
+/// The digits are written in the correct order, using two-digit lookups and reciprocal
+/// multiplications instead of one division per digit. No zero byte is written.
+///
+/// @param text The buffer for the digits, with space for at least 10 characters.
+/// @param value The value to convert.
+/// @return The number of written digits.
+///
+constexpr uint8_t writeDecimal(char *text, uint32_t value) noexcept
+{
+    const uint8_t digitCount = getDecimalDigitCount(value);
+    char *end = text + digitCount;
+    while (value >= 10000u) {
+        const uint32_t quotient = divideBy10000(value);
+        const uint32_t remainder = value - quotient * 10000u;
+        const uint32_t high = divideBy100(remainder);
+        end -= 4;
+        writeDigitPair(end, high);
+        writeDigitPair(end + 2, remainder - high * 100u);
+        value = quotient;
+    }
+    if (value >= 100u) {
+        const uint32_t high = divideBy100(value);
+        end -= 2;
+        writeDigitPair(end, value - high * 100u);
+        value = high;
+    }
+    if (value >= 10u) {
+        writeDigitPair(end - 2, value);
+    } else {
+        *(end - 1) = static_cast<char>('0' + value);
+    }
+    return digitCount;
+}
+
+
+/// Write the decimal digits for a signed value.
+///
+/// @param text The buffer for the digits, with space for at least 11 characters.
+/// @param value The value to convert.
+/// @return The number of written characters, including the sign.
+///
+constexpr uint8_t writeDecimal(char *text, int32_t value) noexcept
+{
+    if (value < 0) {
+        text[0] = '-';
+        return writeDecimal(text + 1, static_cast<uint32_t>(0) - static_cast<uint32_t>(value)) + 1;
+    }
+    return writeDecimal(text, static_cast<uint32_t>(value));
+}
+
+
+/// Write the hex digits for a value.
+///
+/// @param text The buffer for the digits.
+/// @param value The value to convert.
+/// @param digitCount The number of digits to write, from the lowest nibble upwards.
+///
+constexpr void writeHex(char *text, uint32_t value, uint8_t digitCount) noexcept
+{
+    for (uint8_t i = digitCount; i > 0; --i) {
+        text[i - 1] = cHexDigits[value & 0x0fu];
+        value >>= 4;
+    }
+}
+
+
+/// Write the binary digits for a value.
+///
+/// @param text The buffer for the digits.
+/// @param value The value to convert.
+/// @param digitCount The number of digits to write, a multiple of four.
+///
+constexpr void writeBin(char *text, uint32_t value, uint8_t digitCount) noexcept
+{
+    for (uint8_t i = digitCount; i > 0; i -= 4) {
+        const char *nibble = cBinaryNibbles[value & 0x0fu];
+        text[i - 4] = nibble[0];
+        text[i - 3] = nibble[1];
+        text[i - 2] = nibble[2];
+        text[i - 1] = nibble[3];
+        value >>= 4;
+    }
+}
+
+
+/// Align the digits, with padding.
+///
+/// @param target The target for the characters.
+/// @param digits The digits in the correct order.
+/// @param digitCount The number of digits.
+/// @param width The width of the field. A zero value will append all digits. Excess digits at the end are cut-off.
+/// @param fillChar The character to fill the field.
+///
+template<typename Target>
+inline void alignNumber(Target &target, const char *digits, const uint8_t digitCount, uint8_t width, const char fillChar) noexcept
+{
+    if (width == 0) {
+        width = digitCount;
+    }
+    for (uint8_t i = digitCount; i < width; ++i) {
+        target.append(fillChar);
+    }
+    target.append(StringView(digits, (width < digitCount) ? width : digitCount));
+}
+
+
+/// Append a value as decimal number.
+///
+/// @param target The target for the characters.
+/// @param value The value to append.
+/// @param width The width of the field. A zero value will append all digits.
+/// @param fillChar The character to fill the field.
+///
+template<typename Target>
+inline void appendNumber(Target &target, uint32_t value, uint8_t width, char fillChar) noexcept
+{
+    char digits[10] = {};
+    const auto digitCount = writeDecimal(digits, value);
+    alignNumber(target, digits, digitCount, width, fillChar);
+}
+
+
+/// Append a value as decimal number.
+///
+/// @param target The target for the characters.
+/// @param value The value to append.
+/// @param width The width of the field. A zero value will append all digits.
+/// @param fillChar The character to fill the field.
+///
+template<typename Target>
+inline void appendNumber(Target &target, int32_t value, uint8_t width, char fillChar) noexcept
+{
+    char digits[11] = {};
+    const auto digitCount = writeDecimal(digits, value);
+    alignNumber(target, digits, digitCount, width, fillChar);
+}
+
+
+/// Append a value in hex representation.
+///
+/// @tparam Type The unsigned integer type of the value.
+/// @tparam digitCount The number of digits to append.
+/// @param target The target for the characters.
+/// @param value The value to append.
+///
+template<typename Type, uint8_t digitCount, typename Target>
+inline void appendHex(Target &target, Type value) noexcept
+{
+    char digits[digitCount] = {};
+    writeHex(digits, value, digitCount);
+    target.append(StringView(digits, digitCount));
+}
+
+
+/// Append a value in binary representation.
+///
+/// @tparam Type The unsigned integer type of the value.
+/// @tparam digitCount The number of digits to append.
+/// @param target The target for the characters.
+/// @param value The value to append.
+///
+template<typename Type, uint8_t digitCount, typename Target>
+inline void appendBin(Target &target, Type value) noexcept
+{
+    char digits[digitCount] = {};
+    writeBin(digits, value, digitCount);
+    target.append(StringView(digits, digitCount));
+}
+
+
+}
+}
+
+
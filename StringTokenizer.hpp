@@ -26,6 +26,9 @@ namespace lr {
 
 /// A tool to split a string into tokens.
 ///
+/// This tokenizer keeps a copy of the processed string and returns each token as new string.
+/// Use `StringViewTokenizer` to split a string or buffer without any allocation.
+///
 class StringTokenizer
 {
 public:
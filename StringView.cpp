@@ -0,0 +1,261 @@
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#include "StringView.hpp"
+
+
+#include "String.hpp"
+#include "IntegerMath.hpp"
+
+
+namespace lr {
+
+
+StringView::Size StringView::getFirstIndex(char c, StringView::Size offset) const noexcept
+{
+    if (offset >= _length) {
+        return notFound;
+    }
+    const auto found = static_cast<const char*>(std::memchr(_data + offset, c, _length - offset));
+    if (found == nullptr) {
+        return notFound;
+    }
+    return static_cast<Size>(found - _data);
+}
+
+
+StringView StringView::getSlice(StringView::Size index, StringView::Size length) const noexcept
+{
+    if (index >= _length) {
+        return StringView();
+    }
+    if (length > _length - index) {
+        length = (_length - index);
+    }
+    return StringView(_data + index, length);
+}
+
+
+StringView StringView::getTail(StringView::Size index) const noexcept
+{
+    return getSlice(index, notFound);
+}
+
+
+String StringView::toString() const noexcept
+{
+    return String(_data, _length);
+}
+
+
+int StringView::compare(const StringView &other) const noexcept
+{
+    const Size commonLength = (_length < other._length) ? _length : other._length;
+    const int result = std::memcmp(_data, other._data, commonLength);
+    if (result != 0) {
+        return result;
+    }
+    if (_length == other._length) {
+        return 0;
+    }
+    return (_length < other._length) ? -1 : 1;
+}
+
+
+namespace {
+
+
+/// Get the value of a hex, decimal or binary digit.
+///
+/// @return The value of the digit, or `0xff` if the character is no digit.
+///
+inline uint8_t getDigitValue(char c) noexcept
+{
+    if (c >= '0' && c <= '9') {
+        return static_cast<uint8_t>(c - '0');
+    } else if (c >= 'a' && c <= 'f') {
+        return static_cast<uint8_t>(c - 'a' + 10);
+    } else if (c >= 'A' && c <= 'F') {
+        return static_cast<uint8_t>(c - 'A' + 10);
+    }
+    return 0xffu;
+}
+
+
+/// Parse an integer of the given type at the start of a view.
+///
+/// This function will return an error if there are no digits, or the number cannot be stored in the chosen
+/// integer type.
+///
+/// @tparam IntType The integer type for the result.
+/// @param str The view to parse.
+/// @param consumed An optional pointer to store the number of consumed characters.
+/// @return The result of the conversion.
+///
+template<typename IntType>
+StatusResult<IntType> parseInteger(const StringView &str, StringView::Size *consumed) noexcept
+{
+    if (consumed != nullptr) {
+        *consumed = 0;
+    }
+    const char *data = str.getData();
+    const StringView::Size length = str.getLength();
+    StringView::Size index = 0;
+    bool isNegative = false;
+    if (index < length && data[index] == '-') {
+        // Negative number are only allowed for signed integer types.
+        if (!std::numeric_limits<IntType>::is_signed) {
+            return StatusResult<IntType>::error();
+        }
+        isNegative = true;
+        index += 1;
+    }
+    // Check for a hex or binary prefix, which has to be followed by a valid digit.
+    IntType base = 10;
+    if (length - index >= 3 && data[index] == '0') {
+        const char prefix = data[index + 1];
+        const uint8_t firstDigit = getDigitValue(data[index + 2]);
+        if ((prefix == 'x' || prefix == 'X') && firstDigit < 16) {
+            base = 16;
+            index += 2;
+        } else if ((prefix == 'b' || prefix == 'B') && firstDigit < 2) {
+            base = 2;
+            index += 2;
+        }
+    }
+    // Accumulate all digits, until the first invalid character.
+    const StringView::Size firstDigitIndex = index;
+    IntType result = 0;
+    while (index < length) {
+        const uint8_t digit = getDigitValue(data[index]);
+        if (digit >= static_cast<uint8_t>(base)) {
+            break;
+        }
+        if (IntegerMath::multiplyCheckOverflow(result, base, &result)) {
+            return StatusResult<IntType>::error();
+        }
+        const auto signedDigit = static_cast<IntType>(isNegative ? -static_cast<int16_t>(digit) : digit);
+        if (IntegerMath::addCheckOverflow(result, signedDigit, &result)) {
+            return StatusResult<IntType>::error();
+        }
+        index += 1;
+    }
+    if (index == firstDigitIndex) {
+        return StatusResult<IntType>::error();
+    }
+    if (consumed != nullptr) {
+        *consumed = index;
+    }
+    return StatusResult<IntType>::success(result);
+}
+
+
+/// Convert a whole view into an integer of the given type.
+///
+/// @tparam IntType The integer type for the result.
+/// @param str The view to convert.
+/// @return The result of the conversion.
+///
+template<typename IntType>
+StatusResult<IntType> toInt(const StringView &str) noexcept
+{
+    StringView::Size consumed;
+    const auto result = parseInteger<IntType>(str, &consumed);
+    if (result.hasError() || consumed != str.getLength()) {
+        return StatusResult<IntType>::error();
+    }
+    return result;
+}
+
+
+}
+
+
+StatusResult<uint32_t> StringView::toUInt32() const noexcept
+{
+    return toInt<uint32_t>(*this);
+}
+
+
+StatusResult<int32_t> StringView::toInt32() const noexcept
+{
+    return toInt<int32_t>(*this);
+}
+
+
+StatusResult<uint16_t> StringView::toUInt16() const noexcept
+{
+    return toInt<uint16_t>(*this);
+}
+
+
+StatusResult<int16_t> StringView::toInt16() const noexcept
+{
+    return toInt<int16_t>(*this);
+}
+
+
+StatusResult<uint8_t> StringView::toUInt8() const noexcept
+{
+    return toInt<uint8_t>(*this);
+}
+
+
+StatusResult<int8_t> StringView::toInt8() const noexcept
+{
+    return toInt<int8_t>(*this);
+}
+
+
+StatusResult<uint32_t> StringView::parseUInt32(StringView::Size *consumed) const noexcept
+{
+    return parseInteger<uint32_t>(*this, consumed);
+}
+
+
+StatusResult<int32_t> StringView::parseInt32(StringView::Size *consumed) const noexcept
+{
+    return parseInteger<int32_t>(*this, consumed);
+}
+
+
+StatusResult<uint16_t> StringView::parseUInt16(StringView::Size *consumed) const noexcept
+{
+    return parseInteger<uint16_t>(*this, consumed);
+}
+
+
+StatusResult<int16_t> StringView::parseInt16(StringView::Size *consumed) const noexcept
+{
+    return parseInteger<int16_t>(*this, consumed);
+}
+
+
+StatusResult<uint8_t> StringView::parseUInt8(StringView::Size *consumed) const noexcept
+{
+    return parseInteger<uint8_t>(*this, consumed);
+}
+
+
+StatusResult<int8_t> StringView::parseInt8(StringView::Size *consumed) const noexcept
+{
+    return parseInteger<int8_t>(*this, consumed);
+}
+
+
+}
+
@@ -0,0 +1,228 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+
+#include "StatusTools.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+
+namespace lr {
+
+
+class String;
+
+
+/// A non-owning view to a sequence of characters.
+///
+/// A view is just a pointer and a length. It does not copy the characters, therefore
+/// the viewed data has to stay valid and unchanged as long the view is used. The viewed
+/// characters do not need a zero byte at the end.
+///
+/// Use views to search, slice and parse strings or buffers without any heap allocation.
+/// A `String` converts implicitly into a view.
+///
+class StringView
+{
+public:
+    /// The size type for the view.
+    ///
+    using Size = uint16_t;
+
+    /// The value if an index was not found.
+    ///
+    constexpr static Size notFound = std::numeric_limits<Size>::max();
+
+public:
+    /// Create an empty view.
+    ///
+    constexpr StringView() noexcept : _data(""), _length(0) {}
+
+    /// Create a view for a zero terminated string.
+    ///
+    /// This constructor is not explicit, to allow passing string literals as views.
+    ///
+    /// @param str The string to view. This string has to end in a zero byte. A `nullptr` creates an empty view.
+    ///
+    constexpr StringView(const char *str) noexcept
+        : _data(str != nullptr ? str : ""), _length(str != nullptr ? getStringLength(str) : 0) {}
+
+    /// Create a view for the given characters.
+    ///
+    /// @param data A pointer to the first character.
+    /// @param length The number of characters.
+    ///
+    constexpr StringView(const char *data, Size length) noexcept : _data(data), _length(length) {}
+
+public:
+    /// Check if this view is empty.
+    ///
+    constexpr bool isEmpty() const noexcept {
+        return _length == 0;
+    }
+
+    /// Get the length of this view.
+    ///
+    constexpr Size getLength() const noexcept {
+        return _length;
+    }
+
+    /// Access the data of this view.
+    ///
+    /// The data is not terminated with a zero byte.
+    ///
+    constexpr const char* getData() const noexcept {
+        return _data;
+    }
+
+    /// Access a single character of this view.
+    ///
+    constexpr char getCharAt(Size index) const noexcept {
+        return _data[index];
+    }
+
+    /// Get the first index of the given character.
+    ///
+    /// @param c The character to search.
+    /// @param offset The offset where to start the search.
+    /// @return The first index of the character or `notFound` if the character was not found.
+    ///
+    Size getFirstIndex(char c, Size offset = 0) const noexcept;
+
+    /// Get a slice of this view.
+    ///
+    /// @param index The index position in the view.
+    /// @param length The length of the slice.
+    /// @return A view to the selected characters.
+    ///
+    StringView getSlice(Size index, Size length) const noexcept;
+
+    /// Get the tail of this view.
+    ///
+    /// @param index The start index of the tail.
+    /// @return A view from the given index to the end.
+    ///
+    StringView getTail(Size index) const noexcept;
+
+    /// Create a string with a copy of the viewed characters.
+    ///
+    String toString() const noexcept;
+
+public: // Convert the view into integers.
+    /// Convert this view into an integer.
+    ///
+    /// The whole view has to be a number in the format accepted by `parseInt8()`.
+    ///
+    /// @return The integer and the status of the conversion.
+    ///
+    StatusResult<int8_t> toInt8() const noexcept;
+    StatusResult<uint8_t> toUInt8() const noexcept; ///< @copydoc StringView::toInt8()
+    StatusResult<int16_t> toInt16() const noexcept; ///< @copydoc StringView::toInt8()
+    StatusResult<uint16_t> toUInt16() const noexcept; ///< @copydoc StringView::toInt8()
+    StatusResult<int32_t> toInt32() const noexcept; ///< @copydoc StringView::toInt8()
+    StatusResult<uint32_t> toUInt32() const noexcept; ///< @copydoc StringView::toInt8()
+
+    /// Parse an integer at the start of this view.
+    ///
+    /// The number is parsed in a single pass, until the first character which is not a digit.
+    /// It starts with an optional `-` sign, which is only accepted for signed types. An `0x` or `0b`
+    /// prefix selects hex or binary digits, matching the output of `String::appendHex()` and
+    /// `String::appendBin()`. All other numbers are decimal.
+    ///
+    /// Use the consumed count to parse multiple fields from one buffer, without slicing.
+    ///
+    /// @param consumed An optional pointer to a variable to store the number of consumed
+    ///     characters. Zero if the conversion fails.
+    /// @return The integer and the status of the conversion. An error is returned if there are no
+    ///     digits or the number does not fit into the integer type.
+    ///
+    StatusResult<int8_t> parseInt8(Size *consumed = nullptr) const noexcept;
+    StatusResult<uint8_t> parseUInt8(Size *consumed = nullptr) const noexcept; ///< @copydoc StringView::parseInt8()
+    StatusResult<int16_t> parseInt16(Size *consumed = nullptr) const noexcept; ///< @copydoc StringView::parseInt8()
+    StatusResult<uint16_t> parseUInt16(Size *consumed = nullptr) const noexcept; ///< @copydoc StringView::parseInt8()
+    StatusResult<int32_t> parseInt32(Size *consumed = nullptr) const noexcept; ///< @copydoc StringView::parseInt8()
+    StatusResult<uint32_t> parseUInt32(Size *consumed = nullptr) const noexcept; ///< @copydoc StringView::parseInt8()
+
+public:
+    /// Compare two views.
+    ///
+    /// @return A negative value, zero or a positive value, like `strcmp`.
+    ///
+    int compare(const StringView &other) const noexcept;
+
+private:
+    /// Get the length of a zero terminated string, usable in constant expressions.
+    ///
+    constexpr static Size getStringLength(const char *str) noexcept {
+        Size length = 0;
+        while (str[length] != '\0') {
+            ++length;
+        }
+        return length;
+    }
+
+private:
+    const char *_data; ///< The first viewed character.
+    Size _length; ///< The number of viewed characters.
+};
+
+
+/// Compare two views.
+///
+inline bool operator==(const StringView &a, const StringView &b) noexcept {
+    return a.getLength() == b.getLength() && std::memcmp(a.getData(), b.getData(), a.getLength()) == 0;
+}
+
+/// Compare two views.
+///
+inline bool operator!=(const StringView &a, const StringView &b) noexcept {
+    return !(a == b);
+}
+
+/// Compare two views.
+///
+inline bool operator<(const StringView &a, const StringView &b) noexcept {
+    return a.compare(b) < 0;
+}
+
+/// Compare two views.
+///
+inline bool operator<=(const StringView &a, const StringView &b) noexcept {
+    return a.compare(b) <= 0;
+}
+
+/// Compare two views.
+///
+inline bool operator>(const StringView &a, const StringView &b) noexcept {
+    return a.compare(b) > 0;
+}
+
+/// Compare two views.
+///
+inline bool operator>=(const StringView &a, const StringView &b) noexcept {
+    return a.compare(b) >= 0;
+}
+
+
+}
+
+
@@ -0,0 +1,75 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+
+#include "StringView.hpp"
+
+
+namespace lr {
+
+
+/// A tool to split a string into tokens, without copies.
+///
+/// In contrast to `StringTokenizer`, this tokenizer does not copy the processed string and
+/// all tokens are views into the original data. Therefore no memory is allocated at all, but
+/// the processed data has to stay valid and unchanged as long the tokenizer and the returned
+/// tokens are used.
+///
+class StringViewTokenizer
+{
+public:
+    /// Create a new tokenizer for the given data.
+    ///
+    /// @param str The data to process.
+    /// @param separator The token separator.
+    ///
+    StringViewTokenizer(StringView str, char separator) noexcept;
+
+public:
+    /// Check if there is a next token.
+    ///
+    /// @return `true` if there is a next token.
+    ///
+    bool hasNextToken() const noexcept;
+
+    /// Get the next token.
+    ///
+    /// Subsequent separators are skipped. The view may be empty if the data ends with separators.
+    ///
+    /// @return A view to the next token.
+    ///
+    StringView getNextToken() noexcept;
+
+    /// Get the current tail of the data from the current position to the end.
+    ///
+    /// @return A view to the tail of the data.
+    ///
+    StringView getTail() const noexcept;
+
+private:
+    const StringView _string; ///< The data to process.
+    const char _separator; ///< The separator.
+    StringView::Size _currentOffset; ///< The current position.
+};
+
+
+}
+
+
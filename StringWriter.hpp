@@ -54,6 +54,18 @@ public:
     ///
     virtual Status write(const char *text) = 0;
 
+    /// Write a number of characters.
+    ///
+    /// The default implementation creates a `String` and calls `write(const String&)`.
+    /// Implementations should override this method to write the characters directly.
+    ///
+    /// @param text A pointer to the characters to write, which does not need to be null terminated.
+    /// @param length The number of characters to write.
+    ///
+    virtual Status write(const char *text, uint16_t length) {
+        return write(String(text, length));
+    }
+
     /// Write the given text with a line end.
     ///
     /// @param text The string to write.
@@ -43,12 +43,74 @@ namespace Timer {
 ///
 Milliseconds tickMilliseconds();
 
+/// Get the current high resolution timer counter tick.
+///
+/// This tick count infinitely from zero to the end of the 32bit value,
+/// which wraps around after about 71 minutes. The counter has to be
+/// monotonic and keep running while the platform sleeps.
+///
+/// On Cortex-M platforms, this is usually implemented using a hardware
+/// timer, or the DWT cycle counter combined with the millisecond tick.
+///
+/// @return The tick count in microseconds.
+///
+Microseconds tickMicroseconds();
+
+/// Get the current CPU cycle counter.
+///
+/// This counter runs with the core clock and wraps around at the end of the 32bit value.
+/// On Cortex-M3 and later, this is the `CYCCNT` register of the DWT unit. The counter
+/// may stop while the platform sleeps, so use it only to measure short code sections.
+///
+/// @return The number of CPU cycles.
+///
+uint32_t tickCycles();
+
+/// Get the current tick for a given duration unit.
+///
+/// Only the units with a real tick counter are supported, which are the
+/// milliseconds and microseconds. Converting a counter to another unit
+/// would break the wraparound at the end of the 32bit value.
+///
+/// @tparam Ratio The ratio of the duration.
+/// @return The tick count.
+///
+template<typename Ratio>
+inline Duration<Ratio> tick() {
+    static_assert(sizeof(Ratio) == 0, "There is no tick counter for this unit.");
+    return Duration<Ratio>();
+}
+
+template<>
+inline Milliseconds tick<std::milli>() {
+    return tickMilliseconds();
+}
+
+template<>
+inline Microseconds tick<std::micro>() {
+    return tickMicroseconds();
+}
+
 /// Wait for the next tick.
 ///
 /// This function will wait for the next tick of the real time counter.
 ///
 void waitForNextTick();
 
+/// Sleep until the given tick time or until an interrupt occurs.
+///
+/// This function puts the platform into a low power mode until the real time counter
+/// reaches `time`, or any interrupt wakes the platform up. It is used by the event
+/// loop in tickless idle mode, to avoid waking up every millisecond.
+///
+/// The implementation must not miss an interrupt which occurs just before the call,
+/// e.g. by using the `WFE` instruction on ARM platforms. Platforms without a low power mode
+/// can implement this function by calling `waitForNextTick()`.
+///
+/// @param time The tick time in milliseconds to wake up.
+///
+void sleepUntil(Milliseconds time);
+
 /// Wait a number of milliseconds.
 ///
 /// @param milliseconds The number of milliseconds to wait.
@@ -88,91 +150,174 @@ inline void delay<std::nano>(const Nanoseconds &nanoseconds) {
     delayMicroseconds(nanoseconds.toMicroseconds().ticks());
 }
 
-/// A simple timer to measure elapsed time in milliseconds.
+/// A simple timer to measure elapsed time.
 ///
 /// This timer only works up the resolution of the 32bit value, which
-/// is 596 hours or 24 days. This class should be only used for very
-/// short time measurements.
+/// is 596 hours or 24 days for milliseconds, and 71 minutes for
+/// microseconds. This class should be only used for very short time
+/// measurements.
+///
+/// @tparam Ratio The ratio of the duration, `std::milli` or `std::micro`.
 ///
-class Elapsed
+template<typename Ratio>
+class BasicElapsed
 {
+public:
+    /// The duration type used by this timer.
+    ///
+    using DurationType = Duration<Ratio>;
+
 public:
     /// Create a new elapsed timer which starts at the point of construction.
     ///
-    inline Elapsed()
-        : _startTime(tickMilliseconds())
+    inline BasicElapsed()
+        : _startTime(tick<Ratio>())
     {
     }
     
     /// Restart the timer.
     ///
     inline void restart() {
-        _startTime = tickMilliseconds();
+        _startTime = tick<Ratio>();
     }
     
-    /// Check the number of elapsed milliseconds since start.
+    /// Check the elapsed time since start.
     ///
-    /// @return The number of elapsed milliseconds.
+    /// @return The elapsed time.
     ///
-    inline Milliseconds elapsedTime() const {
-        return tickMilliseconds()-_startTime;
+    inline DurationType elapsedTime() const {
+        return tick<Ratio>()-_startTime;
     }
 
-    /// Check if a function run into a time-out after the given number of milliseconds.
+    /// Check if a function run into a time-out after the given time.
     ///
     /// If you just check for a time-out, try the `Deadline` class.
     /// The time-out is limited to the resolution of the 32bit value. Therefore
-    /// after 596 hours or 24 days the timeout "resets".
+    /// after the counter wrapped around, the timeout "resets".
     ///
     /// @return `true` if the timeout was reached.
     ///
-    inline bool hasTimeout(const Milliseconds timeout) const {
+    inline bool hasTimeout(const DurationType timeout) const {
         return elapsedTime() >= timeout;
     }
 
 private:
-    Milliseconds _startTime; ///< The start time.
+    DurationType _startTime; ///< The start time.
 };
 
 
-/// A simple timer to check a timeout in milliseconds.
+/// A simple timer to check a timeout.
 ///
-/// This timer only works up the resolution of the 32bit value, which
-/// is 596 hours or 24 days. This class should be only used for very
-/// short time measurements.
+/// This timer only works up the resolution of the 32bit value. The timeout
+/// has to be shorter than half of the counter range, which is 298 hours for
+/// milliseconds and 35 minutes for microseconds.
+///
+/// @tparam Ratio The ratio of the duration, `std::milli` or `std::micro`.
 ///
-class Deadline
+template<typename Ratio>
+class BasicDeadline
 {
+public:
+    /// The duration type used by this timer.
+    ///
+    using DurationType = Duration<Ratio>;
+
 public:
     /// Create a new deadline timer with a given timeout.
     ///
-    /// @param timeout in milliseconds.
+    /// @param timeout The timeout.
     ///
-    inline Deadline(const Milliseconds timeout) noexcept
-        : _endTime(tickMilliseconds()+timeout)
+    inline BasicDeadline(const DurationType timeout) noexcept
+        : _endTime(tick<Ratio>()+timeout)
     {
     }
     
     /// Restart the timer.
     ///
-    inline void restart(const Milliseconds timeout) noexcept {
-        _endTime = (tickMilliseconds()+timeout);
+    inline void restart(const DurationType timeout) noexcept {
+        _endTime = (tick<Ratio>()+timeout);
     }
 
     /// Check if this timer has expired.
     ///
     inline bool hasTimeout() const noexcept {
-        return tickMilliseconds().deltaTo(_endTime) <= 0;
+        return tick<Ratio>().deltaTo(_endTime) <= 0;
     }
 
     /// Check if the timer is still in time.
     ///
     inline bool isInTime() const noexcept {
-        return tickMilliseconds().deltaTo(_endTime) > 0;
+        return tick<Ratio>().deltaTo(_endTime) > 0;
+    }
+
+private:
+    DurationType _endTime; ///< The end time.
+};
+
+
+/// A timer to measure elapsed time in milliseconds.
+///
+using Elapsed = BasicElapsed<std::milli>;
+
+/// A timer to measure elapsed time in microseconds.
+///
+using MicrosecondElapsed = BasicElapsed<std::micro>;
+
+/// A timer to check a timeout in milliseconds.
+///
+using Deadline = BasicDeadline<std::milli>;
+
+/// A timer to check a timeout in microseconds.
+///
+using MicrosecondDeadline = BasicDeadline<std::micro>;
+
+
+/// A timer to measure the time spent in a scope.
+///
+/// The timer starts at the point of construction, and stores the elapsed
+/// time in the given variable when it is destroyed:
+///
+/// ```
+/// Microseconds gHandlerTime;
+///
+/// void onInterrupt() {
+///     Timer::ScopedTimer<std::micro> timer(gHandlerTime);
+///     // ...
+/// }
+/// ```
+///
+/// @tparam Ratio The ratio of the duration, `std::milli` or `std::micro`.
+///
+template<typename Ratio = std::micro>
+class ScopedTimer
+{
+public:
+    /// Start a new scoped timer.
+    ///
+    /// @param[out] result The variable to store the elapsed time.
+    ///
+    inline explicit ScopedTimer(Duration<Ratio> &result)
+        : _result(result), _elapsed()
+    {
+    }
+
+    /// Store the elapsed time.
+    ///
+    inline ~ScopedTimer() {
+        _result = _elapsed.elapsedTime();
     }
 
+    /// Scoped timers can not be copied, because they refer to their result.
+    ///
+    ScopedTimer(const ScopedTimer&) = delete;
+
+    /// Scoped timers can not be assigned, because they refer to their result.
+    ///
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
 private:
-    Milliseconds _endTime; ///< The end time.
+    Duration<Ratio> &_result; ///< The variable to store the elapsed time.
+    BasicElapsed<Ratio> _elapsed; ///< The timer for the measurement.
 };
 
 
@@ -29,7 +29,7 @@ namespace lr {
 /// Use this class to store date/time values from from 2000-01-01 00:00:00
 /// up to 2136-02-07 06:28:15 in a compact 32bit value.
 ///
-/// This class can also be used to do limited and slow time calculations in 32bit precision.
+/// This class can also be used to do limited time calculations in 32bit precision.
 ///
 /// The timestamp 0 equals 2000-01-01 00:00:00.
 ///
@@ -42,7 +42,7 @@ public:
 
     /// Create a timestamp from the given `DateTime` object.
     ///
-    /// This is a slow operation, optimized for memory.
+    /// The conversion is done in constant time, without any loops.
     ///
     /// It only works with dates from 2000-01-01 00:00:00 up to 2136-02-07 06:28:15 due the 32bit precision of the
     /// calculation used.
@@ -91,7 +91,7 @@ private:
 ///
 /// This timestamp will work with the full range of dates from 2000-01-01 up to 9999-12-31.
 ///
-/// This class can also be used to do limited and slow time calculations in 64bit precision.
+/// This class can also be used to do limited time calculations in 64bit precision.
 ///
 /// The timestamp 0 equals 2000-01-01 00:00:00.
 ///
@@ -104,7 +104,7 @@ public:
 
     /// Create a timestamp from the given `DateTime` object.
     ///
-    /// This is a slow operation, optimized for memory.
+    /// The conversion is done in constant time, without any loops.
     ///
     /// It only works with dates from 2000-01-01 00:00:00 up to 2136-02-07 06:28:15 due the 32bit precision of the
     /// calculation used.
@@ -20,6 +20,8 @@
 
 #include "WireMaster.hpp"
 
+#include <initializer_list>
+
 
 namespace lr {
 
@@ -35,6 +37,58 @@ public:
     using BitResult = WireMaster::BitResult;
     using Status = WireMaster::Status;
 
+    /// The policy how the shadow copy of a register is used.
+    ///
+    /// @see WireMasterRegisterChip
+    ///
+    enum class RegisterPolicy : uint8_t {
+        Volatile, ///< The register can change on the chip and is always read from the bus.
+        Cacheable, ///< The register only changes if written, so reads can be served from the shadow copy.
+        WriteOnly, ///< The register can not be read, all reads are served from the shadow copy.
+    };
+
+    /// A single 8bit register to read in a batch.
+    ///
+    struct RegisterRead {
+        /// Create an empty entry.
+        ///
+        constexpr RegisterRead() : reg(0), value(nullptr) {}
+
+        /// Create a new entry.
+        ///
+        /// @param[in] reg The register address, or a register enum value.
+        /// @param[out] value The variable to store the register value.
+        ///
+        template<typename Reg>
+        constexpr RegisterRead(const Reg reg, uint8_t *value) : reg(static_cast<uint8_t>(reg)), value(value) {}
+
+        uint8_t reg; ///< The register to read.
+        uint8_t *value; ///< The variable to store the register value.
+    };
+
+    /// A single 8bit register to write in a batch.
+    ///
+    struct RegisterWrite {
+        /// Create an empty entry.
+        ///
+        constexpr RegisterWrite() : reg(0), value(0) {}
+
+        /// Create a new entry.
+        ///
+        /// @param[in] reg The register address, or a register enum value.
+        /// @param[in] value The value to write.
+        ///
+        template<typename Reg>
+        constexpr RegisterWrite(const Reg reg, const uint8_t value) : reg(static_cast<uint8_t>(reg)), value(value) {}
+
+        uint8_t reg; ///< The register to write into.
+        uint8_t value; ///< The value to write.
+    };
+
+    /// The maximum number of registers merged into one burst.
+    ///
+    constexpr static uint8_t cMaximumBurstSize = 16;
+
 public:
     /// Create a new instance of the chip acess.
     ///
@@ -46,6 +100,13 @@ public:
     {
     }
 
+public:
+    /// Get the address of the chip.
+    ///
+    inline uint8_t getAddress() const {
+        return _address;
+    }
+
 public: // Wrapper around the native bus functions.
     /// Begin writing to the chip.
     ///
@@ -240,6 +301,96 @@ public:
         return writeRegisterData(static_cast<uint8_t>(reg), data, static_cast<uint8_t>(4));
     }
 
+public: // Batch operations.
+    /// Read a batch of 8bit registers.
+    ///
+    /// Entries with sequential register addresses are merged into a single burst, using the auto-increment
+    /// of the chip. For an entry list `{0x10, 0x11, 0x12, 0x20}` only two transactions are sent on the bus:
+    ///
+    /// ```
+    /// [S][address+W][0x10][Sr][address+R][data 0x10][data 0x11][data 0x12][P]
+    /// [S][address+W][0x20][Sr][address+R][data 0x20][P]
+    /// ```
+    ///
+    /// The registers are read in the given order, so order the entries by address to get the longest bursts.
+    /// Only use this method with chips which automatically increment the register address.
+    ///
+    /// @param[in] reads The registers to read.
+    /// @param[in] count The number of entries.
+    /// @return The status of the operation. See [Status](@ref WireMaster::Status) for details.
+    ///     The batch stops at the first failed transaction.
+    ///
+    inline Status readRegisters(const RegisterRead *reads, const uint8_t count) const {
+        uint8_t data[cMaximumBurstSize];
+        for (uint8_t index = 0; index < count;) {
+            const auto burstSize = getBurstSize(reads + index, count - index);
+            const auto status = readRegisterData(reads[index].reg, data, burstSize);
+            if (status != Status::Success) {
+                return status;
+            }
+            for (uint8_t i = 0; i < burstSize; ++i) {
+                *reads[index + i].value = data[i];
+            }
+            index += burstSize;
+        }
+        return Status::Success;
+    }
+
+    /// @copydoc WireMasterChip::readRegisters(const RegisterRead*, const uint8_t)
+    inline Status readRegisters(std::initializer_list<RegisterRead> reads) const {
+        return readRegisters(reads.begin(), static_cast<uint8_t>(reads.size()));
+    }
+
+    /// Write a batch of 8bit registers.
+    ///
+    /// Entries with sequential register addresses are merged into a single burst, using the auto-increment
+    /// of the chip. The registers are written in the given order, which makes this method a good fit for
+    /// initialisation sequences. Only use this method with chips which automatically increment the
+    /// register address.
+    ///
+    /// @param[in] writes The registers to write.
+    /// @param[in] count The number of entries.
+    /// @return The status of the operation. See [Status](@ref WireMaster::Status) for details.
+    ///     The batch stops at the first failed transaction.
+    ///
+    inline Status writeRegisters(const RegisterWrite *writes, const uint8_t count) const {
+        uint8_t data[cMaximumBurstSize];
+        for (uint8_t index = 0; index < count;) {
+            const auto burstSize = getBurstSize(writes + index, count - index);
+            for (uint8_t i = 0; i < burstSize; ++i) {
+                data[i] = writes[index + i].value;
+            }
+            const auto status = writeRegisterData(writes[index].reg, data, burstSize);
+            if (status != Status::Success) {
+                return status;
+            }
+            index += burstSize;
+        }
+        return Status::Success;
+    }
+
+    /// @copydoc WireMasterChip::writeRegisters(const RegisterWrite*, const uint8_t)
+    inline Status writeRegisters(std::initializer_list<RegisterWrite> writes) const {
+        return writeRegisters(writes.begin(), static_cast<uint8_t>(writes.size()));
+    }
+
+protected:
+    /// Get the number of entries with sequential register addresses.
+    ///
+    /// @param[in] entries The entries, starting with the first one of the burst.
+    /// @param[in] count The number of remaining entries, at least one.
+    /// @return The number of entries in the burst, limited to `cMaximumBurstSize`.
+    ///
+    template<typename Entry>
+    inline static uint8_t getBurstSize(const Entry *entries, const uint8_t count) {
+        uint8_t burstSize = 1;
+        while (burstSize < count && burstSize < cMaximumBurstSize
+                && entries[burstSize].reg == entries[0].reg + burstSize) {
+            ++burstSize;
+        }
+        return burstSize;
+    }
+
 protected:
     /// Write masked bits to a register.
     ///
@@ -264,12 +415,11 @@ protected:
         if (status != Status::Success) {
             return status;
         }
-        if ((data&bitMask)==(value&bitMask)) {
+        const auto newData = getMaskedBits(data, bitMask, value);
+        if (data == newData) {
             return Status::Success;
         }
-        data &= (~bitMask);
-        data |= (value&bitMask);
-        return writeRegister(reg, data);
+        return writeRegister(reg, newData);
     }
 
     /// Template to test a number of bits.
@@ -290,14 +440,7 @@ protected:
         if (status != Status::Success) {
             return status;
         }
-        const auto maskedBits = (value&bitMask);
-        if (maskedBits == 0) {
-            bitResult = BitResult::Zero;
-        } else if (maskedBits == bitMask) {
-            bitResult = BitResult::Set;
-        } else {
-            bitResult = BitResult::Mixed;
-        }
+        bitResult = getBitResult(value, bitMask);
         return Status::Success;
     }
 
@@ -319,12 +462,7 @@ protected:
         if (status != Status::Success) {
             return status;
         }
-        Value newData = data;
-        switch (bitOperation) {
-        case BitOperation::Set: newData |= bitMask; break;
-        case BitOperation::Clear: newData &= (~bitMask); break;
-        case BitOperation::Flip: newData ^= bitMask; break;
-        }
+        const auto newData = getChangedBits(data, bitMask, bitOperation);
         if (data != newData) {
             return writeRegister(reg, newData);
         } else {
@@ -332,6 +470,52 @@ protected:
         }
     }
 
+    /// Apply masked bits to a register value.
+    ///
+    /// @param[in] data The current value of the register.
+    /// @param[in] bitMask The mask to select the bits to change.
+    /// @param[in] value The value with the new bits.
+    /// @return The new value for the register.
+    ///
+    template<typename Value>
+    constexpr static Value getMaskedBits(const Value data, const Value bitMask, const Value value) {
+        return static_cast<Value>((data&(~bitMask))|(value&bitMask));
+    }
+
+    /// Apply a bit operation to a register value.
+    ///
+    /// @param[in] data The current value of the register.
+    /// @param[in] bitMask The mask which bits to address.
+    /// @param[in] bitOperation How the masked bits shall be modified.
+    /// @return The new value for the register.
+    ///
+    template<typename Value>
+    constexpr static Value getChangedBits(const Value data, const Value bitMask, const BitOperation bitOperation) {
+        switch (bitOperation) {
+        case BitOperation::Set: return static_cast<Value>(data|bitMask);
+        case BitOperation::Clear: return static_cast<Value>(data&(~bitMask));
+        case BitOperation::Flip: return static_cast<Value>(data^bitMask);
+        }
+        return data;
+    }
+
+    /// Test masked bits of a register value.
+    ///
+    /// @param[in] value The value of the register.
+    /// @param[in] bitMask The mask for the bits to test.
+    /// @return The result of the test.
+    ///
+    template<typename Value>
+    constexpr static BitResult getBitResult(const Value value, const Value bitMask) {
+        const auto maskedBits = (value&bitMask);
+        if (maskedBits == 0) {
+            return BitResult::Zero;
+        } else if (maskedBits == bitMask) {
+            return BitResult::Set;
+        }
+        return BitResult::Mixed;
+    }
+
 public:
     /// @copydoc WireMasterChip::writeBitsTemplate()
     inline Status writeBits(const uint8_t reg, const uint8_t bitMask, const uint8_t value) const {
@@ -20,6 +20,8 @@
 
 #include "WireMasterChip.hpp"
 
+#include <array>
+
 
 namespace lr {
 
@@ -31,10 +33,23 @@ namespace lr {
 /// registers and provide a set of simple read/write operations to this
 /// registers.
 ///
+/// Optionally, the class keeps a shadow copy of the first `shadowSize` registers. Each register
+/// has a policy which is `RegisterPolicy::Volatile` by default, so the shadow copy is not used until
+/// you call `setRegisterPolicy()`. For cacheable and write-only registers, `writeBits()`, `changeBits()`
+/// and `testBits()` use the shadow copy instead of reading the register over the bus. Masked writes
+/// therefore only cost a single write transaction, or no transaction at all if nothing changes.
+///
+/// The shadow copy is updated by each write and read using the register enum. Reading a write-only
+/// register returns its shadow copy, without accessing the bus. If a register is accessed using its
+/// numeric address, or changed in another way (e.g. by a chip reset), call `invalidate()` or `refresh()`
+/// to bring the shadow copy back in sync.
+///
 /// @tparam Register The enum with the register definitions.
 ///     This enum has to be the underlying type of an uint8_t.
+/// @tparam shadowSize The number of registers, starting at address zero, with a shadow copy.
+///     The default of zero disables the shadow copy without any memory overhead.
 ///
-template<typename Register>
+template<typename Register, uint8_t shadowSize = 0>
 class WireMasterRegisterChip : public WireMasterChip
 {
 public:
@@ -46,7 +61,7 @@ public:
     /// @param[in] bus The pointer to the bus to use.
     /// @param[in] address The address of the chip.
     ///
-    WireMasterRegisterChip(WireMaster *bus, uint8_t address) : WireMasterChip(bus, address) {}
+    WireMasterRegisterChip(WireMaster *bus, uint8_t address) : WireMasterChip(bus, address), _shadows() {}
     
 public: // Get all functions from the superclass
     using WireMasterChip::readRegisterData;
@@ -64,70 +79,438 @@ public: // Wrapper functions to use the enum as register.
     }
     /// @copydoc WireMasterChip::readRegisterData(const uint8_t, uint8_t&)
     inline Status readRegister(const Register reg, uint8_t &data) const {
-        return WireMasterChip::readRegister(static_cast<const uint8_t>(reg), data);
+        return readRegisterTemplate<uint8_t>(reg, data);
     }
     /// @copydoc WireMasterChip::readRegisterData(const uint8_t, uint16_t&)
     inline Status readRegister(const Register reg, uint16_t &value) const {
-        return WireMasterChip::readRegister(static_cast<const uint8_t>(reg), value);
+        return readRegisterTemplate<uint16_t>(reg, value);
     }
     /// @copydoc WireMasterChip::readRegisterData(const uint8_t, uint32_t&)
     inline Status readRegister(const Register reg, uint32_t &value) const {
-        return WireMasterChip::readRegister(static_cast<const uint8_t>(reg), value);
+        return readRegisterTemplate<uint32_t>(reg, value);
     }
     /// @copydoc WireMasterChip::writeRegisterData(const uint8_t, const uint8_t*, const uint8_t)
+    ///
+    /// The shadow copies of all registers in the written range are invalidated.
+    ///
     inline Status writeRegisterData(const Register reg, const uint8_t *data, const uint8_t count) const {
+        invalidateRange(static_cast<uint8_t>(reg), count);
         return WireMasterChip::writeRegisterData(static_cast<const uint8_t>(reg), data, count);
     }
     /// @copydoc WireMasterChip::writeRegisterData(const uint8_t, const uint8_t)
     inline Status writeRegister(const Register reg, const uint8_t data) const {
-        return WireMasterChip::writeRegister(static_cast<const uint8_t>(reg), data);
+        return writeRegisterTemplate<uint8_t>(reg, data);
     }
     /// @copydoc WireMasterChip::writeRegisterData(const uint8_t, const uint16_t)
     inline Status writeRegister(const Register reg, const uint16_t value) const {
-        return WireMasterChip::writeRegister(static_cast<const uint8_t>(reg), value);
+        return writeRegisterTemplate<uint16_t>(reg, value);
     }
     /// @copydoc WireMasterChip::writeRegisterData(const uint8_t, const uint32_t)
     inline Status writeRegister(const Register reg, const uint32_t value) const {
-        return WireMasterChip::writeRegister(static_cast<const uint8_t>(reg), value);
+        return writeRegisterTemplate<uint32_t>(reg, value);
     }
 
 public:
     /// @copydoc WireMasterChip::writeBitsTemplate()
     inline Status writeBits(const Register reg, const uint8_t bitMask, const uint8_t value) const {
-        return writeBitsTemplate<uint8_t>(static_cast<uint8_t>(reg), bitMask, value);
+        return writeBitsShadowTemplate<uint8_t>(reg, bitMask, value);
     }
     /// @copydoc WireMasterChip::writeBitsTemplate()
     inline Status writeBits(const Register reg, const uint16_t bitMask, const uint16_t value) const {
-        return writeBitsTemplate<uint16_t>(static_cast<uint8_t>(reg), bitMask, value);
+        return writeBitsShadowTemplate<uint16_t>(reg, bitMask, value);
     }
     /// @copydoc WireMasterChip::writeBitsTemplate()
     inline Status writeBits(const Register reg, const uint32_t bitMask, const uint32_t value) const {
-        return writeBitsTemplate<uint32_t>(static_cast<uint8_t>(reg), bitMask, value);
+        return writeBitsShadowTemplate<uint32_t>(reg, bitMask, value);
     }
     /// @copydoc WireMasterChip::testBitsTemplate()
     inline Status testBits(const Register reg, const uint8_t bitMask, BitResult &bitResult) const {
-        return testBitsTemplate<uint8_t>(static_cast<uint8_t>(reg), bitMask, bitResult);
+        return testBitsShadowTemplate<uint8_t>(reg, bitMask, bitResult);
     }
     /// @copydoc WireMasterChip::testBitsTemplate()
     inline Status testBits(const Register reg, const uint16_t bitMask, BitResult &bitResult) const {
-        return testBitsTemplate<uint16_t>(static_cast<uint8_t>(reg), bitMask, bitResult);
+        return testBitsShadowTemplate<uint16_t>(reg, bitMask, bitResult);
     }
     /// @copydoc WireMasterChip::testBitsTemplate()
     inline Status testBits(const Register reg, const uint32_t bitMask, BitResult &bitResult) const {
-        return testBitsTemplate<uint32_t>(static_cast<uint8_t>(reg), bitMask, bitResult);
+        return testBitsShadowTemplate<uint32_t>(reg, bitMask, bitResult);
     }
     /// @copydoc WireMasterChip::changeBitsTemplate()
     inline Status changeBits(const Register reg, const uint8_t bitMask, const BitOperation bitOperation) const {
-        return changeBitsTemplate<uint8_t>(static_cast<uint8_t>(reg), bitMask, bitOperation);
+        return changeBitsShadowTemplate<uint8_t>(reg, bitMask, bitOperation);
     }
     /// @copydoc WireMasterChip::changeBitsTemplate()
     inline Status changeBits(const Register reg, const uint16_t bitMask, const BitOperation bitOperation) const {
-        return changeBitsTemplate<uint16_t>(static_cast<uint8_t>(reg), bitMask, bitOperation);
+        return changeBitsShadowTemplate<uint16_t>(reg, bitMask, bitOperation);
     }
     /// @copydoc WireMasterChip::changeBitsTemplate()
     inline Status changeBits(const Register reg, const uint32_t bitMask, const BitOperation bitOperation) const {
-        return changeBitsTemplate<uint32_t>(static_cast<uint8_t>(reg), bitMask, bitOperation);
+        return changeBitsShadowTemplate<uint32_t>(reg, bitMask, bitOperation);
+    }
+
+public: // Batch operations.
+    /// @copydoc WireMasterChip::readRegisters(const RegisterRead*, const uint8_t)
+    ///
+    /// The shadow copies of all read registers are updated. Write-only registers are never read
+    /// from the chip, their shadow copy is returned instead.
+    ///
+    inline Status readRegisters(const RegisterRead *reads, const uint8_t count) const {
+        if constexpr (shadowSize == 0) {
+            return WireMasterChip::readRegisters(reads, count);
+        }
+        Status status = Status::Success;
+        RegisterRead chipReads[cMaximumBurstSize];
+        uint8_t chipReadCount = 0;
+        for (uint8_t i = 0; i < count; ++i) {
+            const auto shadow = getShadow(static_cast<Register>(reads[i].reg));
+            if (shadow != nullptr && shadow->policy == RegisterPolicy::WriteOnly) {
+                updateStatus(status, readShadow(*shadow, *reads[i].value));
+                continue;
+            }
+            chipReads[chipReadCount++] = reads[i];
+            if (chipReadCount == cMaximumBurstSize) {
+                updateStatus(status, readChipRegisters(chipReads, chipReadCount));
+                chipReadCount = 0;
+            }
+        }
+        if (chipReadCount > 0) {
+            updateStatus(status, readChipRegisters(chipReads, chipReadCount));
+        }
+        return status;
+    }
+
+    /// @copydoc WireMasterRegisterChip::readRegisters(const RegisterRead*, const uint8_t)
+    inline Status readRegisters(std::initializer_list<RegisterRead> reads) const {
+        return readRegisters(reads.begin(), static_cast<uint8_t>(reads.size()));
+    }
+
+    /// @copydoc WireMasterChip::writeRegisters(const RegisterWrite*, const uint8_t)
+    ///
+    /// The shadow copies of all written registers are updated. If the batch fails, the
+    /// shadow copies of all registers in the batch are invalidated.
+    ///
+    inline Status writeRegisters(const RegisterWrite *writes, const uint8_t count) const {
+        const auto status = WireMasterChip::writeRegisters(writes, count);
+        if constexpr (shadowSize > 0) {
+            for (uint8_t i = 0; i < count; ++i) {
+                if (status == Status::Success) {
+                    storeShadow<uint8_t>(static_cast<Register>(writes[i].reg), writes[i].value);
+                } else {
+                    invalidate(static_cast<Register>(writes[i].reg));
+                }
+            }
+        }
+        return status;
+    }
+
+    /// @copydoc WireMasterRegisterChip::writeRegisters(const RegisterWrite*, const uint8_t)
+    inline Status writeRegisters(std::initializer_list<RegisterWrite> writes) const {
+        return writeRegisters(writes.begin(), static_cast<uint8_t>(writes.size()));
+    }
+
+public: // Shadow copy of the registers.
+    /// Set the policy for a register.
+    ///
+    /// Changing the policy invalidates the shadow copy of the register. Registers outside
+    /// of the shadow range are always volatile and the call is ignored.
+    ///
+    /// @param[in] reg The register.
+    /// @param[in] policy The new policy for the register.
+    ///
+    inline void setRegisterPolicy(const Register reg, const RegisterPolicy policy) {
+        if (auto shadow = getShadow(reg)) {
+            shadow->policy = policy;
+            shadow->size = 0;
+        }
+    }
+
+    /// Get the policy of a register.
+    ///
+    /// @param[in] reg The register.
+    /// @return The policy of the register.
+    ///
+    inline RegisterPolicy getRegisterPolicy(const Register reg) const {
+        if (auto shadow = getShadow(reg)) {
+            return shadow->policy;
+        }
+        return RegisterPolicy::Volatile;
+    }
+
+    /// Set the shadow copy of a register without accessing the chip.
+    ///
+    /// Use this method to set the known reset value of write-only registers. Without a shadow
+    /// copy, masked writes to a write-only register fail.
+    ///
+    /// @param[in] reg The register.
+    /// @param[in] value The known value of the register.
+    ///
+    inline void setShadowValue(const Register reg, const uint8_t value) { storeShadow<uint8_t>(reg, value); }
+    /// @copydoc WireMasterRegisterChip::setShadowValue(const Register, const uint8_t)
+    inline void setShadowValue(const Register reg, const uint16_t value) { storeShadow<uint16_t>(reg, value); }
+    /// @copydoc WireMasterRegisterChip::setShadowValue(const Register, const uint8_t)
+    inline void setShadowValue(const Register reg, const uint32_t value) { storeShadow<uint32_t>(reg, value); }
+
+    /// Check if there is a valid shadow copy for a register.
+    ///
+    /// @param[in] reg The register.
+    /// @return `true` if the next masked operation on the register is served from the shadow copy.
+    ///
+    inline bool hasShadowValue(const Register reg) const {
+        const auto shadow = getShadow(reg);
+        return shadow != nullptr && shadow->policy != RegisterPolicy::Volatile && shadow->size != 0;
+    }
+
+    /// Invalidate the shadow copy of all registers.
+    ///
+    /// Write-only registers are invalidated as well, so you have to set their values again.
+    ///
+    inline void invalidate() const {
+        for (auto &shadow : _shadows) {
+            shadow.size = 0;
+        }
+    }
+
+    /// Invalidate the shadow copy of a single register.
+    ///
+    /// @param[in] reg The register.
+    ///
+    inline void invalidate(const Register reg) const {
+        if (auto shadow = getShadow(reg)) {
+            shadow->size = 0;
+        }
+    }
+
+    /// Read all cacheable registers with a valid shadow copy from the chip.
+    ///
+    /// Each register is read with the size of its last access. If a read fails, the
+    /// shadow copy of this register is invalidated and the remaining registers are still read.
+    ///
+    /// @return The status of the first failed read, or `Status::Success`.
+    ///
+    inline Status refresh() const {
+        Status result = Status::Success;
+        for (uint8_t index = 0; index < shadowSize; ++index) {
+            const auto status = refreshShadow(index);
+            if (status != Status::Success && result == Status::Success) {
+                result = status;
+            }
+        }
+        return result;
+    }
+
+    /// Read a single cacheable register with a valid shadow copy from the chip.
+    ///
+    /// @param[in] reg The register.
+    /// @return The status of the operation. See [Status](@ref WireMaster::Status) for details.
+    ///
+    inline Status refresh(const Register reg) const {
+        if (getShadow(reg) == nullptr) {
+            return Status::Success;
+        }
+        return refreshShadow(static_cast<uint8_t>(reg));
+    }
+
+private:
+    /// The shadow copy of a single register.
+    ///
+    struct Shadow {
+        uint32_t value; ///< The last known value of the register.
+        RegisterPolicy policy; ///< The policy for the register.
+        uint8_t size; ///< The size of the value in bytes, or zero if the shadow copy is invalid.
+    };
+
+private:
+    /// Get the shadow copy for a register.
+    ///
+    /// @return The shadow copy, or `nullptr` if the register is outside of the shadow range.
+    ///
+    inline Shadow* getShadow(const Register reg) const {
+        if constexpr (shadowSize > 0) {
+            const auto index = static_cast<uint8_t>(reg);
+            if (index < shadowSize) {
+                return &_shadows[index];
+            }
+        }
+        return nullptr;
+    }
+
+    /// Store a new value in the shadow copy, if the register is not volatile.
+    ///
+    template<typename Value>
+    inline void storeShadow(const Register reg, const Value value) const {
+        if (auto shadow = getShadow(reg)) {
+            if (shadow->policy != RegisterPolicy::Volatile) {
+                shadow->value = value;
+                shadow->size = sizeof(Value);
+            }
+        }
+    }
+
+    /// Invalidate the shadow copies of a range of registers.
+    ///
+    inline void invalidateRange(const uint16_t firstIndex, const uint8_t count) const {
+        for (uint16_t index = firstIndex; index < static_cast<uint16_t>(firstIndex + count) && index < shadowSize; ++index) {
+            _shadows[index].size = 0;
+        }
+    }
+
+    /// Read a cacheable register with a valid shadow copy again.
+    ///
+    inline Status refreshShadow(const uint8_t index) const {
+        auto &shadow = _shadows[index];
+        if (shadow.policy != RegisterPolicy::Cacheable) {
+            return Status::Success;
+        }
+        const auto reg = static_cast<Register>(index);
+        switch (shadow.size) {
+        case sizeof(uint8_t): { uint8_t value; return readRegisterTemplate<uint8_t>(reg, value); }
+        case sizeof(uint16_t): { uint16_t value; return readRegisterTemplate<uint16_t>(reg, value); }
+        case sizeof(uint32_t): { uint32_t value; return readRegisterTemplate<uint32_t>(reg, value); }
+        default: return Status::Success;
+        }
+    }
+
+    /// Read a batch of registers from the chip and update their shadow copies.
+    ///
+    inline Status readChipRegisters(const RegisterRead *reads, const uint8_t count) const {
+        const auto status = WireMasterChip::readRegisters(reads, count);
+        for (uint8_t i = 0; i < count; ++i) {
+            if (status == Status::Success) {
+                storeShadow<uint8_t>(static_cast<Register>(reads[i].reg), *reads[i].value);
+            } else {
+                invalidate(static_cast<Register>(reads[i].reg));
+            }
+        }
+        return status;
+    }
+
+    /// Keep the first failed status of a batch.
+    ///
+    inline static void updateStatus(Status &status, const Status result) {
+        if (status == Status::Success) {
+            status = result;
+        }
     }
+
+    /// Read a register from the chip and update the shadow copy.
+    ///
+    /// Write-only registers are never read, their shadow copy is returned instead.
+    /// A multi-byte read also covers the following registers, their shadow copies are invalidated.
+    ///
+    template<typename Value>
+    inline Status readRegisterTemplate(const Register reg, Value &value) const {
+        const auto shadow = getShadow(reg);
+        if (shadow != nullptr && shadow->policy == RegisterPolicy::WriteOnly) {
+            return readShadow(*shadow, value);
+        }
+        const auto status = WireMasterChip::readRegister(static_cast<uint8_t>(reg), value);
+        invalidateRange(static_cast<uint16_t>(reg) + 1, sizeof(Value) - 1);
+        if (shadow != nullptr) {
+            if (status == Status::Success) {
+                storeShadow<Value>(reg, value);
+            } else {
+                shadow->size = 0;
+            }
+        }
+        return status;
+    }
+
+    /// Get the value of a register from the shadow copy, or from the chip.
+    ///
+    template<typename Value>
+    inline Status readCachedRegister(const Register reg, Value &value) const {
+        const auto shadow = getShadow(reg);
+        if (shadow != nullptr && shadow->policy != RegisterPolicy::Volatile && shadow->size == sizeof(Value)) {
+            value = static_cast<Value>(shadow->value);
+            return Status::Success;
+        }
+        return readRegisterTemplate<Value>(reg, value);
+    }
+
+    /// Get the value of a write-only register from the shadow copy.
+    ///
+    template<typename Value>
+    inline static Status readShadow(const Shadow &shadow, Value &value) {
+        if (shadow.size != sizeof(Value)) {
+            return Status::Error;
+        }
+        value = static_cast<Value>(shadow.value);
+        return Status::Success;
+    }
+
+    /// Write a register to the chip and update the shadow copy.
+    ///
+    /// If the write fails, the state of the register is unknown and the shadow copy is invalidated.
+    /// A multi-byte write also changes the following registers, their shadow copies are invalidated.
+    ///
+    template<typename Value>
+    inline Status writeRegisterTemplate(const Register reg, const Value value) const {
+        const auto status = WireMasterChip::writeRegister(static_cast<uint8_t>(reg), value);
+        invalidateRange(static_cast<uint16_t>(reg) + 1, sizeof(Value) - 1);
+        if (status == Status::Success) {
+            storeShadow<Value>(reg, value);
+        } else {
+            invalidate(reg);
+        }
+        return status;
+    }
+
+    /// @copydoc WireMasterChip::writeBitsTemplate()
+    template<typename Value>
+    inline Status writeBitsShadowTemplate(const Register reg, const Value bitMask, const Value value) const {
+        if constexpr (shadowSize == 0) {
+            return writeBitsTemplate<Value>(static_cast<uint8_t>(reg), bitMask, value);
+        }
+        if (bitMask == 0) {
+            return Status::Success;
+        }
+        Value data;
+        const auto status = readCachedRegister<Value>(reg, data);
+        if (status != Status::Success) {
+            return status;
+        }
+        const auto newData = getMaskedBits(data, bitMask, value);
+        if (data == newData) {
+            return Status::Success;
+        }
+        return writeRegisterTemplate<Value>(reg, newData);
+    }
+
+    /// @copydoc WireMasterChip::testBitsTemplate()
+    template<typename Value>
+    inline Status testBitsShadowTemplate(const Register reg, const Value bitMask, BitResult &bitResult) const {
+        if constexpr (shadowSize == 0) {
+            return testBitsTemplate<Value>(static_cast<uint8_t>(reg), bitMask, bitResult);
+        }
+        Value value;
+        const auto status = readCachedRegister<Value>(reg, value);
+        if (status != Status::Success) {
+            return status;
+        }
+        bitResult = getBitResult(value, bitMask);
+        return Status::Success;
+    }
+
+    /// @copydoc WireMasterChip::changeBitsTemplate()
+    template<typename Value>
+    inline Status changeBitsShadowTemplate(const Register reg, const Value bitMask, const BitOperation bitOperation) const {
+        if constexpr (shadowSize == 0) {
+            return changeBitsTemplate<Value>(static_cast<uint8_t>(reg), bitMask, bitOperation);
+        }
+        Value data;
+        const auto status = readCachedRegister<Value>(reg, data);
+        if (status != Status::Success) {
+            return status;
+        }
+        const auto newData = getChangedBits(data, bitMask, bitOperation);
+        if (data == newData) {
+            return Status::Success;
+        }
+        return writeRegisterTemplate<Value>(reg, newData);
+    }
+
+private:
+    mutable std::array<Shadow, shadowSize> _shadows; ///< The shadow copies of the registers.
 };
 
 
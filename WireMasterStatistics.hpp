@@ -0,0 +1,300 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+
+#include "WireMaster.hpp"
+
+#include <cstdint>
+
+
+namespace lr {
+
+
+/// A wire master which records statistics for each device, and forwards all calls to another bus.
+///
+/// Wrap your bus with this class to find the chips which use most of the bus bandwidth, or which
+/// produce errors:
+///
+/// ```
+/// WireMasterStatistics<8> gBusStatistics(&gBus, &Timer::tickMicroseconds);
+/// WireMasterChip gSensor(&gBusStatistics, 0x40);
+/// ```
+///
+/// For each device address, the number of transactions, the number of moved bytes (including the
+/// register address), the time spent on the bus and the number of results for each status is counted.
+/// A sequence started with `writeBegin()` counts as one transaction, until `writeEndAndStop()` or
+/// `writeEndAndStart()` is called.
+///
+/// The statistics for the first `deviceCount` addresses on the bus are recorded separately, all
+/// other addresses are combined in one shared entry.
+///
+/// @tparam deviceCount The maximum number of devices with separate statistics.
+///
+template<uint8_t deviceCount = 8>
+class WireMasterStatistics : public WireMaster
+{
+public:
+    /// The function to get the current time for the measurements, in microseconds.
+    ///
+    typedef Microseconds (*TimeFn)();
+
+    /// The number of status values.
+    ///
+    constexpr static uint8_t cStatusCount = static_cast<uint8_t>(Status::Error) + 1;
+
+    /// The address used for the shared entry of all other devices.
+    ///
+    constexpr static uint8_t cOtherAddress = 0xffu;
+
+    /// The statistics for a single device.
+    ///
+    struct Device {
+        /// Get the number of transactions with the given status.
+        ///
+        inline uint32_t getStatusCount(Status status) const noexcept {
+            return statusCounts[static_cast<uint8_t>(status)];
+        }
+
+        /// Get the number of failed transactions.
+        ///
+        inline uint32_t getErrorCount() const noexcept {
+            return transactionCount - getStatusCount(Status::Success);
+        }
+
+        uint8_t address; ///< The address of the device, or `cOtherAddress` for the shared entry.
+        uint32_t transactionCount; ///< The number of transactions.
+        uint32_t byteCount; ///< The number of bytes written and read.
+        uint32_t busyTime; ///< The total time spent in transactions, in microseconds.
+        uint32_t maximumTime; ///< The time spent in the longest transaction, in microseconds.
+        uint32_t statusCounts[cStatusCount]; ///< The number of transactions for each status.
+    };
+
+public:
+    /// Create a new statistics decorator.
+    ///
+    /// @param[in] bus The bus to forward all calls to.
+    /// @param[in] timeFn The function to get the current time, or `nullptr` to not measure the time.
+    ///
+    WireMasterStatistics(WireMaster *bus, TimeFn timeFn = nullptr)
+        : _bus(bus), _timeFn(timeFn), _devices(), _usedDeviceCount(0), _other(), _sequenceDevice(nullptr),
+        _sequenceStartTime(0), _sequenceByteCount(0)
+    {
+        _other.address = cOtherAddress;
+    }
+
+public: // Statistics
+    /// Get the number of devices with separate statistics.
+    ///
+    inline uint8_t getDeviceCount() const noexcept {
+        return _usedDeviceCount;
+    }
+
+    /// Get the statistics for a device.
+    ///
+    /// @param[in] index The index of the device, in the order of the first access.
+    ///     Must be less than `getDeviceCount()`.
+    /// @return The statistics for the device.
+    ///
+    inline const Device& getDevice(uint8_t index) const noexcept {
+        return _devices[index];
+    }
+
+    /// Find the statistics for a device address.
+    ///
+    /// @param[in] address The address of the device.
+    /// @return The statistics for the device, or `nullptr` if there are no separate statistics for the address.
+    ///
+    inline const Device* findDevice(uint8_t address) const noexcept {
+        for (uint8_t i = 0; i < _usedDeviceCount; ++i) {
+            if (_devices[i].address == address) {
+                return &_devices[i];
+            }
+        }
+        return nullptr;
+    }
+
+    /// Get the combined statistics for all devices without separate statistics.
+    ///
+    inline const Device& getOtherDevices() const noexcept {
+        return _other;
+    }
+
+    /// Reset all statistics.
+    ///
+    inline void resetStatistics() noexcept {
+        _usedDeviceCount = 0;
+        _other = Device();
+        _other.address = cOtherAddress;
+        _sequenceDevice = nullptr;
+    }
+
+public: // WireMaster
+    Status initialize() override {
+        return _bus->initialize();
+    }
+
+    Status reset() override {
+        _sequenceDevice = nullptr;
+        return _bus->reset();
+    }
+
+    Status setSpeed(Speed speed, Nanoseconds riseTime = 90_ns) override {
+        return _bus->setSpeed(speed, riseTime);
+    }
+
+    Status setSpeed(uint32_t frequencyHz, Nanoseconds riseTime = 90_ns) override {
+        return _bus->setSpeed(frequencyHz, riseTime);
+    }
+
+    Status writeBegin(uint8_t address) override {
+        _sequenceStartTime = getTime();
+        const auto status = _bus->writeBegin(address);
+        _sequenceDevice = &getDeviceEntry(address);
+        _sequenceByteCount = 0;
+        if (status != Status::Success) {
+            endSequence(status);
+        }
+        return status;
+    }
+
+    Status writeByte(uint8_t data) override {
+        const auto status = _bus->writeByte(data);
+        if (status == Status::Success) {
+            _sequenceByteCount += 1;
+        } else {
+            endSequence(status);
+        }
+        return status;
+    }
+
+    Status writeEndAndStop() override {
+        const auto status = _bus->writeEndAndStop();
+        endSequence(status);
+        return status;
+    }
+
+    Status writeEndAndStart() override {
+        const auto status = _bus->writeEndAndStart();
+        endSequence(status);
+        return status;
+    }
+
+    Status writeBytes(uint8_t address, const uint8_t *data, uint8_t count) override {
+        const auto startTime = getTime();
+        const auto status = _bus->writeBytes(address, data, count);
+        record(address, startTime, count, status);
+        return status;
+    }
+
+    Status writeRegisterData(uint8_t address, uint8_t registerAddress, uint8_t data) override {
+        const auto startTime = getTime();
+        const auto status = _bus->writeRegisterData(address, registerAddress, data);
+        record(address, startTime, 2, status);
+        return status;
+    }
+
+    Status writeRegisterData(uint8_t address, uint8_t registerAddress, const uint8_t *data, uint8_t count) override {
+        const auto startTime = getTime();
+        const auto status = _bus->writeRegisterData(address, registerAddress, data, count);
+        record(address, startTime, static_cast<uint16_t>(count + 1), status);
+        return status;
+    }
+
+    Status readBytes(uint8_t address, uint8_t *data, uint8_t count) override {
+        const auto startTime = getTime();
+        const auto status = _bus->readBytes(address, data, count);
+        record(address, startTime, count, status);
+        return status;
+    }
+
+    Status readRegisterData(uint8_t address, uint8_t registerAddress, uint8_t *data, uint8_t count) override {
+        const auto startTime = getTime();
+        const auto status = _bus->readRegisterData(address, registerAddress, data, count);
+        record(address, startTime, static_cast<uint16_t>(count + 1), status);
+        return status;
+    }
+
+private:
+    /// Get the current time, or zero if no time function is set.
+    ///
+    inline uint32_t getTime() const noexcept {
+        return (_timeFn != nullptr) ? _timeFn().ticks() : 0;
+    }
+
+    /// Get the statistics entry for an address, adding a new one if possible.
+    ///
+    inline Device& getDeviceEntry(uint8_t address) noexcept {
+        for (uint8_t i = 0; i < _usedDeviceCount; ++i) {
+            if (_devices[i].address == address) {
+                return _devices[i];
+            }
+        }
+        if (_usedDeviceCount < deviceCount) {
+            auto &device = _devices[_usedDeviceCount++];
+            device = Device();
+            device.address = address;
+            return device;
+        }
+        return _other;
+    }
+
+    /// Record a single transaction.
+    ///
+    inline void record(Device &device, uint32_t startTime, uint16_t byteCount, Status status) noexcept {
+        // Unsigned subtraction handles a wrap of the time between start and end.
+        const uint32_t time = getTime() - startTime;
+        device.transactionCount += 1;
+        device.byteCount += byteCount;
+        device.busyTime += time;
+        if (time > device.maximumTime) {
+            device.maximumTime = time;
+        }
+        device.statusCounts[static_cast<uint8_t>(status)] += 1;
+    }
+
+    /// @copydoc record(Device&, uint32_t, uint16_t, Status)
+    inline void record(uint8_t address, uint32_t startTime, uint16_t byteCount, Status status) noexcept {
+        record(getDeviceEntry(address), startTime, byteCount, status);
+    }
+
+    /// End a sequence started with `writeBegin()`.
+    ///
+    inline void endSequence(Status status) noexcept {
+        if (_sequenceDevice != nullptr) {
+            record(*_sequenceDevice, _sequenceStartTime, _sequenceByteCount, status);
+            _sequenceDevice = nullptr;
+        }
+    }
+
+private:
+    WireMaster* const _bus; ///< The bus to forward all calls to.
+    const TimeFn _timeFn; ///< The function to get the current time.
+    Device _devices[deviceCount]; ///< The statistics for the separate devices.
+    uint8_t _usedDeviceCount; ///< The number of used device entries.
+    Device _other; ///< The combined statistics for all other devices.
+    Device *_sequenceDevice; ///< The device of the active `writeBegin()` sequence, or `nullptr`.
+    uint32_t _sequenceStartTime; ///< The start time of the active sequence.
+    uint16_t _sequenceByteCount; ///< The number of bytes written in the active sequence.
+};
+
+
+}
+
+
@@ -0,0 +1,111 @@
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#include "Benchmark.hpp"
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+
+namespace lr {
+namespace bench {
+
+
+namespace {
+
+
+/// A registered benchmark.
+///
+struct Entry {
+    const char *name; ///< The name of the benchmark.
+    uint32_t parameter; ///< The parameter for the function.
+    Function function; ///< The benchmark function.
+};
+
+
+/// The number of measurements for each benchmark.
+///
+constexpr uint8_t cRepeatCount = 5;
+
+
+/// Access the list of registered benchmarks.
+///
+std::vector<Entry>& Benchmark_getEntries()
+{
+    static std::vector<Entry> entries;
+    return entries;
+}
+
+
+/// Measure the time for a number of iterations.
+///
+/// @return The elapsed time in nanoseconds.
+///
+double Benchmark_measure(const Entry &entry, uint64_t iterations)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    entry.function(entry.parameter, iterations);
+    const auto endTime = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(endTime - startTime).count();
+}
+
+
+}
+
+
+void add(const char *name, uint32_t parameter, Function function)
+{
+    Benchmark_getEntries().push_back(Entry{name, parameter, function});
+}
+
+
+uint32_t runAll(const char *filter, uint32_t minimumTime)
+{
+    const double minimumNanoseconds = static_cast<double>(minimumTime) * 1e6;
+    uint32_t runCount = 0;
+    for (const auto &entry : Benchmark_getEntries()) {
+        if (filter != nullptr && std::strstr(entry.name, filter) == nullptr) {
+            continue;
+        }
+        // Double the iterations until one measurement takes long enough.
+        uint64_t iterations = 1;
+        while (Benchmark_measure(entry, iterations) < minimumNanoseconds && iterations < (uint64_t(1) << 40)) {
+            iterations *= 2;
+        }
+        double samples[cRepeatCount];
+        for (auto &sample : samples) {
+            sample = Benchmark_measure(entry, iterations) / static_cast<double>(iterations);
+        }
+        std::sort(samples, samples + cRepeatCount);
+        std::printf("{\"benchmark\":\"%s\",\"parameter\":%u,\"iterations\":%llu,"
+            "\"nsPerIteration\":%.3f,\"nsPerIterationMedian\":%.3f}\n",
+            entry.name, entry.parameter, static_cast<unsigned long long>(iterations),
+            samples[0], samples[cRepeatCount / 2]);
+        std::fflush(stdout);
+        ++runCount;
+    }
+    return runCount;
+}
+
+
+}
+}
+
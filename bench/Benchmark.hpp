@@ -0,0 +1,86 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+
+#include <cstdint>
+
+
+/// @namespace lr::bench
+/// A minimal framework for host side microbenchmarks.
+///
+/// Each benchmark is a function which runs the measured operation a given number of
+/// iterations. The runner calibrates the number of iterations, repeats the measurement
+/// and writes one JSON object per line to the standard output:
+///
+/// ```
+/// {"benchmark":"RingBuffer.writeRead","parameter":16,"iterations":1048576,"nsPerIteration":12.31,"nsPerIterationMedian":12.45}
+/// ```
+///
+/// The output can be compared across commits with any JSON tool.
+///
+
+
+namespace lr {
+namespace bench {
+
+
+/// The function for a benchmark.
+///
+/// @param parameter The parameter of the benchmark, e.g. the number of elements.
+/// @param iterations The number of iterations to run.
+///
+typedef void (*Function)(uint32_t parameter, uint64_t iterations);
+
+
+/// Prevent the compiler from removing the calculation of a value.
+///
+template<typename Value>
+inline void keep(const Value &value) noexcept {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/// Prevent the compiler from keeping values in registers across this point.
+///
+inline void clobber() noexcept {
+    asm volatile("" : : : "memory");
+}
+
+
+/// Register a benchmark.
+///
+/// @param name The name of the benchmark, e.g. `String.append`.
+/// @param parameter The parameter passed to the benchmark function.
+/// @param function The benchmark function.
+///
+void add(const char *name, uint32_t parameter, Function function);
+
+/// Run all registered benchmarks.
+///
+/// @param filter Only run benchmarks which contain this text in the name, or `nullptr` to run all.
+/// @param minimumTime The minimum time for one measurement, in milliseconds.
+/// @return The number of benchmarks which were run.
+///
+uint32_t runAll(const char *filter, uint32_t minimumTime);
+
+
+}
+}
+
+
@@ -0,0 +1,137 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+
+#include "../SerialLine.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace lr {
+namespace bench {
+
+
+/// A serial line for the host, which discards all sent data.
+///
+/// The line accepts any amount of data and only counts the sent bytes. Received data is
+/// read from a buffer set with `setInput()`.
+///
+class HostSerialLine : public SerialLine
+{
+public:
+    /// Create a new host serial line without input.
+    ///
+    HostSerialLine() noexcept : _sentCount(0), _input(nullptr), _inputSize(0), _inputPosition(0) {}
+
+public:
+    /// Set the data to receive.
+    ///
+    /// @param data The data, which has to stay valid while it is received.
+    /// @param size The size of the data.
+    ///
+    inline void setInput(const uint8_t *data, DataSize size) noexcept {
+        _input = data;
+        _inputSize = size;
+        _inputPosition = 0;
+    }
+
+    /// Get the number of bytes sent to this line.
+    ///
+    inline uint64_t getSentCount() const noexcept {
+        return _sentCount;
+    }
+
+public: // Implement SerialLine
+    DataSize sendBytesAvailable() noexcept override {
+        return 0xffffu;
+    }
+
+    Status send(uint8_t) noexcept override {
+        ++_sentCount;
+        return Status::Success;
+    }
+
+    Status send(const uint8_t*, DataSize dataSize, DataSize *dataSent) noexcept override {
+        _sentCount += dataSize;
+        if (dataSent != nullptr) {
+            *dataSent = dataSize;
+        }
+        return Status::Success;
+    }
+
+    Status sendReset() noexcept override {
+        return Status::Success;
+    }
+
+    DataSize receiveBytesAvailable() noexcept override {
+        return static_cast<DataSize>(_inputSize - _inputPosition);
+    }
+
+    Status receive(uint8_t &value) noexcept override {
+        if (_inputPosition == _inputSize) {
+            return Status::Error;
+        }
+        value = _input[_inputPosition++];
+        return Status::Success;
+    }
+
+    Status receive(uint8_t *data, DataSize dataSize, DataSize *dataReceived) noexcept override {
+        const auto count = std::min<DataSize>(dataSize, receiveBytesAvailable());
+        std::memcpy(data, _input + _inputPosition, count);
+        _inputPosition += count;
+        if (dataReceived != nullptr) {
+            *dataReceived = count;
+        }
+        return (count == dataSize) ? Status::Success : Status::Partial;
+    }
+
+    Status receiveBlock(uint8_t *data, DataSize dataSize, uint8_t blockEndMark, DataSize *dataReceived) noexcept override {
+        DataSize count = 0;
+        while (count < dataSize && _inputPosition < _inputSize) {
+            const auto value = _input[_inputPosition++];
+            data[count++] = value;
+            if (value == blockEndMark) {
+                break;
+            }
+        }
+        if (dataReceived != nullptr) {
+            *dataReceived = count;
+        }
+        return (count > 0 && data[count - 1] == blockEndMark) ? Status::Success : Status::Partial;
+    }
+
+    Status receiveReset() noexcept override {
+        _inputPosition = _inputSize;
+        return Status::Success;
+    }
+
+private:
+    uint64_t _sentCount; ///< The number of sent bytes.
+    const uint8_t *_input; ///< The data to receive.
+    DataSize _inputSize; ///< The size of the data to receive.
+    DataSize _inputPosition; ///< The position of the next byte to receive.
+};
+
+
+}
+}
+
+
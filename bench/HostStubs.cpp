@@ -0,0 +1,155 @@
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// The platform functions of the HAL, implemented for the host to run the benchmarks.
+// There are no interrupts on the host, therefore all locks are empty.
+//
+
+
+#include "../Core.hpp"
+#include "../FreeMemory.hpp"
+#include "../InterruptLock.hpp"
+#include "../Timer.hpp"
+
+#include <chrono>
+#include <thread>
+
+
+namespace lr {
+
+
+namespace {
+
+
+/// Get the time since the first call, in nanoseconds.
+///
+uint64_t HostStubs_getNanoseconds()
+{
+    static const auto startTime = std::chrono::steady_clock::now();
+    const auto elapsed = std::chrono::steady_clock::now() - startTime;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+
+}
+
+
+namespace Timer {
+
+
+Milliseconds tickMilliseconds()
+{
+    return Milliseconds(static_cast<Milliseconds::TickType>(HostStubs_getNanoseconds() / 1000000u));
+}
+
+
+Microseconds tickMicroseconds()
+{
+    return Microseconds(static_cast<Microseconds::TickType>(HostStubs_getNanoseconds() / 1000u));
+}
+
+
+uint32_t tickCycles()
+{
+    // Simulate a core running at 1GHz.
+    return static_cast<uint32_t>(HostStubs_getNanoseconds());
+}
+
+
+void waitForNextTick()
+{
+    const auto currentTick = tickMilliseconds();
+    while (tickMilliseconds() == currentTick) {
+        std::this_thread::yield();
+    }
+}
+
+
+void sleepUntil(Milliseconds time)
+{
+    const auto delta = tickMilliseconds().deltaTo(time);
+    if (delta > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delta));
+    }
+}
+
+
+void delayMilliseconds(uint32_t milliseconds)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+}
+
+
+void delayMicroseconds(uint32_t microseconds)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(microseconds));
+}
+
+
+}
+
+
+InterruptLock::InterruptLock()
+{
+}
+
+
+InterruptLock::~InterruptLock()
+{
+}
+
+
+#if LR_CORE_COUNT > 1
+
+namespace Core {
+
+
+uint8_t currentIndex()
+{
+    return 0;
+}
+
+
+void signalOtherCores()
+{
+}
+
+
+}
+
+
+CoreLock::CoreLock()
+{
+}
+
+
+CoreLock::~CoreLock()
+{
+}
+
+#endif
+
+
+uint32_t getFreeMemory()
+{
+    // The host has no fixed heap, report a constant value.
+    return 0x10000u;
+}
+
+
+}
+
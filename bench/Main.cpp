@@ -0,0 +1,323 @@
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// The microbenchmarks for the hot paths of the library.
+//
+// Usage: HAL-common-bench [--filter <text>] [--time <milliseconds>]
+//
+// Build the benchmarks with optimizations, e.g. with `-DCMAKE_BUILD_TYPE=Release`, and
+// compare the JSON lines written to the standard output across commits.
+//
+
+
+#include "Benchmark.hpp"
+#include "HostSerialLine.hpp"
+
+#include "../DateTime.hpp"
+#include "../Fixed16.hpp"
+#include "../RingBuffer.hpp"
+#include "../SerialLineStringWriter.hpp"
+#include "../String.hpp"
+#include "../StringBuilder.hpp"
+#include "../Timestamp.hpp"
+#include "../event/IndexedStorage.hpp"
+#include "../event/Loop.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+
+using namespace lr;
+
+
+namespace {
+
+
+/// The number of values in the tables for the arithmetic benchmarks.
+///
+constexpr uint32_t cValueCount = 256;
+
+/// The mask for the index into the value tables.
+///
+constexpr uint32_t cValueMask = cValueCount - 1;
+
+
+/// Create a table with pseudo random values for the arithmetic benchmarks.
+///
+/// @param seed The seed for the values.
+/// @param mask The mask applied to the raw values.
+///
+std::unique_ptr<Fixed16[]> Main_createValues(uint32_t seed, uint32_t mask)
+{
+    std::unique_ptr<Fixed16[]> values(new Fixed16[cValueCount]);
+    uint32_t state = seed;
+    for (uint32_t i = 0; i < cValueCount; ++i) {
+        state = state * 1664525u + 1013904223u;
+        auto value = static_cast<Fixed16::Type>(state & mask);
+        if (value == 0) {
+            value = 1;
+        }
+        values[i] = Fixed16((state & 0x80000000u) != 0 ? -value : value);
+    }
+    return values;
+}
+
+
+/// The number of executed events in the loop benchmarks.
+///
+uint64_t gEventCount = 0;
+
+
+/// The event used for the loop benchmarks.
+///
+void Main_countEvent()
+{
+    ++gEventCount;
+}
+
+
+void benchRingBufferWriteRead(uint32_t parameter, uint64_t iterations)
+{
+    RingBuffer<uint16_t, uint8_t> buffer(1024);
+    std::unique_ptr<uint8_t[]> block(new uint8_t[parameter]);
+    std::memset(block.get(), 0x5a, parameter);
+    for (uint64_t i = 0; i < iterations; ++i) {
+        buffer.write(block.get(), static_cast<uint16_t>(parameter));
+        bench::clobber();
+        bench::keep(buffer.read(block.get(), static_cast<uint16_t>(parameter)));
+    }
+}
+
+
+template<typename Storage>
+void benchLoopPollEvents(uint32_t parameter, uint64_t iterations)
+{
+    std::unique_ptr<event::BasicLoop<Storage>> loop(new event::BasicLoop<Storage>());
+    event::Loop &events = *loop;
+    for (uint32_t i = 0; i < parameter; ++i) {
+        events.addPollEvent(&Main_countEvent);
+    }
+    for (uint64_t i = 0; i < iterations; ++i) {
+        loop->processEvents();
+    }
+    bench::keep(gEventCount);
+}
+
+
+template<typename Storage>
+void benchLoopDelayedEvents(uint32_t parameter, uint64_t iterations)
+{
+    std::unique_ptr<event::BasicLoop<Storage>> loop(new event::BasicLoop<Storage>());
+    event::Loop &events = *loop;
+    for (uint32_t i = 0; i < parameter; ++i) {
+        events.addDelayedEvent(&Main_countEvent, Milliseconds(3600000u + i));
+    }
+    events.addPollEvent(&Main_countEvent);
+    for (uint64_t i = 0; i < iterations; ++i) {
+        loop->processEvents();
+    }
+    bench::keep(gEventCount);
+}
+
+
+void benchStringAppend(uint32_t parameter, uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; ++i) {
+        String text;
+        for (uint32_t j = 0; j < parameter; ++j) {
+            text.append('x');
+        }
+        bench::keep(text.getLength());
+    }
+}
+
+
+void benchStringAppendNumber(uint32_t parameter, uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; ++i) {
+        String text;
+        for (uint32_t j = 0; j < parameter; ++j) {
+            text.appendNumber(static_cast<uint32_t>(j * 7919u));
+        }
+        bench::keep(text.getLength());
+    }
+}
+
+
+void benchStringBuilderAppendNumber(uint32_t parameter, uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; ++i) {
+        InlineString<1024> text;
+        for (uint32_t j = 0; j < parameter; ++j) {
+            text.appendNumber(static_cast<uint32_t>(j * 7919u));
+        }
+        bench::keep(text.getLength());
+    }
+}
+
+
+void benchFixed16Multiply(uint32_t, uint64_t iterations)
+{
+    const auto a = Main_createValues(1, 0x00ffffffu);
+    const auto b = Main_createValues(2, 0x0003ffffu);
+    for (uint64_t i = 0; i < iterations; ++i) {
+        bench::keep(a[i & cValueMask] * b[(i >> 8) & cValueMask]);
+    }
+}
+
+
+void benchFixed16Divide(uint32_t, uint64_t iterations)
+{
+    const auto a = Main_createValues(3, 0x00ffffffu);
+    const auto b = Main_createValues(4, 0x00ffffffu);
+    for (uint64_t i = 0; i < iterations; ++i) {
+        bench::keep(a[i & cValueMask] / b[(i >> 8) & cValueMask]);
+    }
+}
+
+
+void benchFixed16FastDivide(uint32_t, uint64_t iterations)
+{
+    const auto a = Main_createValues(3, 0x00ffffffu);
+    const auto b = Main_createValues(4, 0x00ffffffu);
+    for (uint64_t i = 0; i < iterations; ++i) {
+        bench::keep(a[i & cValueMask].fastDivide(b[(i >> 8) & cValueMask]));
+    }
+}
+
+
+/// Create a table with dates in the range of the 32bit timestamps.
+///
+std::unique_ptr<DateTime[]> Main_createDates()
+{
+    std::unique_ptr<DateTime[]> dates(new DateTime[cValueCount]);
+    DateTime dateTime(2000, 1, 1, 0, 0, 0);
+    for (uint32_t i = 0; i < cValueCount; ++i) {
+        dateTime.addSeconds(16777259);
+        dates[i] = dateTime;
+    }
+    return dates;
+}
+
+
+void benchDateTimeToTimestamp(uint32_t, uint64_t iterations)
+{
+    const auto dates = Main_createDates();
+    for (uint64_t i = 0; i < iterations; ++i) {
+        bench::keep(Timestamp32(dates[i & cValueMask]));
+    }
+}
+
+
+void benchTimestampToDateTime(uint32_t, uint64_t iterations)
+{
+    const auto dates = Main_createDates();
+    std::unique_ptr<Timestamp32[]> timestamps(new Timestamp32[cValueCount]);
+    for (uint32_t i = 0; i < cValueCount; ++i) {
+        timestamps[i] = Timestamp32(dates[i]);
+    }
+    for (uint64_t i = 0; i < iterations; ++i) {
+        bench::keep(timestamps[i & cValueMask].toDateTime());
+    }
+}
+
+
+void benchDateTimeAddSeconds(uint32_t parameter, uint64_t iterations)
+{
+    DateTime dateTime(2019, 1, 1, 0, 0, 0);
+    for (uint64_t i = 0; i < iterations; ++i) {
+        dateTime.addSeconds(static_cast<int32_t>(parameter));
+        if (dateTime.getYear() > 9000) {
+            dateTime = DateTime(2019, 1, 1, 0, 0, 0);
+        }
+        bench::keep(dateTime);
+    }
+}
+
+
+void benchSerialLineStringWriter(uint32_t parameter, uint64_t iterations)
+{
+    bench::HostSerialLine serialLine;
+    SerialLineStringWriter writer(&serialLine);
+    String text;
+    for (uint32_t i = 0; i < parameter; ++i) {
+        text.append('x');
+    }
+    for (uint64_t i = 0; i < iterations; ++i) {
+        writer.writeLine(text);
+    }
+    bench::keep(serialLine.getSentCount());
+}
+
+
+/// Register all benchmarks.
+///
+void Main_addBenchmarks()
+{
+    for (uint32_t size : {1u, 16u, 256u}) {
+        bench::add("RingBuffer.writeRead", size, &benchRingBufferWriteRead);
+    }
+    for (uint32_t count : {8u, 32u, 128u}) {
+        bench::add("Loop.pollEvents.StaticStorage", count, &benchLoopPollEvents<event::StaticStorage<128>>);
+        bench::add("Loop.pollEvents.IndexedStorage", count, &benchLoopPollEvents<event::IndexedStorage<128>>);
+        bench::add("Loop.delayedEvents.StaticStorage", count, &benchLoopDelayedEvents<event::StaticStorage<129>>);
+        bench::add("Loop.delayedEvents.IndexedStorage", count, &benchLoopDelayedEvents<event::IndexedStorage<129>>);
+    }
+    for (uint32_t length : {16u, 256u}) {
+        bench::add("String.append", length, &benchStringAppend);
+    }
+    for (uint32_t count : {1u, 32u}) {
+        bench::add("String.appendNumber", count, &benchStringAppendNumber);
+        bench::add("StringBuilder.appendNumber", count, &benchStringBuilderAppendNumber);
+    }
+    bench::add("Fixed16.multiply", 0, &benchFixed16Multiply);
+    bench::add("Fixed16.divide", 0, &benchFixed16Divide);
+    bench::add("Fixed16.fastDivide", 0, &benchFixed16FastDivide);
+    bench::add("DateTime.toTimestamp", 0, &benchDateTimeToTimestamp);
+    bench::add("Timestamp.toDateTime", 0, &benchTimestampToDateTime);
+    for (uint32_t seconds : {1u, 86400u, 31536000u}) {
+        bench::add("DateTime.addSeconds", seconds, &benchDateTimeAddSeconds);
+    }
+    for (uint32_t length : {8u, 64u}) {
+        bench::add("SerialLineStringWriter.writeLine", length, &benchSerialLineStringWriter);
+    }
+}
+
+
+}
+
+
+int main(int argc, char *argv[])
+{
+    const char *filter = nullptr;
+    uint32_t minimumTime = 100;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--time") == 0 && i + 1 < argc) {
+            minimumTime = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::fprintf(stderr, "Usage: %s [--filter <text>] [--time <milliseconds>]\n", argv[0]);
+            return 1;
+        }
+    }
+    Main_addBenchmarks();
+    return (bench::runAll(filter, minimumTime) > 0) ? 0 : 1;
+}
+
@@ -0,0 +1,179 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+#include <cstdint>
+#include <type_traits>
+
+
+namespace lr {
+namespace event {
+
+
+/// A call for an event.
+///
+/// A call is either a plain function without parameters, or a function with a context
+/// pointer. The call is stored inline, without any dynamic memory allocation. On a 32-bit
+/// platform a call uses 8 bytes.
+///
+/// Usage:
+/// ```
+/// // A plain function.
+/// mainLoop().addImmediateEvent(&onUpdate);
+/// // A captureless lambda.
+/// mainLoop().addImmediateEvent([]{ gDisplay.refresh(); });
+/// // A function with a context.
+/// mainLoop().addDelayedEvent(event::Call(&onTimeout, &gSensor), 100_ms);
+/// // A member function of an object.
+/// mainLoop().addRepeatedEvent(event::Call::member<Display, &Display::refresh>(gDisplay), 50_ms);
+/// ```
+///
+class Call
+{
+public:
+    /// A plain function without parameters.
+    ///
+    typedef void (*Function)();
+
+    /// A function with a context pointer.
+    ///
+    typedef void (*ContextFunction)(void *context);
+
+public:
+    /// Create an empty call.
+    ///
+    constexpr Call() : _contextFunction(nullptr), _function(nullptr) {}
+
+    /// Create a call for a plain function.
+    ///
+    /// @param function The function to call.
+    ///
+    constexpr Call(Function function) : _contextFunction(nullptr), _function(function) {}
+
+    /// Create a call for a captureless lambda.
+    ///
+    /// @param lambda A lambda without captures, which converts into a plain function.
+    ///
+    template<typename Lambda, typename = typename std::enable_if<
+        std::is_convertible<Lambda, Function>::value && !std::is_same<Lambda, Function>::value>::type>
+    constexpr Call(Lambda lambda) : Call(static_cast<Function>(lambda)) {}
+
+    /// Create a call for a function with a context.
+    ///
+    /// @param function The function to call.
+    /// @param context The context which is passed to the function.
+    ///
+    constexpr Call(ContextFunction function, void *context) : _contextFunction(function), _context(context) {}
+
+    /// Create a call for a member function of an object.
+    ///
+    /// The object has to exist as long the call is part of the event loop.
+    ///
+    /// @tparam T The type of the object.
+    /// @tparam method The method to call.
+    /// @param object The object.
+    /// @return The call for the method.
+    ///
+    template<typename T, void (T::*method)()>
+    constexpr static Call member(T &object) {
+        return Call(&callMember<T, method>, &object);
+    }
+
+public:
+    /// Execute the call.
+    ///
+    inline void operator()() const {
+        if (_contextFunction != nullptr) {
+            _contextFunction(_context);
+        } else {
+            _function();
+        }
+    }
+
+    /// Check if this call is empty.
+    ///
+    constexpr bool isNull() const {
+        return _contextFunction == nullptr && _function == nullptr;
+    }
+
+    /// Get the address of the called function.
+    ///
+    /// This is the address of the plain function, or of the function with a context. It is
+    /// meant to identify calls in diagnostic output.
+    ///
+    inline uint32_t getAddress() const {
+        if (_contextFunction != nullptr) {
+            return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(_contextFunction));
+        }
+        return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(_function));
+    }
+
+    /// Get a hash value for this call.
+    ///
+    /// Equal calls have the same hash value.
+    ///
+    inline uint32_t getHash() const {
+        uint32_t hash = getAddress();
+        if (_contextFunction != nullptr) {
+            hash ^= static_cast<uint32_t>(reinterpret_cast<uintptr_t>(_context)) * 0x9e3779b1u;
+        }
+        return hash * 0x85ebca6bu;
+    }
+
+    /// Compare two calls.
+    ///
+    /// Calls are equal if the function and the context are equal.
+    ///
+    inline bool operator==(const Call &other) const {
+        if (_contextFunction != other._contextFunction) {
+            return false;
+        }
+        if (_contextFunction != nullptr) {
+            return _context == other._context;
+        }
+        return _function == other._function;
+    }
+
+    /// Compare two calls.
+    ///
+    inline bool operator!=(const Call &other) const {
+        return !operator==(other);
+    }
+
+private:
+    /// The trampoline to call a member function.
+    ///
+    template<typename T, void (T::*method)()>
+    static void callMember(void *context) {
+        (static_cast<T*>(context)->*method)();
+    }
+
+private:
+    ContextFunction _contextFunction; ///< The function with context, or `nullptr` for a plain function.
+    union {
+        Function _function; ///< The plain function, if there is no context function.
+        void *_context; ///< The context for the context function.
+    };
+};
+
+
+}
+}
+
+
@@ -49,18 +49,36 @@ enum InterruptFlag : uint16_t {
 };
 LR_DECLARE_FLAGS(InterruptFlag, InterruptFlags);
 
-/// The data format for single delayed events.
+/// The priority of an event.
 ///
-struct DelayedData {
-    Milliseconds expireTime;
+/// Ready events with a higher priority are always executed before the ones with a lower priority.
+///
+enum class Priority : uint8_t {
+    Low = 0, ///< Low priority, for events like display updates.
+    Normal = 1, ///< The normal priority for all events.
+    High = 2, ///< High priority, for time critical events. These events ignore the time budget of the loop.
 };
 
+/// The number of priority levels.
+///
+constexpr uint8_t cPriorityCount = 3;
 
-/// The data format for repeated events
+/// The policy for repeated events, if executions were missed.
+///
+/// Repeated events keep a fixed phase. The next expire time is always calculated from the
+/// previous expire time, not from the time of the execution.
 ///
-struct RepeatedData {
-    uint16_t expireTimeMs;
-    uint16_t intervalMs;
+enum class RepeatPolicy : uint8_t {
+    Skip = 0, ///< Skip all missed executions and continue at the next time in phase.
+    CatchUp = 1, ///< Execute all missed executions, one in each pass, until the event is back in phase.
+};
+
+/// The data format for delayed and repeated events.
+///
+/// The interval of repeated events is stored in the entry, outside of this union.
+///
+struct DelayedData {
+    Milliseconds expireTime;
 };
 
 
@@ -77,9 +95,7 @@ union Data {
     constexpr Data() : delayed({0_ms}) {}
     constexpr explicit Data(Milliseconds expireTime) : delayed({expireTime}) {}
     constexpr explicit Data(InterruptFlags interruptFlags) : onInterrupt({interruptFlags}) {}
-    constexpr Data(uint16_t expireTimeMs, uint16_t intervalMs) : repeated({expireTimeMs, intervalMs}) {}
     DelayedData delayed;
-    RepeatedData repeated;
     OnInterruptData onInterrupt;
 };
 
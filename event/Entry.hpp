@@ -18,10 +18,13 @@
 //
 
 
+#include "Call.hpp"
 #include "Data.hpp"
 
 #include "../BitTools.hpp"
 
+#include <algorithm>
+
 
 namespace lr {
 namespace event {
@@ -29,6 +32,9 @@ namespace event {
 
 /// A single entry for the event loop.
 ///
+/// On a 32-bit platform, each entry uses 16 bytes. The priority and the interval of repeated
+/// events are stored in the padding after the flags.
+///
 class Entry
 {
 public:
@@ -40,18 +46,22 @@ public:
         Immediate = oneBit8(1), ///< Flag set if the event happens each time.
         OnInterrupt = oneBit8(2), ///< Flag set if the event happens if an interrupt flag is set.
         Repeat = oneBit8(3), ///< Flag set if the event is repeated in a given interval or after an interrupt.
+        BlockSleep = oneBit8(4), ///< Flag set if the event prevents the loop from sleeping in tickless mode.
+        Triggered = oneBit8(5), ///< Flag set if an on-interrupt event was triggered, but not executed yet.
+        CoarseInterval = oneBit8(6), ///< Flag set if the interval of a repeated event is stored in seconds.
+        CatchUp = oneBit8(7), ///< Flag set if a repeated event executes all missed intervals.
     };
     LR_DECLARE_FLAGS(Flag, Flags);
 
 public:
-    /// The event function.
+    /// The plain event function.
     ///
-    typedef void (*Function)();
+    typedef Call::Function Function;
 
 public:
     /// Create an empty invalid event.
     ///
-    constexpr Entry() : _call(), _flags()
+    constexpr Entry() : _call(), _flags(), _priority(Priority::Normal), _interval(0)
     {}
 
 
@@ -60,21 +70,32 @@ public:
     /// @param flags The flags for the event.
     /// @param call The call for the event.
     /// @param expireTime The expire time of the event in milliseconds.
+    /// @param priority The priority of the event.
     ///
-    constexpr Entry(Flags flags, const Function &call, Milliseconds expireTime)
-        : _call(call), _data(expireTime), _flags(flags)
+    constexpr Entry(Flags flags, const Call &call, Milliseconds expireTime, Priority priority = Priority::Normal)
+        : _call(call), _data(expireTime), _flags(flags), _priority(priority), _interval(0)
     {}
 
 
     /// Create a repeated event.
     ///
+    /// Intervals up to 65535 milliseconds are stored exact. Longer intervals are rounded to
+    /// full seconds, up to 65535 seconds.
+    ///
     /// @param flags The flags for the event.
     /// @param call The call for the event.
-    /// @param expireTimeMs The expire time of the event in milliseconds.
-    /// @param intervalMs The interval time in milliseconds.
+    /// @param expireTime The first expire time of the event in milliseconds.
+    /// @param interval The interval of the event.
+    /// @param priority The priority of the event.
     ///
-    constexpr Entry(Flags flags, const Function &call, uint16_t expireTimeMs, uint16_t intervalMs)
-        : _call(call), _data(expireTimeMs, intervalMs), _flags(flags)
+    constexpr Entry(Flags flags, const Call &call, Milliseconds expireTime, Milliseconds interval,
+        Priority priority = Priority::Normal)
+    :
+        _call(call),
+        _data(expireTime),
+        _flags(isCoarseInterval(interval) ? (flags | Flag::CoarseInterval) : flags),
+        _priority(priority),
+        _interval(encodeInterval(interval))
     {}
 
 
@@ -83,9 +104,11 @@ public:
     /// @param flags The flags for the event.
     /// @param call The call for the event.
     /// @param interruptFlags The interrupt flags to trigger the event.
+    /// @param priority The priority of the event.
     ///
-    constexpr Entry(Flags flags, const Function &call, event::InterruptFlags interruptFlags)
-        : _call(call), _data(interruptFlags), _flags(flags)
+    constexpr Entry(Flags flags, const Call &call, event::InterruptFlags interruptFlags,
+        Priority priority = Priority::Normal)
+        : _call(call), _data(interruptFlags), _flags(flags), _priority(priority), _interval(0)
     {}
 
 
@@ -105,7 +128,7 @@ public:
     ///
     inline bool canMerge(const Entry &other) const
     {
-        return (_call == other._call) && (_flags == other._flags);
+        return (_call == other._call) && (_flags == other._flags) && (_priority == other._priority);
     }
 
 
@@ -124,11 +147,7 @@ public:
             return true;
         }
         if (_flags.isSet(Flag::OnInterrupt)) {
-            return (_data.onInterrupt.interruptFlags & interruptFlags).isOneSet();
-        } else if (_flags.isSet(Flag::Repeat)) {
-            const auto currentTime16 = static_cast<uint16_t>(currentTime.ticks());
-            const auto delta = static_cast<int16_t>(_data.repeated.expireTimeMs - currentTime16);
-            return delta <= 0;
+            return _flags.isSet(Flag::Triggered) || (_data.onInterrupt.interruptFlags & interruptFlags).isOneSet();
         } else {
             return currentTime.deltaTo(_data.delayed.expireTime) <= 0;
         }
@@ -145,11 +164,24 @@ public:
 
     /// Update the expire time.
     ///
+    /// This only affects repeated events, poll and interrupt events are not changed.
+    /// The interval is added to the previous expire time, so the event keeps a fixed phase.
+    /// If the new expire time already passed, missed executions are skipped, unless the
+    /// event uses the catch-up policy.
+    ///
+    /// @param currentTime The current time in millisecond ticks.
+    ///
     inline void updateExpireTime(Milliseconds currentTime)
     {
-        if (!_flags.isSet(Flag::Immediate)) {
-            const auto currentTime16 = static_cast<uint16_t>(currentTime.ticks());
-            _data.repeated.expireTimeMs = currentTime16 + _data.repeated.intervalMs;
+        if (isTimed()) {
+            const auto interval = getInterval();
+            auto &expireTime = _data.delayed.expireTime;
+            expireTime = expireTime + interval;
+            const auto delay = expireTime.deltaTo(currentTime);
+            if (delay >= 0 && !_flags.isSet(Flag::CatchUp) && interval.ticks() > 0) {
+                const auto missed = static_cast<Milliseconds::TickType>(delay) / interval.ticks() + 1;
+                expireTime = expireTime + Milliseconds(missed * interval.ticks());
+            }
         }
     }
 
@@ -162,17 +194,146 @@ public:
     }
 
 
+    /// Check if this is an immediate or poll event.
+    ///
+    inline bool isImmediate() const
+    {
+        return _flags.isSet(Flag::Immediate);
+    }
+
+
+    /// Check if this event prevents the loop from sleeping.
+    ///
+    inline bool isBlockingSleep() const
+    {
+        return _flags.isSet(Flag::BlockSleep);
+    }
+
+
+    /// Check if this is an on-interrupt event.
+    ///
+    inline bool isOnInterrupt() const
+    {
+        return _flags.isSet(Flag::OnInterrupt);
+    }
+
+
+    /// Check if this on-interrupt event was triggered, but not executed yet.
+    ///
+    inline bool isTriggered() const
+    {
+        return _flags.isSet(Flag::Triggered);
+    }
+
+
+    /// Latch the interrupt flags for an on-interrupt event.
+    ///
+    /// If one of the given interrupt flags matches, the event is marked as triggered and stays
+    /// ready until it is executed, even if it is carried over to a later pass.
+    ///
+    /// @param interruptFlags The current interrupt flags.
+    /// @return `true` if the event was triggered by the given flags.
+    ///
+    inline bool trigger(event::InterruptFlags interruptFlags)
+    {
+        if (_flags.isSet(Flag::Triggered) || !(_data.onInterrupt.interruptFlags & interruptFlags).isOneSet()) {
+            return false;
+        }
+        _flags.setFlag(Flag::Triggered);
+        return true;
+    }
+
+
+    /// Clear the triggered state after the event was executed.
+    ///
+    inline void clearTriggered()
+    {
+        _flags.clearFlag(Flag::Triggered);
+    }
+
+
+    /// Get the priority of this event.
+    ///
+    inline Priority getPriority() const
+    {
+        return _priority;
+    }
+
+
+    /// Check if this is a delayed or repeated event which depends on the time.
+    ///
+    inline bool isTimed() const
+    {
+        return !_flags.isSet(Flag::Immediate) && !_flags.isSet(Flag::OnInterrupt);
+    }
+
+
+    /// Get the expire time of a delayed or repeated event.
+    ///
+    /// @return The expire time in millisecond ticks.
+    ///
+    inline Milliseconds getExpireTime() const
+    {
+        return _data.delayed.expireTime;
+    }
+
+
+    /// Get the interval of a repeated event.
+    ///
+    /// @return The interval in milliseconds.
+    ///
+    inline Milliseconds getInterval() const
+    {
+        if (_flags.isSet(Flag::CoarseInterval)) {
+            return Milliseconds(static_cast<Milliseconds::TickType>(_interval) * 1000u);
+        }
+        return Milliseconds(_interval);
+    }
+
+
+    /// Set a new expire time for a delayed or repeated event.
+    ///
+    /// For repeated events, only the next execution is moved, the interval is not changed.
+    ///
+    /// @param expireTime The new expire time in millisecond ticks.
+    ///
+    inline void setExpireTime(Milliseconds expireTime)
+    {
+        _data.delayed.expireTime = expireTime;
+    }
+
+
     /// Get the call for the event.
-    inline Function getCall() const
+    ///
+    inline const Call& getCall() const
     {
         return _call;
     }
 
 
 private:
-    Function _call; ///< The call for this event.
+    /// Check if an interval has to be stored in seconds.
+    ///
+    constexpr static bool isCoarseInterval(Milliseconds interval)
+    {
+        return interval.ticks() > 0xffffu;
+    }
+
+    /// Encode an interval for the 16-bit storage.
+    ///
+    constexpr static uint16_t encodeInterval(Milliseconds interval)
+    {
+        return isCoarseInterval(interval)
+            ? static_cast<uint16_t>(std::min<Milliseconds::TickType>((interval.ticks() + 500u) / 1000u, 0xffffu))
+            : static_cast<uint16_t>(interval.ticks());
+    }
+
+private:
+    Call _call; ///< The call for this event.
     event::Data _data; ///< The data for this event.
     Flags _flags; ///< The flags for the event.
+    Priority _priority; ///< The priority of the event.
+    uint16_t _interval; ///< The interval for repeated events, in milliseconds or seconds.
 };
 
 
@@ -0,0 +1,109 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+#include <cstdint>
+
+
+namespace lr {
+namespace event {
+
+
+/// A handle to an event in the loop.
+///
+/// Each method to add an event returns a handle, which can be used to cancel or
+/// reschedule the event later. The value of the handle is opaque and defined by the
+/// storage of the loop. A handle becomes invalid as soon the event is removed from the
+/// loop.
+///
+/// The storage detects stale handles only within limits, because the handle values wrap:
+/// - `StaticStorage` uses a 16-bit value, incremented for every new event. A stale handle
+///   may refer to a new event, after 65535 more events were added.
+/// - `IndexedStorage` uses the slot index and an 8-bit generation per slot. A stale handle
+///   may refer to a new event, after 256 reuses of the same slot.
+///
+/// Therefore, reset stored handles when their event is removed, and do not keep them for long.
+///
+class Handle
+{
+public:
+    /// The type used to store the handle value.
+    ///
+    typedef uint16_t ValueType;
+
+    /// The value used for an invalid handle.
+    ///
+    constexpr static ValueType cInvalidValue = 0xffffu;
+
+public:
+    /// Create an invalid handle.
+    ///
+    constexpr Handle() : _value(cInvalidValue) {}
+
+    /// Create a handle with the given value.
+    ///
+    /// @param value The value for the handle.
+    ///
+    constexpr explicit Handle(ValueType value) : _value(value) {}
+
+    /// Create a handle from a slot index and a generation.
+    ///
+    /// @param slot The index of the slot.
+    /// @param generation The generation of the slot.
+    ///
+    constexpr Handle(uint8_t slot, uint8_t generation)
+        : _value(static_cast<ValueType>((static_cast<ValueType>(generation) << 8u) | slot)) {}
+
+public:
+    /// Check if this handle is valid.
+    ///
+    /// A valid handle can still refer to an event which was already removed.
+    ///
+    constexpr bool isValid() const { return _value != cInvalidValue; }
+
+    /// Get the value of this handle.
+    ///
+    constexpr ValueType getValue() const { return _value; }
+
+    /// Get the slot index, if the handle was created from a slot.
+    ///
+    constexpr uint8_t getSlot() const { return static_cast<uint8_t>(_value & 0xffu); }
+
+    /// Get the generation, if the handle was created from a slot.
+    ///
+    constexpr uint8_t getGeneration() const { return static_cast<uint8_t>(_value >> 8u); }
+
+public:
+    /// Compare two handles.
+    ///
+    constexpr bool operator==(const Handle &other) const { return _value == other._value; }
+
+    /// Compare two handles.
+    ///
+    constexpr bool operator!=(const Handle &other) const { return _value != other._value; }
+
+private:
+    ValueType _value; ///< The value of the handle.
+};
+
+
+}
+}
+
+
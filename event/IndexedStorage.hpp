@@ -0,0 +1,695 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+#include "Entry.hpp"
+#include "Handle.hpp"
+
+#include "../Timer.hpp"
+
+#include <cstdint>
+
+
+namespace lr {
+namespace event {
+
+
+/// An indexed implementation of the entry storage.
+///
+/// This storage keeps all entries in a static pool of slots, which never move. Immediate, poll and
+/// interrupt entries are kept in separate lists, delayed and repeated entries are kept in a binary
+/// min-heap, sorted by their expire time. A pass only touches the entries which are actually ready,
+/// plus the poll entries, and the interrupt entries if an interrupt flag was set.
+///
+/// Ready entries are kept in one linked list per priority, so high priority entries are always
+/// taken first. On-interrupt entries are marked as triggered at the start of a pass, therefore
+/// they are not lost if they are carried over to the next pass.
+///
+/// Each entry is addressed by a handle, built from the slot index and a generation counter for
+/// the slot. Cancelling or rescheduling an entry does not search the entry list. Timed entries are
+/// removed from the heap in logarithmic time, all other entries are removed from their short lists.
+///
+/// Compared to `StaticStorage`, this storage uses 7 additional bytes per entry.
+/// Use it if you have many delayed or repeated events.
+///
+/// Optionally, the storage keeps an open-addressed hash index of all entries, keyed by their
+/// call. With this index, merging entries and `isPending()` take constant time on average,
+/// instead of a scan of all slots. The index uses one byte per element. Use it if events are
+/// added with `merge` set at a high rate.
+///
+/// Usage:
+/// ```
+/// event::BasicLoop<event::IndexedStorage<48>> gEventLoop;
+/// // With a merge index.
+/// event::BasicLoop<event::IndexedStorage<48, 64>> gEventLoop;
+/// ```
+///
+/// @tparam entryListSize The maximum number of entries in the storage. Up to 254.
+/// @tparam mergeIndexSize The number of elements in the merge index, or zero to disable the index.
+///     Has to be a power of two, larger than `entryListSize`.
+///
+template<uint8_t entryListSize = 32, uint16_t mergeIndexSize = 0>
+class IndexedStorage
+{
+    static_assert(entryListSize > 0 && entryListSize < 0xffu, "The entry list size has to be in the range 1-254.");
+    static_assert(mergeIndexSize == 0 || (mergeIndexSize > entryListSize && (mergeIndexSize & (mergeIndexSize - 1)) == 0),
+        "The merge index size has to be zero or a power of two, larger than the entry list size.");
+
+public:
+    /// Create a new empty storage instance.
+    ///
+    constexpr IndexedStorage()
+    :
+        _freeCount(entryListSize),
+        _pollCount(0),
+        _interruptCount(0),
+        _heapCount(0),
+        _sleepBlockerCount(0),
+        _triggeredCount(0),
+        _passPriority(0),
+        _passPollPosition(0),
+        _passPollCount(0),
+        _passInterruptPosition(0),
+        _passInterruptCount(0),
+        _passTime(),
+        _readyFirst(),
+        _readyLast(),
+        _readyCount(),
+        _passReadyCount(),
+        _pollPriorityCount(),
+        _freeList(),
+        _readyNext(),
+        _pollList(),
+        _interruptList(),
+        _heap(),
+        _heapPosition(),
+        _generation(),
+        _mergeIndex(),
+        _entryList()
+    {
+        for (uint8_t i = 0; i < entryListSize; ++i) {
+            _freeList[i] = (entryListSize - 1 - i);
+            _heapPosition[i] = cNotInHeap;
+        }
+        for (uint16_t i = 0; i < cMergeIndexArraySize; ++i) {
+            _mergeIndex[i] = cNoSlot;
+        }
+        for (uint8_t i = 0; i < cPriorityCount; ++i) {
+            _readyFirst[i] = cNoSlot;
+            _readyLast[i] = cNoSlot;
+        }
+    }
+
+public: // Implement all required storage methods
+    /// Add an entry to the current storage.
+    ///
+    /// @param entry The entry to add.
+    /// @param merge If the entry shall be merged with existing ones.
+    /// @return The handle for the added entry, the handle of the existing entry if the entry
+    ///     was merged, or an invalid handle if the storage is full.
+    ///
+    Handle addEntry(const Entry &entry, bool merge) {
+        if (merge) {
+            // Search for entries which can be merged.
+            const uint8_t slot = findMergeSlot(entry);
+            if (slot != cNoSlot) {
+                // Just ignore this, if we found one.
+                return Handle(slot, _generation[slot]);
+            }
+        }
+        if (_freeCount == 0) {
+            return Handle(); // Skip new entries if the storage is full.
+        }
+        _freeCount -= 1;
+        const uint8_t slot = _freeList[_freeCount];
+        _entryList[slot] = entry;
+        addToMergeIndex(slot);
+        if (entry.isImmediate()) {
+            if (entry.isRemovedAfterCall()) {
+                pushReady(slot);
+            } else {
+                _pollList[_pollCount] = slot;
+                _pollCount += 1;
+                _pollPriorityCount[priorityLevel(slot)] += 1;
+                if (entry.isBlockingSleep()) {
+                    _sleepBlockerCount += 1;
+                }
+            }
+        } else if (entry.isOnInterrupt()) {
+            _interruptList[_interruptCount] = slot;
+            _interruptCount += 1;
+        } else {
+            pushHeap(slot);
+        }
+        return Handle(slot, _generation[slot]);
+    }
+
+    /// Cancel an entry.
+    ///
+    /// The entry is removed from the storage. If it is cancelled while a pass is processed,
+    /// it is not returned by `takeReady()` anymore.
+    ///
+    /// @param handle The handle of the entry.
+    /// @return `true` if the entry was removed, `false` if the handle is stale or invalid.
+    ///
+    bool cancel(Handle handle) {
+        const uint8_t slot = findSlot(handle);
+        if (slot == cNoSlot) {
+            return false;
+        }
+        const auto &entry = _entryList[slot];
+        if (entry.isImmediate()) {
+            if (entry.isRemovedAfterCall()) {
+                removeReady(slot);
+            } else {
+                removeListSlot(_pollList, _pollCount, _passPollPosition, _passPollCount, slot);
+                _pollPriorityCount[priorityLevel(slot)] -= 1;
+                if (entry.isBlockingSleep()) {
+                    _sleepBlockerCount -= 1;
+                }
+            }
+        } else if (entry.isOnInterrupt()) {
+            removeListSlot(_interruptList, _interruptCount, _passInterruptPosition, _passInterruptCount, slot);
+            if (entry.isTriggered()) {
+                _triggeredCount -= 1;
+            }
+        } else if (_heapPosition[slot] != cNotInHeap) {
+            removeHeap(slot);
+        } else {
+            removeReady(slot);
+        }
+        freeSlot(slot);
+        return true;
+    }
+
+    /// Reschedule a delayed or repeated entry.
+    ///
+    /// For repeated entries, only the next execution is moved and the interval is kept.
+    ///
+    /// @param handle The handle of the entry.
+    /// @param expireTime The new expire time for the entry.
+    /// @return `true` if the entry was rescheduled, `false` if the handle is stale or invalid,
+    ///     or the entry is not a delayed or repeated one.
+    ///
+    bool reschedule(Handle handle, Milliseconds expireTime) {
+        const uint8_t slot = findSlot(handle);
+        if (slot == cNoSlot || !_entryList[slot].isTimed()) {
+            return false;
+        }
+        if (_heapPosition[slot] != cNotInHeap) {
+            removeHeap(slot);
+        } else {
+            removeReady(slot);
+        }
+        _entryList[slot].setExpireTime(expireTime);
+        pushHeap(slot);
+        return true;
+    }
+
+    /// Check if an entry with the given call is in the storage.
+    ///
+    /// @param call The call to search.
+    /// @return `true` if there is at least one entry with this call.
+    ///
+    bool isPending(const Call &call) const {
+        if (mergeIndexSize > 0) {
+            for (uint16_t position = mergeIndexPosition(call); _mergeIndex[position] != cNoSlot;
+                position = (position + 1) & cMergeIndexMask) {
+                if (_entryList[_mergeIndex[position]].getCall() == call) {
+                    return true;
+                }
+            }
+        } else {
+            for (uint8_t slot = 0; slot < entryListSize; ++slot) {
+                if (_entryList[slot].isValid() && _entryList[slot].getCall() == call) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /// Get the current number of entries.
+    ///
+    /// @return The current number of entries.
+    ///
+    inline uint8_t getCount() const {
+        return entryListSize - _freeCount;
+    }
+
+    /// Start a new pass to process the ready entries.
+    ///
+    /// All expired timed entries are moved into the ready lists, and all on-interrupt entries
+    /// which match the interrupt flags are marked as triggered. Only entries which are ready at
+    /// the start of the pass are processed. This prevents endless loops from events which add
+    /// new events.
+    ///
+    /// @param currentTime The current time for this pass.
+    /// @param interruptFlags The interrupt flags for this pass.
+    ///
+    void beginPass(Milliseconds currentTime, InterruptFlags interruptFlags) {
+        while (_heapCount > 0 && currentTime.deltaTo(_entryList[_heap[0]].getExpireTime()) <= 0) {
+            pushReady(popHeap());
+        }
+        if (interruptFlags.isOneSet()) {
+            for (uint8_t i = 0; i < _interruptCount; ++i) {
+                if (_entryList[_interruptList[i]].trigger(interruptFlags)) {
+                    _triggeredCount += 1;
+                }
+            }
+        }
+        _passTime = currentTime;
+        _passPriority = cPriorityCount - 1;
+        for (uint8_t i = 0; i < cPriorityCount; ++i) {
+            _passReadyCount[i] = _readyCount[i];
+        }
+        _passPollPosition = 0;
+        _passPollCount = _pollCount;
+        _passInterruptPosition = 0;
+        _passInterruptCount = (_triggeredCount > 0 ? _interruptCount : 0);
+    }
+
+    /// Take the next ready entry from the current pass.
+    ///
+    /// Entries are taken in the order of their priority. Single events are removed from the
+    /// storage, repeated events are updated for their next execution. Ready entries with a
+    /// priority below `lowestPriority` stay in the storage, and are taken in the next pass.
+    ///
+    /// @param entry The variable to store a copy of the ready entry, before it is updated.
+    /// @param lowestPriority The lowest priority of the entries to take.
+    /// @return `true` if a ready entry was found, `false` if the pass is finished.
+    ///
+    bool takeReady(Entry &entry, Priority lowestPriority = Priority::Low) {
+        while (_passPriority >= static_cast<uint8_t>(lowestPriority)) {
+            const uint8_t level = _passPriority;
+            if (_passReadyCount[level] > 0) {
+                _passReadyCount[level] -= 1;
+                const uint8_t slot = popReady(level);
+                entry = _entryList[slot];
+                if (entry.isRemovedAfterCall()) {
+                    freeSlot(slot);
+                } else {
+                    _entryList[slot].updateExpireTime(_passTime);
+                    pushHeap(slot);
+                }
+                return true;
+            }
+            if (_pollPriorityCount[level] > 0) {
+                while (_passPollPosition < _passPollCount) {
+                    const uint8_t slot = _pollList[_passPollPosition];
+                    _passPollPosition += 1;
+                    if (priorityLevel(slot) == level) {
+                        entry = _entryList[slot];
+                        return true;
+                    }
+                }
+            }
+            while (_passInterruptPosition < _passInterruptCount) {
+                const uint8_t slot = _interruptList[_passInterruptPosition];
+                auto &event = _entryList[slot];
+                if (event.isTriggered() && priorityLevel(slot) == level) {
+                    _triggeredCount -= 1;
+                    if (event.isRemovedAfterCall()) {
+                        entry = event;
+                        removeListEntry(_interruptList, _interruptCount, _passInterruptPosition);
+                        _passInterruptCount -= 1;
+                        freeSlot(slot);
+                    } else {
+                        event.clearTriggered();
+                        entry = event;
+                        _passInterruptPosition += 1;
+                    }
+                    return true;
+                }
+                _passInterruptPosition += 1;
+            }
+            if (level == 0) {
+                break;
+            }
+            _passPriority -= 1;
+            _passPollPosition = 0;
+            _passInterruptPosition = 0;
+        }
+        return false;
+    }
+
+    /// Get the deadline until the loop can sleep.
+    ///
+    /// @param currentTime The current time.
+    /// @param deadline The latest deadline on input. This variable is set to the earliest expire
+    ///     time of all timed entries, if this is before the given deadline.
+    /// @return `true` if the loop can sleep until `deadline`, `false` if an entry is ready or
+    ///     an entry blocks sleeping.
+    ///
+    bool getSleepDeadline(Milliseconds currentTime, Milliseconds &deadline) const {
+        if (_sleepBlockerCount > 0 || _triggeredCount > 0) {
+            return false;
+        }
+        for (uint8_t i = 0; i < cPriorityCount; ++i) {
+            if (_readyCount[i] > 0) {
+                return false;
+            }
+        }
+        if (_heapCount > 0) {
+            const auto expireTime = _entryList[_heap[0]].getExpireTime();
+            if (currentTime.deltaTo(expireTime) <= 0) {
+                return false;
+            }
+            if (expireTime.deltaTo(deadline) > 0) {
+                deadline = expireTime;
+            }
+        }
+        return true;
+    }
+
+private:
+    /// The value for an unknown slot.
+    ///
+    constexpr static uint8_t cNoSlot = 0xffu;
+
+    /// The heap position for slots which are not in the heap.
+    ///
+    constexpr static uint8_t cNotInHeap = 0xffu;
+
+    /// The size of the merge index array, with one element if the index is disabled.
+    ///
+    constexpr static uint16_t cMergeIndexArraySize = (mergeIndexSize > 0 ? mergeIndexSize : 1);
+
+    /// The mask for positions in the merge index.
+    ///
+    constexpr static uint16_t cMergeIndexMask = cMergeIndexArraySize - 1;
+
+private:
+    /// Get the slot for a handle.
+    ///
+    /// @return The slot index or `cNoSlot` if the handle does not match a current entry.
+    ///
+    inline uint8_t findSlot(Handle handle) const {
+        if (!handle.isValid()) {
+            return cNoSlot;
+        }
+        const uint8_t slot = handle.getSlot();
+        if (slot >= entryListSize || _generation[slot] != handle.getGeneration() || !_entryList[slot].isValid()) {
+            return cNoSlot;
+        }
+        return slot;
+    }
+
+    /// Release a slot and add it to the free list.
+    ///
+    /// The generation of the slot is incremented, to invalidate all existing handles.
+    ///
+    inline void freeSlot(uint8_t slot) {
+        removeFromMergeIndex(slot);
+        _entryList[slot] = Entry();
+        _generation[slot] += 1;
+        _freeList[_freeCount] = slot;
+        _freeCount += 1;
+    }
+
+    /// Find an entry which can be merged with the given one.
+    ///
+    /// @return The slot of the entry, or `cNoSlot` if there is no such entry.
+    ///
+    uint8_t findMergeSlot(const Entry &entry) const {
+        if (mergeIndexSize > 0) {
+            for (uint16_t position = mergeIndexPosition(entry.getCall()); _mergeIndex[position] != cNoSlot;
+                position = (position + 1) & cMergeIndexMask) {
+                if (entry.canMerge(_entryList[_mergeIndex[position]])) {
+                    return _mergeIndex[position];
+                }
+            }
+        } else {
+            for (uint8_t slot = 0; slot < entryListSize; ++slot) {
+                if (entry.canMerge(_entryList[slot])) {
+                    return slot;
+                }
+            }
+        }
+        return cNoSlot;
+    }
+
+    /// Get the preferred position in the merge index for a call.
+    ///
+    inline static uint16_t mergeIndexPosition(const Call &call) {
+        const uint32_t hash = call.getHash();
+        return static_cast<uint16_t>((hash ^ (hash >> 16u)) & cMergeIndexMask);
+    }
+
+    /// Add a slot to the merge index.
+    ///
+    inline void addToMergeIndex(uint8_t slot) {
+        if (mergeIndexSize > 0) {
+            uint16_t position = mergeIndexPosition(_entryList[slot].getCall());
+            while (_mergeIndex[position] != cNoSlot) {
+                position = (position + 1) & cMergeIndexMask;
+            }
+            _mergeIndex[position] = slot;
+        }
+    }
+
+    /// Remove a slot from the merge index.
+    ///
+    /// The following elements of the probe sequence are moved back, so no deleted markers
+    /// are required.
+    ///
+    void removeFromMergeIndex(uint8_t slot) {
+        if (mergeIndexSize > 0) {
+            uint16_t position = mergeIndexPosition(_entryList[slot].getCall());
+            while (_mergeIndex[position] != slot) {
+                position = (position + 1) & cMergeIndexMask;
+            }
+            uint16_t next = (position + 1) & cMergeIndexMask;
+            while (_mergeIndex[next] != cNoSlot) {
+                // Move the element back, if its preferred position is not in the range (position, next].
+                const uint16_t preferred = mergeIndexPosition(_entryList[_mergeIndex[next]].getCall());
+                const uint16_t distanceNext = (next - preferred) & cMergeIndexMask;
+                const uint16_t distancePosition = (position - preferred) & cMergeIndexMask;
+                if (distancePosition < distanceNext) {
+                    _mergeIndex[position] = _mergeIndex[next];
+                    position = next;
+                }
+                next = (next + 1) & cMergeIndexMask;
+            }
+            _mergeIndex[position] = cNoSlot;
+        }
+    }
+
+    /// Get the priority level of the entry in a slot.
+    ///
+    inline uint8_t priorityLevel(uint8_t slot) const {
+        return static_cast<uint8_t>(_entryList[slot].getPriority());
+    }
+
+    /// Add a slot at the end of the ready list for its priority.
+    ///
+    inline void pushReady(uint8_t slot) {
+        const uint8_t level = priorityLevel(slot);
+        _readyNext[slot] = cNoSlot;
+        if (_readyLast[level] == cNoSlot) {
+            _readyFirst[level] = slot;
+        } else {
+            _readyNext[_readyLast[level]] = slot;
+        }
+        _readyLast[level] = slot;
+        _readyCount[level] += 1;
+    }
+
+    /// Remove the first slot from the ready list of a priority.
+    ///
+    inline uint8_t popReady(uint8_t level) {
+        const uint8_t slot = _readyFirst[level];
+        _readyFirst[level] = _readyNext[slot];
+        if (_readyFirst[level] == cNoSlot) {
+            _readyLast[level] = cNoSlot;
+        }
+        _readyCount[level] -= 1;
+        return slot;
+    }
+
+    /// Remove a slot from the ready list, keeping the order of the elements.
+    ///
+    void removeReady(uint8_t slot) {
+        const uint8_t level = priorityLevel(slot);
+        uint8_t previous = cNoSlot;
+        uint8_t current = _readyFirst[level];
+        uint8_t index = 0;
+        while (current != cNoSlot && current != slot) {
+            previous = current;
+            current = _readyNext[current];
+            index += 1;
+        }
+        if (current == cNoSlot) {
+            return;
+        }
+        if (previous == cNoSlot) {
+            _readyFirst[level] = _readyNext[slot];
+        } else {
+            _readyNext[previous] = _readyNext[slot];
+        }
+        if (_readyLast[level] == slot) {
+            _readyLast[level] = previous;
+        }
+        _readyCount[level] -= 1;
+        if (index < _passReadyCount[level]) {
+            _passReadyCount[level] -= 1;
+        }
+    }
+
+    /// Remove an element from a slot list, keeping the order of the elements.
+    ///
+    static void removeListEntry(uint8_t *list, uint8_t &count, uint8_t position) {
+        count -= 1;
+        for (uint8_t i = position; i < count; ++i) {
+            list[i] = list[i + 1];
+        }
+    }
+
+    /// Remove a slot from a slot list, and adjust the pass position and count for the list.
+    ///
+    static void removeListSlot(uint8_t *list, uint8_t &count, uint8_t &passPosition, uint8_t &passCount, uint8_t slot) {
+        for (uint8_t position = 0; position < count; ++position) {
+            if (list[position] == slot) {
+                removeListEntry(list, count, position);
+                if (position < passPosition) {
+                    passPosition -= 1;
+                }
+                if (position < passCount) {
+                    passCount -= 1;
+                }
+                return;
+            }
+        }
+    }
+
+    /// Check if the slot `a` expires before the slot `b`.
+    ///
+    inline bool isBefore(uint8_t a, uint8_t b) const {
+        return _entryList[b].getExpireTime().deltaTo(_entryList[a].getExpireTime()) < 0;
+    }
+
+    /// Add a slot to the heap.
+    ///
+    void pushHeap(uint8_t slot) {
+        const uint8_t position = _heapCount;
+        _heapCount += 1;
+        siftUp(position, slot);
+    }
+
+    /// Remove the slot with the earliest expire time from the heap.
+    ///
+    uint8_t popHeap() {
+        const uint8_t result = _heap[0];
+        removeHeap(result);
+        return result;
+    }
+
+    /// Remove a slot from any position in the heap.
+    ///
+    void removeHeap(uint8_t slot) {
+        const uint8_t position = _heapPosition[slot];
+        _heapPosition[slot] = cNotInHeap;
+        _heapCount -= 1;
+        if (position == _heapCount) {
+            return;
+        }
+        const uint8_t lastSlot = _heap[_heapCount];
+        if (position > 0 && isBefore(lastSlot, _heap[(position - 1) / 2])) {
+            siftUp(position, lastSlot);
+        } else {
+            siftDown(position, lastSlot);
+        }
+    }
+
+    /// Move a slot from the given position up in the heap, until the heap order is restored.
+    ///
+    void siftUp(uint8_t position, uint8_t slot) {
+        while (position > 0) {
+            const uint8_t parent = (position - 1) / 2;
+            if (!isBefore(slot, _heap[parent])) {
+                break;
+            }
+            setHeap(position, _heap[parent]);
+            position = parent;
+        }
+        setHeap(position, slot);
+    }
+
+    /// Move a slot from the given position down in the heap, until the heap order is restored.
+    ///
+    void siftDown(uint8_t position, uint8_t slot) {
+        while (true) {
+            const uint16_t left = static_cast<uint16_t>(position) * 2 + 1;
+            if (left >= _heapCount) {
+                break;
+            }
+            uint8_t child = static_cast<uint8_t>(left);
+            if (child + 1 < _heapCount && isBefore(_heap[child + 1], _heap[child])) {
+                child += 1;
+            }
+            if (!isBefore(_heap[child], slot)) {
+                break;
+            }
+            setHeap(position, _heap[child]);
+            position = child;
+        }
+        setHeap(position, slot);
+    }
+
+    /// Place a slot at a position in the heap.
+    ///
+    inline void setHeap(uint8_t position, uint8_t slot) {
+        _heap[position] = slot;
+        _heapPosition[slot] = position;
+    }
+
+private:
+    uint8_t _freeCount; ///< The number of free slots.
+    uint8_t _pollCount; ///< The number of elements in the poll list.
+    uint8_t _interruptCount; ///< The number of elements in the interrupt list.
+    uint8_t _heapCount; ///< The number of elements in the heap.
+    uint8_t _sleepBlockerCount; ///< The number of poll entries which block sleeping.
+    uint8_t _triggeredCount; ///< The number of triggered on-interrupt entries.
+    uint8_t _passPriority; ///< The priority level processed in the current pass.
+    uint8_t _passPollPosition; ///< The position in the poll list for the current pass.
+    uint8_t _passPollCount; ///< The number of poll entries to process in the current pass.
+    uint8_t _passInterruptPosition; ///< The position in the interrupt list for the current pass.
+    uint8_t _passInterruptCount; ///< The number of interrupt entries to process in the current pass.
+    Milliseconds _passTime; ///< The time of the current pass.
+    uint8_t _readyFirst[cPriorityCount]; ///< The first slot in the ready list for each priority.
+    uint8_t _readyLast[cPriorityCount]; ///< The last slot in the ready list for each priority.
+    uint8_t _readyCount[cPriorityCount]; ///< The number of slots in the ready list for each priority.
+    uint8_t _passReadyCount[cPriorityCount]; ///< The number of ready slots to process in the current pass.
+    uint8_t _pollPriorityCount[cPriorityCount]; ///< The number of poll entries for each priority.
+    uint8_t _freeList[entryListSize]; ///< The stack with the free slots.
+    uint8_t _readyNext[entryListSize]; ///< The next slot in the ready list for each slot.
+    uint8_t _pollList[entryListSize]; ///< The list with the poll slots.
+    uint8_t _interruptList[entryListSize]; ///< The list with the interrupt slots.
+    uint8_t _heap[entryListSize]; ///< The min-heap with the timed slots.
+    uint8_t _heapPosition[entryListSize]; ///< The position of each slot in the heap, or `cNotInHeap`.
+    uint8_t _generation[entryListSize]; ///< The generation of each slot, incremented if the slot is freed.
+    uint8_t _mergeIndex[cMergeIndexArraySize]; ///< The open-addressed hash index with the slots of all entries.
+    Entry _entryList[entryListSize]; ///< The pool with all entries.
+};
+
+
+}
+}
+
+
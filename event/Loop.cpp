@@ -17,23 +17,80 @@
 //
 #include "Loop.hpp"
 
+#if LR_CORE_COUNT > 1
+#include "StealPool.hpp"
+#endif
+
 
 namespace lr {
 namespace event {
 
 
-Loop *Loop::_main = nullptr;
+#if LR_CORE_COUNT > 1
+namespace {
+StealPool<> gStealPool; ///< The pool with events for any loop.
+}
+#endif
+
+
+Loop *Loop::_main[Core::cCount] = {};
 
 
 Loop::Loop()
+    : Loop(0)
+{
+}
+
+
+Loop::Loop(uint8_t coreIndex)
+    : _coreIndex(coreIndex)
+{
+    _main[coreIndex] = this;
+}
+
+
+bool Loop::addStealableEvent(const Call &call)
 {
-    _main = this;
+#if LR_CORE_COUNT > 1
+    if (gStealPool.push(call)) {
+        Core::signalOtherCores();
+        return true;
+    }
+#endif
+    return addImmediateEvent(call).isValid();
 }
 
 
 Loop& Loop::main()
 {
-    return *_main;
+    return *_main[Core::currentIndex()];
+}
+
+
+Loop& Loop::forCore(uint8_t coreIndex)
+{
+    return *_main[coreIndex];
+}
+
+
+bool Loop::takeStealableEvent(Call &call)
+{
+#if LR_CORE_COUNT > 1
+    return gStealPool.take(call);
+#else
+    (void)call;
+    return false;
+#endif
+}
+
+
+bool Loop::hasStealableEvents()
+{
+#if LR_CORE_COUNT > 1
+    return !gStealPool.isEmpty();
+#else
+    return false;
+#endif
 }
 
 
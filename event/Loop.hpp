@@ -19,7 +19,11 @@
 
 
 #include "Entry.hpp"
+#include "Handle.hpp"
+#include "Profiler.hpp"
+#include "SubmissionQueue.hpp"
 
+#include "../Core.hpp"
 #include "../Timer.hpp"
 #include "../InterruptLock.hpp"
 
@@ -32,13 +36,26 @@ namespace event {
 
 /// The abstract interface to access the event loop through the whole application.
 ///
+/// All methods to add events accept an `event::Call`. This can be a plain function, a captureless
+/// lambda, a function with a context pointer or a member function of an object.
+///
 class Loop
 {
 public:
     /// The constructor, initializing the main instance pointer.
     ///
+    /// This loop becomes the main loop for the first core.
+    ///
     Loop();
 
+    /// The constructor, initializing the main instance pointer for a core.
+    ///
+    /// On multi core platforms, create one loop for each core which processes events.
+    ///
+    /// @param coreIndex The index of the core which runs this loop.
+    ///
+    explicit Loop(uint8_t coreIndex);
+
 public:
     /// Exit this event loop.
     ///
@@ -51,48 +68,125 @@ public:
     ///
     /// This event will be executed as soon as possible from the main loop.
     ///
-    /// @param fn The function to execute for the event.
+    /// @param call The call to execute for the event.
     /// @param merge Merge similar events. If the same event call is added several times, only the last is executed.
+    /// @param priority The priority of the event.
+    /// @return The handle for the event, or an invalid handle if the loop is full.
     ///
-    virtual void addImmediateEvent(Entry::Function fn, bool merge = false) = 0;
+    virtual Handle addImmediateEvent(const Call &call, bool merge = false, Priority priority = Priority::Normal) = 0;
 
     /// Add a repeated polling event at the speed of the loop.
     ///
     /// This event is called each time the event loop is checked for new events. This happens approximate
     /// every 1 milliseconds, unless the loop gets blocked for a longer time.
     ///
-    /// @param fn The function to execute for the event.
+    /// In tickless idle mode, a poll event which does not block sleep is only called if the loop
+    /// wakes up for another reason, like an interrupt or an expired delayed event.
     ///
-    virtual void addPollEvent(Entry::Function fn) = 0;
+    /// @param call The call to execute for the event.
+    /// @param blockSleep If the event prevents the loop from sleeping in tickless idle mode.
+    /// @param priority The priority of the event.
+    /// @return The handle for the event, or an invalid handle if the loop is full.
+    ///
+    virtual Handle addPollEvent(const Call &call, bool blockSleep = true, Priority priority = Priority::Normal) = 0;
 
     /// Add a single delayed event.
     ///
     /// This event will be executed after the specified delay in milliseconds once.
     ///
-    /// @param fn The function to execute for the event.
+    /// @param call The call to execute for the event.
     /// @param delay The delay in milliseconds. Use delays up to a minute.
     /// @param merge Merge similar events. If the same event call is added several times, only the last is executed.
+    /// @param priority The priority of the event.
+    /// @return The handle for the event, or an invalid handle if the loop is full.
     ///
-    virtual void addDelayedEvent(Entry::Function fn, Milliseconds delay, bool merge = false) = 0;
+    virtual Handle addDelayedEvent(const Call &call, Milliseconds delay, bool merge = false,
+        Priority priority = Priority::Normal) = 0;
 
     /// Add a repeated event which is called infinite at the given interval.
     ///
-    /// @param fn The function to execute for the event.
-    /// @param delay The delay in milliseconds which is also the interval. This value is limited
-    ///              to the range of 1-32767 milliseconds. The behaviour for other values is undefined.
+    /// The event keeps a fixed phase: each expire time is calculated from the previous one,
+    /// independent of how late the event was executed.
+    ///
+    /// @param call The call to execute for the event.
+    /// @param delay The delay in milliseconds which is also the interval. Intervals up to 65535
+    ///              milliseconds are exact, longer intervals are rounded to full seconds, up to
+    ///              about 18 hours. An interval of zero is undefined.
+    /// @param priority The priority of the event.
+    /// @param repeatPolicy The policy if executions were missed.
+    /// @return The handle for the event, or an invalid handle if the loop is full.
     ///
-    virtual void addRepeatedEvent(Entry::Function fn, Milliseconds delay) = 0;
+    virtual Handle addRepeatedEvent(const Call &call, Milliseconds delay, Priority priority = Priority::Normal,
+        RepeatPolicy repeatPolicy = RepeatPolicy::Skip) = 0;
 
     /// Add an event on interrupt.
     ///
     /// This event will be executed if one of the interrupt flags was set.
     /// It will be executed once, unless `repeat` is set to `true`.
     ///
-    /// @param fn The function to execute for the event.
+    /// @param call The call to execute for the event.
     /// @param interruptFlags The interrupt flags to react to.
     /// @param repeat If this is set to `true`, the event is executed every time the interrupt flags are set.
+    /// @param priority The priority of the event.
+    /// @return The handle for the event, or an invalid handle if the loop is full.
+    ///
+    virtual Handle addInterruptEvent(const Call &call, event::InterruptFlags interruptFlags, bool repeat = false,
+        Priority priority = Priority::Normal) = 0;
+
+    /// Cancel an event.
+    ///
+    /// The event is removed from the loop and not executed anymore. It is safe to cancel
+    /// an event from its own call, or to use a handle of an event which was already removed.
+    ///
+    /// @param handle The handle of the event, returned when the event was added.
+    /// @return `true` if the event was cancelled, `false` if there is no event for the handle.
     ///
-    virtual void addInterruptEvent(Entry::Function fn, event::InterruptFlags interruptFlags, bool repeat = false) = 0;
+    virtual bool cancel(Handle handle) = 0;
+
+    /// Reschedule a delayed or repeated event.
+    ///
+    /// The event is executed after the given delay from now. For repeated events, only the next
+    /// execution is moved, the interval is not changed.
+    ///
+    /// @param handle The handle of the event, returned when the event was added.
+    /// @param delay The new delay in milliseconds. Use delays up to a minute.
+    /// @return `true` if the event was rescheduled, `false` if there is no delayed or repeated
+    ///     event for the handle.
+    ///
+    virtual bool reschedule(Handle handle, Milliseconds delay) = 0;
+
+    /// Check if an event with the given call is pending.
+    ///
+    /// This can be used to skip adding an event, which would be merged anyway. Events which
+    /// were added from an interrupt are not visible, until they are moved into the loop at the
+    /// start of the next pass.
+    ///
+    /// @param call The call to search.
+    /// @return `true` if at least one event with the given call is in the loop.
+    ///
+    virtual bool isPending(const Call &call) const = 0;
+
+    /// Add an immediate event from an interrupt.
+    ///
+    /// The event is pushed into a lock-free submission queue, which is drained at the start
+    /// of each event processing pass. Only call this method from one interrupt context, or protect
+    /// the calls if interrupts can preempt each other.
+    ///
+    /// @param call The call to execute for the event.
+    /// @param merge Merge similar events. If the same event call is added several times, only the last is executed.
+    /// @return `true` if the event was queued, `false` if the submission queue is full.
+    ///
+    virtual bool addImmediateEventFromInterrupt(const Call &call, bool merge = false) = 0;
+
+    /// Add a single delayed event from an interrupt.
+    ///
+    /// @see addImmediateEventFromInterrupt()
+    /// @param call The call to execute for the event.
+    /// @param delay The delay in milliseconds. Use delays up to a minute.
+    /// @param merge Merge similar events. If the same event call is added several times, only the last is executed.
+    /// @return `true` if the event was queued, `false` if the submission queue is full.
+    ///
+    virtual bool addDelayedEventFromInterrupt(const Call &call, Milliseconds delay, bool merge = false) = 0;
 
     /// Set an interrupt flag.
     ///
@@ -102,17 +196,61 @@ public:
     ///
     virtual void signalInterrupt(event::InterruptFlags interruptFlags) = 0;
 
+    /// Add an immediate event from another core.
+    ///
+    /// Use this method to add an event to the loop of another core. The event is pushed into
+    /// a lock-free queue for the calling core, and the other core is woken up. If called from
+    /// the core of this loop, the event is added directly. On single core platforms, this is
+    /// the same as `addImmediateEvent()`. Do not call this method from an interrupt.
+    ///
+    /// @param call The call to execute for the event.
+    /// @return `true` if the event was added, `false` if the queue or the loop is full.
+    ///
+    virtual bool post(const Call &call) = 0;
+
+    /// Add an immediate event, which can be executed by any loop.
+    ///
+    /// On multi core platforms, the event is added to a pool shared by all loops, and the
+    /// first loop which is idle executes it. If the pool is full, the event is added to
+    /// this loop. On single core platforms, the event is added to this loop.
+    ///
+    /// @param call The call to execute for the event.
+    /// @return `true` if the event was added, `false` if the pool and the loop are full.
+    ///
+    bool addStealableEvent(const Call &call);
+
 public:
-    /// Access the main event loop.
+    /// Access the main event loop of the current core.
     ///
     static Loop& main();
 
+    /// Access the event loop of a core.
+    ///
+    /// @param coreIndex The index of the core.
+    ///
+    static Loop& forCore(uint8_t coreIndex);
+
+protected:
+    /// Take an event from the pool with events for any loop.
+    ///
+    /// @param call The variable to store the call.
+    /// @return `true` if an event was taken.
+    ///
+    static bool takeStealableEvent(Call &call);
+
+    /// Check if there are events in the pool with events for any loop.
+    ///
+    static bool hasStealableEvents();
+
+protected:
+    uint8_t _coreIndex; ///< The index of the core for this loop.
+
 private:
-    static Loop *_main; ///< The main instance of the event loop.
+    static Loop *_main[Core::cCount]; ///< The main instance of the event loop for each core.
 };
 
 
-/// Access the main loop.
+/// Access the main loop of the current core.
 ///
 inline Loop& mainLoop() {
     return Loop::main();
@@ -122,6 +260,9 @@ inline Loop& mainLoop() {
 /// This is a static implementation of the entry storage.
 ///
 /// It uses a static array for the entry list to avoid dynamic memory allocation.
+/// Each entry gets a unique 16-bit handle value. Cancelling and rescheduling entries
+/// searches the handle in the list, which is fast for the small number of entries
+/// this storage is made for.
 ///
 template<uint8_t entryListSize = 32>
 class StaticStorage
@@ -129,29 +270,96 @@ class StaticStorage
 public:
     /// Create a new empty storage instance.
     ///
-    constexpr StaticStorage() : _count(0), _index(0) {}
+    constexpr StaticStorage()
+        : _count(0), _index(0), _passPosition(0), _passCount(0), _passPriority(0), _nextHandleValue(0),
+        _passTime(), _priorityCount(), _handleList(), _entryList() {}
 
 public: // Implement all required storage methods
     /// Add an entry to the current storage.
     ///
     /// @param entry The entry to add.
     /// @param merge If the entry shall be merged with existing ones.
+    /// @return The handle for the added entry, the handle of the existing entry if the entry
+    ///     was merged, or an invalid handle if the storage is full.
     ///
-    void addEntry(const Entry &entry, bool merge) {
-        if (_count == entryListSize) {
-            return; // Skip new entries if the list is full.
-        }
+    Handle addEntry(const Entry &entry, bool merge) {
         if (merge && _count > 0) {
             // Search for entries which can be merged.
             for (uint8_t i = 0; i < _count; ++i) {
                 if (entry.canMerge(_entryList[i])) {
                     // Just ignore this, if we found one.
-                    return;
+                    return _handleList[i];
                 }
             }
         }
+        if (_count == entryListSize) {
+            return Handle(); // Skip new entries if the list is full.
+        }
+        const Handle handle(_nextHandleValue);
+        _nextHandleValue += 1;
+        if (_nextHandleValue == Handle::cInvalidValue) {
+            _nextHandleValue = 0;
+        }
+        _handleList[_count] = handle;
         _entryList[_count] = entry;
         _count += 1;
+        _priorityCount[static_cast<uint8_t>(entry.getPriority())] += 1;
+        return handle;
+    }
+
+    /// Cancel an entry.
+    ///
+    /// The entry is removed from the storage. If it is cancelled while a pass is processed,
+    /// it is not returned by `takeReady()` anymore.
+    ///
+    /// @param handle The handle of the entry.
+    /// @return `true` if the entry was removed, `false` if the handle is stale or invalid.
+    ///
+    bool cancel(Handle handle) {
+        const uint8_t position = findHandle(handle);
+        if (position == _count) {
+            return false;
+        }
+        removeEntryAt(position);
+        if (position < _passPosition) {
+            --_passPosition;
+        }
+        if (position < _passCount) {
+            --_passCount;
+        }
+        return true;
+    }
+
+    /// Reschedule a delayed or repeated entry.
+    ///
+    /// For repeated entries, only the next execution is moved and the interval is kept.
+    ///
+    /// @param handle The handle of the entry.
+    /// @param expireTime The new expire time for the entry.
+    /// @return `true` if the entry was rescheduled, `false` if the handle is stale or invalid,
+    ///     or the entry is not a delayed or repeated one.
+    ///
+    bool reschedule(Handle handle, Milliseconds expireTime) {
+        const uint8_t position = findHandle(handle);
+        if (position == _count || !_entryList[position].isTimed()) {
+            return false;
+        }
+        _entryList[position].setExpireTime(expireTime);
+        return true;
+    }
+
+    /// Check if an entry with the given call is in the storage.
+    ///
+    /// @param call The call to search.
+    /// @return `true` if there is at least one entry with this call.
+    ///
+    bool isPending(const Call &call) const {
+        for (uint8_t i = 0; i < _count; ++i) {
+            if (_entryList[i].getCall() == call) {
+                return true;
+            }
+        }
+        return false;
     }
 
     /// Get the current number of entries.
@@ -183,19 +391,141 @@ public: // Implement all required storage methods
         if (position >= _count) {
             return;
         }
+        _priorityCount[static_cast<uint8_t>(_entryList[position].getPriority())] -= 1;
         // To delete the last element, just decrease the count.
         const auto lastElement = (_count - 1);
         if (position < lastElement) {
             for (uint8_t i = position; i < lastElement; ++i) {
                 _entryList[i] = _entryList[i + 1];
+                _handleList[i] = _handleList[i + 1];
             }
         }
         _count -= 1;
     }
 
+    /// Start a new pass to process the ready entries.
+    ///
+    /// Only entries which are in the storage at the start of the pass are processed. This
+    /// prevents endless loops from events which add new events. On-interrupt entries which
+    /// match the interrupt flags are marked as triggered.
+    ///
+    /// @param currentTime The current time for this pass.
+    /// @param interruptFlags The interrupt flags for this pass.
+    ///
+    inline void beginPass(Milliseconds currentTime, InterruptFlags interruptFlags) {
+        if (interruptFlags.isOneSet()) {
+            for (uint8_t i = 0; i < _count; ++i) {
+                if (_entryList[i].isOnInterrupt()) {
+                    _entryList[i].trigger(interruptFlags);
+                }
+            }
+        }
+        _passTime = currentTime;
+        _passPosition = 0;
+        _passCount = _count;
+        _passPriority = cPriorityCount - 1;
+    }
+
+    /// Take the next ready entry from the current pass.
+    ///
+    /// Entries are taken in the order of their priority. Single events are removed from the
+    /// storage, repeated events are updated for their next execution. Ready entries with a
+    /// priority below `lowestPriority` stay in the storage, and are taken in the next pass.
+    ///
+    /// @param entry The variable to store a copy of the ready entry, before it is updated.
+    /// @param lowestPriority The lowest priority of the entries to take.
+    /// @return `true` if a ready entry was found, `false` if the pass is finished.
+    ///
+    bool takeReady(Entry &entry, Priority lowestPriority = Priority::Low) {
+        while (_passPriority >= static_cast<uint8_t>(lowestPriority)) {
+            if (_priorityCount[_passPriority] > 0) {
+                while (_passPosition < _passCount) {
+                    auto &event = _entryList[_passPosition];
+                    if (static_cast<uint8_t>(event.getPriority()) == _passPriority
+                        && event.isReady(_passTime, InterruptFlags())) {
+                        // Remove the event first, to prevent merge issues.
+                        if (event.isRemovedAfterCall()) {
+                            entry = event;
+                            removeEntryAt(_passPosition);
+                            --_passCount;
+                        } else {
+                            entry = event;
+                            event.updateExpireTime(_passTime);
+                            event.clearTriggered();
+                            ++_passPosition;
+                        }
+                        return true;
+                    }
+                    ++_passPosition;
+                }
+            }
+            if (_passPriority == 0) {
+                break;
+            }
+            --_passPriority;
+            _passPosition = 0;
+        }
+        return false;
+    }
+
+    /// Get the deadline until the loop can sleep.
+    ///
+    /// @param currentTime The current time.
+    /// @param deadline The latest deadline on input. This variable is set to the earliest expire
+    ///     time of all timed entries, if this is before the given deadline.
+    /// @return `true` if the loop can sleep until `deadline`, `false` if an entry is ready or
+    ///     an entry blocks sleeping.
+    ///
+    bool getSleepDeadline(Milliseconds currentTime, Milliseconds &deadline) const {
+        for (uint8_t i = 0; i < _count; ++i) {
+            const auto &event = _entryList[i];
+            if (event.isImmediate()) {
+                if (event.isRemovedAfterCall() || event.isBlockingSleep()) {
+                    return false;
+                }
+            } else if (event.isOnInterrupt()) {
+                if (event.isTriggered()) {
+                    return false;
+                }
+            } else {
+                const auto expireTime = event.getExpireTime();
+                if (currentTime.deltaTo(expireTime) <= 0) {
+                    return false;
+                }
+                if (expireTime.deltaTo(deadline) > 0) {
+                    deadline = expireTime;
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    /// Find the position of the entry with the given handle.
+    ///
+    /// @return The position of the entry, or the number of entries if there is no such entry.
+    ///
+    inline uint8_t findHandle(Handle handle) const {
+        if (!handle.isValid()) {
+            return _count;
+        }
+        uint8_t position = 0;
+        while (position < _count && _handleList[position] != handle) {
+            ++position;
+        }
+        return position;
+    }
+
 private:
     uint8_t _count; ///< The number of entries in the list.
     uint8_t _index; ///< The index of the first entry in the list.
+    uint8_t _passPosition; ///< The position of the current pass.
+    uint8_t _passCount; ///< The number of entries to process in the current pass.
+    uint8_t _passPriority; ///< The priority level processed in the current pass.
+    Handle::ValueType _nextHandleValue; ///< The value for the next handle.
+    Milliseconds _passTime; ///< The time of the current pass.
+    uint8_t _priorityCount[cPriorityCount]; ///< The number of entries for each priority.
+    Handle _handleList[entryListSize]; ///< The handles for the entries in the list.
     Entry _entryList[entryListSize]; ///< The list of entries.
 };
 
@@ -205,15 +535,88 @@ private:
 /// This basic event loop system is designed for embedded applications.
 /// This event loop can not be used directly from an interrupt.
 ///
-template<typename StorageClass>
-class BasicLoop : public Loop
+/// The storage class has to implement the methods `addEntry()`, `cancel()`, `reschedule()`,
+/// `isPending()`, `beginPass()`, `takeReady()` and `getSleepDeadline()` like `StaticStorage`. Use `StaticStorage` for a small number of events,
+/// and `IndexedStorage` for many delayed and repeated events.
+///
+/// The profiler class is a policy, which is called for each pass and event. The default
+/// `NoProfiler` has only empty methods, which compile away and use no memory. Use `Profiler`
+/// to record statistics about the events.
+///
+/// @tparam StorageClass The implementation of the entry storage.
+/// @tparam submissionQueueSize The size of the queue for events added from interrupts.
+/// @tparam ProfilerClass The profiler policy.
+///
+template<typename StorageClass, uint8_t submissionQueueSize = 8, typename ProfilerClass = NoProfiler>
+class BasicLoop : public Loop, private ProfilerClass
 {
+public:
+    /// The idle mode of the loop.
+    ///
+    enum class IdleMode : uint8_t {
+        WaitForTick, ///< Wait for the next tick of the real time counter, before events are processed.
+        Tickless, ///< Sleep until the next event is ready or an interrupt occurs.
+    };
+
 public:
     /// Create a new event loop.
     ///
-    constexpr BasicLoop() : _interruptFlags(0), _exitRequested(false), _storage() {}
+    constexpr BasicLoop() : BasicLoop(0) {}
+
+    /// Create a new event loop for a core.
+    ///
+    /// @param coreIndex The index of the core which runs this loop.
+    ///
+    constexpr explicit BasicLoop(uint8_t coreIndex)
+        : Loop(coreIndex), _interruptFlags(0), _exitRequested(false), _idleMode(IdleMode::WaitForTick),
+        _maximumSleepDuration(1000_ms), _timeBudget(0_ms), _storage(), _submissionQueue() {}
 
 public:
+    /// Set the idle mode for the loop.
+    ///
+    /// In `Tickless` mode, the loop calculates the earliest expire time of all delayed and repeated
+    /// events and sleeps until this time using `Timer::sleepUntil()`. Any interrupt wakes the
+    /// loop. Immediate events and poll events which block sleep prevent sleeping, in this case the
+    /// loop waits for the next tick as in `WaitForTick` mode.
+    ///
+    /// @param idleMode The new idle mode.
+    ///
+    inline void setIdleMode(IdleMode idleMode) {
+        _idleMode = idleMode;
+    }
+
+    /// Set the maximum sleep duration in tickless mode.
+    ///
+    /// @param duration The maximum duration to sleep, if there is no other event. The default is one second.
+    ///
+    inline void setMaximumSleepDuration(Milliseconds duration) {
+        _maximumSleepDuration = duration;
+    }
+
+    /// Set the time budget for each pass.
+    ///
+    /// If processing the events of a pass takes longer than the budget, only high priority events
+    /// are executed for the rest of the pass. All other ready events are carried over to the next
+    /// pass. The budget is checked after each event, a single slow event is not interrupted.
+    ///
+    /// @param budget The time budget for a pass. Use `0_ms` to disable the budget, which is the default.
+    ///
+    inline void setTimeBudget(Milliseconds budget) {
+        _timeBudget = budget;
+    }
+
+    /// Access the profiler of this loop.
+    ///
+    inline ProfilerClass& getProfiler() {
+        return *this;
+    }
+
+    /// Access the profiler of this loop.
+    ///
+    inline const ProfilerClass& getProfiler() const {
+        return *this;
+    }
+
     /// Process the events once.
     ///
     /// Call this function from an existing `loop()` method. It will wait for the next tick and
@@ -221,7 +624,11 @@ public:
     /// the `loop()` call.
     ///
     inline void loopOnce() {
-        Timer::waitForNextTick();
+        if (_idleMode == IdleMode::Tickless) {
+            sleepUntilNextEvent();
+        } else {
+            Timer::waitForNextTick();
+        }
         processEvents();
     }
 
@@ -240,32 +647,47 @@ public:
     /// This will process the current event list once.
     ///
     void processEvents() {
-        // The process position.
-        uint8_t position = 0;
-        // The process count, this copy is required prevent endless event loops.
-        uint8_t count = _storage.getCount();
+        // Move all events submitted from interrupts into the storage.
+        Entry event;
+        bool merge;
+        while (_submissionQueue.pop(event, merge)) {
+            _storage.addEntry(event, merge);
+        }
+#if LR_CORE_COUNT > 1
+        for (auto &postQueue : _postQueues) {
+            while (postQueue.pop(event, merge)) {
+                _storage.addEntry(event, merge);
+            }
+        }
+#endif
         // The current time and interrupt flags for a processed events.
         const auto currentTime = Timer::tickMilliseconds();
         const auto interruptFlags = getAndClearInterruptFlags();
-        while (position < count) {
-            auto &event = _storage.entryAt(position);
-            if (event.isReady(currentTime, interruptFlags)) {
-                // Keep a copy of the call which is valid after removing the event.
-                const auto call = event.getCall();
-                // Remove the event first, to prevent merge issues.
-                if (event.isRemovedAfterCall()) {
-                    _storage.removeEntryAt(position);
-                    --count;
-                } else {
-                    event.updateExpireTime(currentTime);
-                    ++position;
-                }
-                // At this point, in the `call`, new events may be added to the event queue.
-                call();
-            } else {
-                ++position;
+        _storage.beginPass(currentTime, interruptFlags);
+        ProfilerClass::beginPass(currentTime);
+        // The storage returns a copy, which is valid after removing the event.
+        auto lowestPriority = Priority::Low;
+        while (_storage.takeReady(event, lowestPriority)) {
+            ProfilerClass::beginEvent(event);
+            // At this point, in the call, new events may be added to the event queue.
+            event.getCall()();
+            ProfilerClass::endEvent(event);
+            if (_timeBudget > 0_ms && lowestPriority != Priority::High
+                && (Timer::tickMilliseconds() - currentTime) >= _timeBudget) {
+                lowestPriority = Priority::High;
             }
         }
+#if LR_CORE_COUNT > 1
+        // Help with the events for any loop, as long there is time left.
+        Call call;
+        while (lowestPriority != Priority::High && takeStealableEvent(call)) {
+            call();
+            if (_timeBudget > 0_ms && (Timer::tickMilliseconds() - currentTime) >= _timeBudget) {
+                lowestPriority = Priority::High;
+            }
+        }
+#endif
+        ProfilerClass::endPass();
     }
 
 public: // Implement Loop
@@ -273,35 +695,80 @@ public: // Implement Loop
         _exitRequested = true;
     }
 
-    void addImmediateEvent(Entry::Function fn, bool merge) override {
+    Handle addImmediateEvent(const Call &call, bool merge, Priority priority) override {
         const Entry::Flags flags = Entry::Flag::Valid | Entry::Flag::Immediate;
-        _storage.addEntry(Entry(flags, fn, 0_ms), merge);
+        return _storage.addEntry(Entry(flags, call, 0_ms, priority), merge);
     }
 
-    void addPollEvent(Entry::Function fn) override {
-        const auto flags = Entry::Flag::Valid | Entry::Flag::Immediate | Entry::Flag::Repeat;
-        _storage.addEntry(Entry(flags, fn, 0_ms), false);
+    Handle addPollEvent(const Call &call, bool blockSleep, Priority priority) override {
+        auto flags = Entry::Flag::Valid | Entry::Flag::Immediate | Entry::Flag::Repeat;
+        if (blockSleep) {
+            flags |= Entry::Flag::BlockSleep;
+        }
+        return _storage.addEntry(Entry(flags, call, 0_ms, priority), false);
     }
 
-    void addDelayedEvent(Entry::Function fn, Milliseconds delay, bool merge) override {
+    Handle addDelayedEvent(const Call &call, Milliseconds delay, bool merge, Priority priority) override {
         const auto flags = Entry::Flag::Valid;
         const auto expireTime = Timer::tickMilliseconds() + delay;
-        _storage.addEntry(Entry(flags, fn, expireTime), merge);
+        return _storage.addEntry(Entry(flags, call, expireTime, priority), merge);
     }
 
-    void addRepeatedEvent(Entry::Function fn, Milliseconds delay) override {
-        const auto flags = Entry::Flag::Valid | Entry::Flag::Repeat;
-        const auto intervalMs = static_cast<uint16_t>(delay.ticks());
-        const uint16_t expireTimeMs = static_cast<uint16_t>(Timer::tickMilliseconds().ticks()) + intervalMs;
-        _storage.addEntry(Entry(flags, fn, expireTimeMs, intervalMs), false);
+    Handle addRepeatedEvent(const Call &call, Milliseconds delay, Priority priority,
+        RepeatPolicy repeatPolicy) override {
+        auto flags = Entry::Flag::Valid | Entry::Flag::Repeat;
+        if (repeatPolicy == RepeatPolicy::CatchUp) {
+            flags |= Entry::Flag::CatchUp;
+        }
+        const auto expireTime = Timer::tickMilliseconds() + delay;
+        return _storage.addEntry(Entry(flags, call, expireTime, delay, priority), false);
     }
 
-    void addInterruptEvent(Entry::Function fn, event::InterruptFlags interruptFlags, bool repeat) override {
+    Handle addInterruptEvent(const Call &call, event::InterruptFlags interruptFlags, bool repeat,
+        Priority priority) override {
         auto flags = Entry::Flag::Valid | Entry::Flag::OnInterrupt;
         if (repeat) {
             flags |= Entry::Flag::Repeat;
         }
-        _storage.addEntry(Entry(flags, fn, interruptFlags), false);
+        return _storage.addEntry(Entry(flags, call, interruptFlags, priority), false);
+    }
+
+    bool cancel(Handle handle) override {
+        return _storage.cancel(handle);
+    }
+
+    bool reschedule(Handle handle, Milliseconds delay) override {
+        return _storage.reschedule(handle, Timer::tickMilliseconds() + delay);
+    }
+
+    bool isPending(const Call &call) const override {
+        return _storage.isPending(call);
+    }
+
+    bool post(const Call &call) override {
+#if LR_CORE_COUNT > 1
+        const auto coreIndex = Core::currentIndex();
+        if (coreIndex != _coreIndex) {
+            const Entry::Flags flags = Entry::Flag::Valid | Entry::Flag::Immediate;
+            if (!_postQueues[coreIndex].push(Entry(flags, call, 0_ms), false)) {
+                return false;
+            }
+            Core::signalOtherCores();
+            return true;
+        }
+#endif
+        return addImmediateEvent(call, false, Priority::Normal).isValid();
+    }
+
+    bool addImmediateEventFromInterrupt(const Call &call, bool merge) override {
+        const Entry::Flags flags = Entry::Flag::Valid | Entry::Flag::Immediate;
+        return _submissionQueue.push(Entry(flags, call, 0_ms), merge);
+    }
+
+    bool addDelayedEventFromInterrupt(const Call &call, Milliseconds delay, bool merge) override {
+        const auto flags = Entry::Flag::Valid;
+        const auto expireTime = Timer::tickMilliseconds() + delay;
+        return _submissionQueue.push(Entry(flags, call, expireTime), merge);
     }
 
     void signalInterrupt(event::InterruptFlags interruptFlags) override {
@@ -309,9 +776,45 @@ public: // Implement Loop
     }
 
 private:
+    /// Sleep until the next event is ready.
+    ///
+    /// If sleeping is not possible, this waits for the next tick.
+    ///
+    void sleepUntilNextEvent() {
+        const auto currentTime = Timer::tickMilliseconds();
+        auto deadline = currentTime + _maximumSleepDuration;
+        if (_interruptFlags == 0 && _submissionQueue.isEmpty() && !hasPostedEvents()
+            && _storage.getSleepDeadline(currentTime, deadline)) {
+            if (currentTime.deltaTo(deadline) > 1) {
+                Timer::sleepUntil(deadline);
+                return;
+            }
+        }
+        Timer::waitForNextTick();
+    }
+
+    /// Check if there are events posted from other cores or events for any loop.
+    ///
+    inline bool hasPostedEvents() const {
+#if LR_CORE_COUNT > 1
+        for (const auto &postQueue : _postQueues) {
+            if (!postQueue.isEmpty()) {
+                return true;
+            }
+        }
+        return hasStealableEvents();
+#else
+        return false;
+#endif
+    }
+
     /// Get the current interrupt flags and clear them.
     ///
     InterruptFlags getAndClearInterruptFlags() {
+        // Reading the flags is atomic, only lock the interrupts if there is something to clear.
+        if (_interruptFlags == 0) {
+            return InterruptFlags();
+        }
         InterruptLock lock;
         const auto flagsCopy = _interruptFlags;
         _interruptFlags = 0;
@@ -321,7 +824,14 @@ private:
 private:
     volatile uint16_t _interruptFlags; ///< The current interrupt flags.
     bool _exitRequested; ///< Flag is exit of this event loop was requested.
+    IdleMode _idleMode; ///< The idle mode of the loop.
+    Milliseconds _maximumSleepDuration; ///< The maximum duration to sleep in tickless mode.
+    Milliseconds _timeBudget; ///< The time budget for a pass, or zero for no budget.
     StorageClass _storage; ///< The implementation of the entry storage.
+    SubmissionQueue<submissionQueueSize> _submissionQueue; ///< The queue for events added from interrupts.
+#if LR_CORE_COUNT > 1
+    SubmissionQueue<submissionQueueSize> _postQueues[Core::cCount]; ///< The queues for events posted from each core.
+#endif
 };
 
 
@@ -0,0 +1,312 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+#include "Entry.hpp"
+
+#include "../String.hpp"
+#include "../StringWriter.hpp"
+#include "../Timer.hpp"
+
+#include <cstdint>
+
+
+namespace lr {
+namespace event {
+
+
+/// The profiler policy for a loop without profiling.
+///
+/// All methods are empty and compile away. This is the default for `BasicLoop`.
+///
+class NoProfiler
+{
+public:
+    /// Ignored.
+    ///
+    inline void beginPass(Milliseconds) {}
+
+    /// Ignored.
+    ///
+    inline void beginEvent(const Entry&) {}
+
+    /// Ignored.
+    ///
+    inline void endEvent(const Entry&) {}
+
+    /// Ignored.
+    ///
+    inline void endPass() {}
+};
+
+
+/// A profiler policy which records statistics for the events of a loop.
+///
+/// For each event call, it records the number of dispatches, the total and maximum run time,
+/// and the total and maximum lateness of delayed and repeated events. The lateness is the time
+/// between the expire time of the event, and the time it was actually executed. For each pass,
+/// the run time is recorded in a histogram with power of four buckets.
+///
+/// The run times of events and passes are measured in microseconds, using `Timer::tickMicroseconds()`.
+/// A single measurement has to be shorter than the 71 minutes range of this counter. The lateness
+/// and the utilisation are measured in milliseconds, like the expire times of the events.
+///
+/// Usage:
+/// ```
+/// event::BasicLoop<event::StaticStorage<>, 8, event::Profiler<16>> gEventLoop;
+/// // ...
+/// gEventLoop.getProfiler().writeReport(gShellWriter);
+/// ```
+///
+/// @tparam callListSize The maximum number of different calls to record.
+///
+template<uint8_t callListSize = 16>
+class Profiler
+{
+public:
+    /// The statistics for a single call.
+    ///
+    struct CallStatistics {
+        Call call; ///< The recorded call.
+        uint32_t count; ///< The number of dispatches.
+        uint64_t totalTime; ///< The total run time in microseconds.
+        uint32_t totalLateness; ///< The total lateness in milliseconds.
+        uint32_t maximumTime; ///< The maximum run time in microseconds.
+        uint16_t maximumLateness; ///< The maximum lateness in milliseconds.
+    };
+
+    /// The number of buckets in the pass histogram.
+    ///
+    /// Bucket 0 counts passes up to 15µs, bucket 1 with 16-63µs, bucket 2 with 64-255µs, bucket 3
+    /// with 256-1023µs and so on. The last bucket counts all passes of 65536µs and longer.
+    ///
+    constexpr static uint8_t cHistogramSize = 8;
+
+    /// The limit of the first bucket in the pass histogram, in microseconds.
+    ///
+    constexpr static uint32_t cHistogramFirstLimit = 16;
+
+public:
+    /// Create a new profiler.
+    ///
+    Profiler() : _callCount(0), _droppedCount(0), _passCount(0), _busyTime(0),
+        _startTime(Timer::tickMilliseconds()), _passStart(), _eventStart(), _currentIndex(0),
+        _histogram(), _callList() {}
+
+public: // Policy interface
+    /// Called at the start of each pass.
+    ///
+    inline void beginPass(Milliseconds) {
+        _passStart = Timer::tickMicroseconds();
+    }
+
+    /// Called before an event is executed.
+    ///
+    /// @param entry The entry for the event.
+    ///
+    void beginEvent(const Entry &entry) {
+        _currentIndex = findCall(entry.getCall());
+        if (_currentIndex != cNoIndex && entry.isTimed()) {
+            const auto lateness = entry.getExpireTime().deltaTo(Timer::tickMilliseconds());
+            if (lateness > 0) {
+                auto &statistics = _callList[_currentIndex];
+                statistics.totalLateness += static_cast<uint32_t>(lateness);
+                statistics.maximumLateness = limited(static_cast<uint32_t>(lateness), statistics.maximumLateness);
+            }
+        }
+        _eventStart = Timer::tickMicroseconds();
+    }
+
+    /// Called after an event was executed.
+    ///
+    void endEvent(const Entry&) {
+        if (_currentIndex == cNoIndex) {
+            return;
+        }
+        const auto duration = (Timer::tickMicroseconds() - _eventStart).ticks();
+        auto &statistics = _callList[_currentIndex];
+        statistics.count += 1;
+        statistics.totalTime += duration;
+        if (duration > statistics.maximumTime) {
+            statistics.maximumTime = duration;
+        }
+    }
+
+    /// Called at the end of each pass.
+    ///
+    void endPass() {
+        const auto duration = (Timer::tickMicroseconds() - _passStart).ticks();
+        _passCount += 1;
+        _busyTime += duration;
+        uint8_t bucket = 0;
+        while (bucket < (cHistogramSize - 1) && duration >= (cHistogramFirstLimit << (2 * bucket))) {
+            ++bucket;
+        }
+        _histogram[bucket] += 1;
+    }
+
+public:
+    /// Reset all recorded statistics.
+    ///
+    void reset() {
+        *this = Profiler();
+    }
+
+    /// Get the number of recorded calls.
+    ///
+    inline uint8_t getCallCount() const {
+        return _callCount;
+    }
+
+    /// Access the statistics for a recorded call.
+    ///
+    /// @param index The index of the call, from 0 to `getCallCount() - 1`.
+    /// @return The statistics for the call.
+    ///
+    inline const CallStatistics& getCallStatistics(uint8_t index) const {
+        return _callList[index];
+    }
+
+    /// Get the number of dispatches which were not recorded, because the call list was full.
+    ///
+    inline uint32_t getDroppedCount() const {
+        return _droppedCount;
+    }
+
+    /// Get the number of recorded passes.
+    ///
+    inline uint32_t getPassCount() const {
+        return _passCount;
+    }
+
+    /// Get the number of passes in a bucket of the histogram.
+    ///
+    /// @param bucket The bucket index, from 0 to `cHistogramSize - 1`.
+    ///
+    inline uint32_t getHistogram(uint8_t bucket) const {
+        return _histogram[bucket];
+    }
+
+    /// Get the utilisation of the loop in percent.
+    ///
+    /// This is the time spent in passes, relative to the time since the profiler was created or reset.
+    ///
+    uint8_t getUtilisation() const {
+        const auto elapsed = (Timer::tickMilliseconds() - _startTime).ticks();
+        if (elapsed == 0) {
+            return 0;
+        }
+        const auto utilisation = _busyTime / 10u / elapsed;
+        return static_cast<uint8_t>(utilisation > 100u ? 100u : utilisation);
+    }
+
+    /// Write a report with all statistics.
+    ///
+    /// Calls are identified by the address of their function. The total run time of each call is
+    /// written in milliseconds, the maximum run time in microseconds. The histogram uses the buckets
+    /// described for `cHistogramSize`.
+    ///
+    /// @param writer The writer for the report.
+    ///
+    void writeReport(StringWriter &writer) const {
+        String line;
+        line.append("passes=");
+        line.appendNumber(_passCount);
+        line.append(" utilisation=");
+        line.appendNumber(static_cast<uint32_t>(getUtilisation()));
+        line.append("% dropped=");
+        line.appendNumber(_droppedCount);
+        writer.writeLine(line);
+        for (uint8_t i = 0; i < _callCount; ++i) {
+            const auto &statistics = _callList[i];
+            line = String::hex(statistics.call.getAddress());
+            line.append(" count=");
+            line.appendNumber(statistics.count);
+            line.append(" time=");
+            line.appendNumber(static_cast<uint32_t>(statistics.totalTime / 1000u));
+            line.append("ms max=");
+            line.appendNumber(statistics.maximumTime);
+            line.append("us late=");
+            line.appendNumber(statistics.totalLateness);
+            line.append("/");
+            line.appendNumber(static_cast<uint32_t>(statistics.maximumLateness));
+            line.append("ms");
+            writer.writeLine(line);
+        }
+        line = String("histogram=");
+        for (uint8_t i = 0; i < cHistogramSize; ++i) {
+            if (i > 0) {
+                line.append(',');
+            }
+            line.appendNumber(_histogram[i]);
+        }
+        writer.writeLine(line);
+    }
+
+private:
+    /// The index for an unknown call.
+    ///
+    constexpr static uint8_t cNoIndex = 0xffu;
+
+private:
+    /// Find or add the statistics for the given call.
+    ///
+    /// @return The index of the statistics, or `cNoIndex` if the list is full.
+    ///
+    uint8_t findCall(const Call &call) {
+        for (uint8_t i = 0; i < _callCount; ++i) {
+            if (_callList[i].call == call) {
+                return i;
+            }
+        }
+        if (_callCount == callListSize) {
+            _droppedCount += 1;
+            return cNoIndex;
+        }
+        _callList[_callCount] = CallStatistics{call, 0, 0, 0, 0, 0};
+        return _callCount++;
+    }
+
+    /// Get the maximum of a value and a current maximum, limited to 16 bits.
+    ///
+    inline static uint16_t limited(uint32_t value, uint16_t maximum) {
+        if (value > 0xffffu) {
+            value = 0xffffu;
+        }
+        return (value > maximum ? static_cast<uint16_t>(value) : maximum);
+    }
+
+private:
+    uint8_t _callCount; ///< The number of recorded calls.
+    uint32_t _droppedCount; ///< The number of dispatches which were not recorded.
+    uint32_t _passCount; ///< The number of recorded passes.
+    uint64_t _busyTime; ///< The total time in passes, in microseconds.
+    Milliseconds _startTime; ///< The time when the recording started.
+    Microseconds _passStart; ///< The start time of the current pass.
+    Microseconds _eventStart; ///< The start time of the current event.
+    uint8_t _currentIndex; ///< The index of the statistics for the current event.
+    uint32_t _histogram[cHistogramSize]; ///< The histogram of the pass durations.
+    CallStatistics _callList[callListSize]; ///< The statistics for each call.
+};
+
+
+}
+}
+
+
@@ -0,0 +1,107 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+#include "Call.hpp"
+
+#include "../Core.hpp"
+
+#include <cstdint>
+
+
+namespace lr {
+namespace event {
+
+
+/// A pool of immediate events, which can be executed by any loop.
+///
+/// All loops take events from this pool, after they processed their own events. An idle
+/// loop therefore takes the work from a busy one. All accesses are protected with
+/// a `CoreLock`, so events can be added and taken from any core, but not from interrupts.
+///
+/// @tparam poolSize The maximum number of events in the pool.
+///
+template<uint8_t poolSize = 16>
+class StealPool
+{
+    static_assert(poolSize > 0 && poolSize < 0xffu, "The pool size has to be in the range 1-254.");
+
+public:
+    /// Create an empty pool.
+    ///
+    constexpr StealPool() : _first(0), _count(0), _calls() {}
+
+public:
+    /// Add an event to the pool.
+    ///
+    /// @param call The call for the event.
+    /// @return `true` if the event was added, `false` if the pool is full.
+    ///
+    bool push(const Call &call) {
+        CoreLock lock;
+        if (_count == poolSize) {
+            return false;
+        }
+        auto position = static_cast<uint16_t>(_first + _count);
+        if (position >= poolSize) {
+            position -= poolSize;
+        }
+        _calls[position] = call;
+        _count += 1;
+        return true;
+    }
+
+    /// Take the oldest event from the pool.
+    ///
+    /// @param call The variable to store the call.
+    /// @return `true` if an event was taken, `false` if the pool is empty.
+    ///
+    bool take(Call &call) {
+        CoreLock lock;
+        if (_count == 0) {
+            return false;
+        }
+        call = _calls[_first];
+        _first += 1;
+        if (_first == poolSize) {
+            _first = 0;
+        }
+        _count -= 1;
+        return true;
+    }
+
+    /// Check if the pool is empty.
+    ///
+    /// This is a hint only, without lock.
+    ///
+    inline bool isEmpty() const {
+        return _count == 0;
+    }
+
+private:
+    uint8_t _first; ///< The position of the first event.
+    volatile uint8_t _count; ///< The number of events in the pool.
+    Call _calls[poolSize]; ///< The ring buffer with the calls.
+};
+
+
+}
+}
+
+
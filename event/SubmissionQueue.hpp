@@ -0,0 +1,126 @@
+#pragma once
+//
+// (c)2019 by Lucky Resistor. See LICENSE for details.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+#include "Entry.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+
+namespace lr {
+namespace event {
+
+
+/// A lock-free queue to submit entries from an interrupt to the event loop.
+///
+/// This is a bounded single-producer/single-consumer queue. One interrupt context pushes
+/// entries into the queue and the event loop pops them from the queue. No interrupt lock
+/// is required for both sides, as each side only writes its own position.
+///
+/// Design Note: The queue expects a single producer. If interrupts with different priorities
+/// submit entries, they can preempt each other. In this case, you have to protect the `push()`
+/// calls in the lower priority interrupt with an `InterruptLock`.
+///
+/// @tparam queueSize The maximum number of entries in the queue. Has to be a power of two,
+///     in the range 2-128.
+///
+template<uint8_t queueSize = 8>
+class SubmissionQueue
+{
+    static_assert(queueSize >= 2 && queueSize <= 128, "The queue size has to be in the range 2-128.");
+    static_assert((queueSize & (queueSize - 1)) == 0, "The queue size has to be a power of two.");
+
+public:
+    /// Create a new empty queue.
+    ///
+    constexpr SubmissionQueue() : _writePosition(0), _readPosition(0), _elements() {}
+
+public:
+    /// Push an entry into the queue.
+    ///
+    /// Call this method from the producer side, e.g. from an interrupt.
+    ///
+    /// @param entry The entry to add.
+    /// @param merge If the entry shall be merged with existing ones, as soon it is added to the loop.
+    /// @return `true` if the entry was added, `false` if the queue is full.
+    ///
+    bool push(const Entry &entry, bool merge) noexcept {
+        const auto writePosition = _writePosition.load(std::memory_order_relaxed);
+        const auto readPosition = _readPosition.load(std::memory_order_acquire);
+        if (static_cast<uint8_t>(writePosition - readPosition) == queueSize) {
+            return false;
+        }
+        auto &element = _elements[writePosition & cMask];
+        element.entry = entry;
+        element.merge = merge;
+        _writePosition.store(static_cast<uint8_t>(writePosition + 1), std::memory_order_release);
+        return true;
+    }
+
+    /// Pop an entry from the queue.
+    ///
+    /// Call this method from the consumer side, e.g. the event loop.
+    ///
+    /// @param entry The variable to store the entry.
+    /// @param merge The variable to store the merge flag.
+    /// @return `true` if an entry was read, `false` if the queue is empty.
+    ///
+    bool pop(Entry &entry, bool &merge) noexcept {
+        const auto readPosition = _readPosition.load(std::memory_order_relaxed);
+        const auto writePosition = _writePosition.load(std::memory_order_acquire);
+        if (readPosition == writePosition) {
+            return false;
+        }
+        const auto &element = _elements[readPosition & cMask];
+        entry = element.entry;
+        merge = element.merge;
+        _readPosition.store(static_cast<uint8_t>(readPosition + 1), std::memory_order_release);
+        return true;
+    }
+
+    /// Check if the queue is empty.
+    ///
+    inline bool isEmpty() const noexcept {
+        return _readPosition.load(std::memory_order_acquire) == _writePosition.load(std::memory_order_acquire);
+    }
+
+private:
+    /// A single element in the queue.
+    ///
+    struct Element {
+        Entry entry; ///< The entry.
+        bool merge; ///< If the entry shall be merged.
+    };
+
+    /// The mask for the positions.
+    ///
+    constexpr static uint8_t cMask = (queueSize - 1);
+
+private:
+    std::atomic<uint8_t> _writePosition; ///< The write position, only changed by the producer.
+    std::atomic<uint8_t> _readPosition; ///< The read position, only changed by the consumer.
+    Element _elements[queueSize]; ///< The elements of the queue.
+};
+
+
+}
+}
+
+